@@ -0,0 +1,572 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "Logger.h"
+#include "MapGenerator.h"
+#include "PeakMemory.h"
+#include "SimpleParserStatus.h"
+#include "io/MapCache.h"
+#include "io/NodeWriter.h"
+#include "io/WorldReader.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceAttributes.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/EmptyBrushEntityValidator.h"
+#include "mdl/EmptyGroupValidator.h"
+#include "mdl/EmptyPropertyKeyValidator.h"
+#include "mdl/EmptyPropertyValueValidator.h"
+#include "mdl/InvalidUVScaleValidator.h"
+#include "mdl/LongPropertyKeyValidator.h"
+#include "mdl/LongPropertyValueValidator.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
+#include "mdl/MixedBrushContentsValidator.h"
+#include "mdl/NonIntegerVerticesValidator.h"
+#include "mdl/PickResult.h"
+#include "mdl/PointEntityWithBrushesValidator.h"
+#include "mdl/PropertyKeyWithDoubleQuotationMarksValidator.h"
+#include "mdl/PropertyValueWithDoubleQuotationMarksValidator.h"
+#include "mdl/WorldBoundsValidator.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/contracts.h"
+#include "kd/task_manager.h"
+
+#include "vm/ray.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tb::benchmark
+{
+namespace
+{
+
+struct Options
+{
+  MapGeneratorConfig generatorConfig;
+  std::vector<mdl::MapFormat> formats;
+  size_t iterations = 3;
+  size_t threads = std::thread::hardware_concurrency();
+  QString outputPath;
+};
+
+struct Measurement
+{
+  std::string benchmark;
+  size_t iterations = 0;
+  double minSeconds = 0.0;
+  double meanSeconds = 0.0;
+  double maxSeconds = 0.0;
+  size_t items = 0;
+  size_t bytes = 0;
+  size_t peakMemoryBytes = 0;
+};
+
+/**
+ * Runs the given function the given number of times and records the elapsed wall clock
+ * time of each run. The setup function is called before each run, and its cost is not
+ * included in the measurement.
+ */
+Measurement measure(
+  std::string benchmark,
+  const size_t iterations,
+  const size_t items,
+  const size_t bytes,
+  const std::function<void()>& setup,
+  const std::function<void()>& run)
+{
+  std::cerr << "  " << benchmark << std::flush;
+
+  auto minSeconds = std::numeric_limits<double>::max();
+  auto maxSeconds = 0.0;
+  auto totalSeconds = 0.0;
+
+  for (size_t i = 0; i < iterations; ++i)
+  {
+    setup();
+
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+    minSeconds = std::min(minSeconds, seconds);
+    maxSeconds = std::max(maxSeconds, seconds);
+    totalSeconds += seconds;
+  }
+
+  const auto meanSeconds = totalSeconds / double(iterations);
+  std::cerr << ": " << meanSeconds << "s\n";
+
+  return Measurement{
+    std::move(benchmark),
+    iterations,
+    minSeconds,
+    meanSeconds,
+    maxSeconds,
+    items,
+    bytes,
+    peakMemory(),
+  };
+}
+
+void collectNodes(mdl::Node& node, std::vector<mdl::Node*>& result)
+{
+  result.push_back(&node);
+  for (auto* child : node.children())
+  {
+    collectNodes(*child, result);
+  }
+}
+
+std::vector<mdl::Node*> collectNodes(mdl::WorldNode& world)
+{
+  auto result = std::vector<mdl::Node*>{};
+  collectNodes(world, result);
+  return result;
+}
+
+std::vector<const mdl::BrushNode*> collectBrushNodes(const std::vector<mdl::Node*>& nodes)
+{
+  auto result = std::vector<const mdl::BrushNode*>{};
+  for (const auto* node : nodes)
+  {
+    if (const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(node))
+    {
+      result.push_back(brushNode);
+    }
+  }
+  return result;
+}
+
+/**
+ * Returns a grid of downward facing rays that covers the generated objects.
+ */
+std::vector<vm::ray3d> makePickRays(const MapGeneratorConfig& config)
+{
+  constexpr auto RaysPerAxis = size_t(32);
+
+  const auto bounds = objectBounds(config);
+  const auto step = bounds.size() / double(RaysPerAxis);
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(RaysPerAxis * RaysPerAxis);
+  for (size_t y = 0; y < RaysPerAxis; ++y)
+  {
+    for (size_t x = 0; x < RaysPerAxis; ++x)
+    {
+      const auto origin = vm::vec3d{
+        bounds.min.x() + (double(x) + 0.5) * step.x(),
+        bounds.min.y() + (double(y) + 0.5) * step.y(),
+        bounds.max.z() + 1.0};
+      result.emplace_back(origin, vm::vec3d{0, 0, -1});
+    }
+  }
+  return result;
+}
+
+/**
+ * Parses the given map data and returns the contents of a map cache for it.
+ */
+std::string writeMapCache(
+  const std::string& mapData,
+  const mdl::MapFormat mapFormat,
+  const vm::bbox3d& bounds,
+  kdl::task_manager& taskManager)
+{
+  auto logger = NullLogger{};
+  auto status = SimpleParserStatus{logger};
+  auto mapCacheWriter = io::MapCacheWriter{};
+  auto reader = io::WorldReader{mapData, mapFormat, {}};
+  const auto world =
+    reader.read(bounds, status, taskManager, &mapCacheWriter) | kdl::value();
+  contract_assert(mapCacheWriter.complete());
+
+  auto stream = std::ostringstream{};
+  mapCacheWriter.write(stream, io::MapCacheKey{});
+  return stream.str();
+}
+
+void registerValidators(mdl::WorldNode& world, const vm::bbox3d& bounds)
+{
+  world.registerValidator(std::make_unique<mdl::MissingClassnameValidator>());
+  world.registerValidator(std::make_unique<mdl::EmptyGroupValidator>());
+  world.registerValidator(std::make_unique<mdl::EmptyBrushEntityValidator>());
+  world.registerValidator(std::make_unique<mdl::PointEntityWithBrushesValidator>());
+  world.registerValidator(std::make_unique<mdl::NonIntegerVerticesValidator>());
+  world.registerValidator(std::make_unique<mdl::MixedBrushContentsValidator>());
+  world.registerValidator(std::make_unique<mdl::WorldBoundsValidator>(bounds));
+  world.registerValidator(std::make_unique<mdl::EmptyPropertyKeyValidator>());
+  world.registerValidator(std::make_unique<mdl::EmptyPropertyValueValidator>());
+  world.registerValidator(std::make_unique<mdl::LongPropertyKeyValidator>(1023));
+  world.registerValidator(std::make_unique<mdl::LongPropertyValueValidator>(1023));
+  world.registerValidator(
+    std::make_unique<mdl::PropertyKeyWithDoubleQuotationMarksValidator>());
+  world.registerValidator(
+    std::make_unique<mdl::PropertyValueWithDoubleQuotationMarksValidator>());
+  world.registerValidator(std::make_unique<mdl::InvalidUVScaleValidator>());
+}
+
+std::vector<Measurement> runBenchmarks(
+  const mdl::MapFormat mapFormat, const Options& options, kdl::task_manager& taskManager)
+{
+  const auto& config = options.generatorConfig;
+  const auto bounds = worldBounds(config);
+
+  std::cerr << mdl::formatName(mapFormat) << "\n";
+
+  auto result = std::vector<Measurement>{};
+  auto logger = NullLogger{};
+
+  auto world = generateWorld(mapFormat, config);
+  const auto nodeCount = collectNodes(*world).size();
+
+  auto mapData = std::string{};
+  result.push_back(measure(
+    "writeMap",
+    options.iterations,
+    nodeCount,
+    0,
+    [] {},
+    [&] {
+      auto stream = std::stringstream{};
+      auto writer = io::NodeWriter{*world, stream};
+      writer.writeMap(taskManager);
+      mapData = stream.str();
+    }));
+  result.back().bytes = mapData.size();
+
+  result.push_back(measure(
+    "readWorld",
+    options.iterations,
+    nodeCount,
+    mapData.size(),
+    [&] { world.reset(); },
+    [&] {
+      auto status = SimpleParserStatus{logger};
+      auto reader = io::WorldReader{mapData, mapFormat, {}};
+      world = reader.read(bounds, status, taskManager) | kdl::value();
+    }));
+
+  const auto mapCache = writeMapCache(mapData, mapFormat, bounds, taskManager);
+  auto cachedWorld = std::unique_ptr<mdl::WorldNode>{};
+  result.push_back(measure(
+    "readMapCache",
+    options.iterations,
+    nodeCount,
+    mapCache.size(),
+    [&] { cachedWorld.reset(); },
+    [&] {
+      auto status = SimpleParserStatus{logger};
+      auto cache = io::readMapCache(mapCache, {}, taskManager) | kdl::value();
+      cachedWorld = io::WorldReader::fromObjectInfos(
+        cache.mapFormat, std::move(cache.objectInfos), bounds, {}, status, taskManager);
+    }));
+  cachedWorld.reset();
+
+  result.push_back(measure(
+    "rebuildNodeTree",
+    options.iterations,
+    nodeCount,
+    0,
+    [] {},
+    [&] { world->rebuildNodeTree(); }));
+
+  const auto brushNodes = collectBrushNodes(collectNodes(*world));
+  auto faceCount = size_t(0);
+  for (const auto* brushNode : brushNodes)
+  {
+    faceCount += brushNode->brush().faceCount();
+  }
+
+  auto brushes = std::vector<mdl::Brush>{};
+  result.push_back(measure(
+    "copyBrushes",
+    options.iterations,
+    faceCount,
+    faceCount * sizeof(mdl::BrushFace),
+    [&] {
+      brushes.clear();
+      brushes.reserve(brushNodes.size());
+    },
+    [&] {
+      for (const auto* brushNode : brushNodes)
+      {
+        brushes.push_back(brushNode->brush());
+      }
+    }));
+
+  result.push_back(measure(
+    "createBrushes",
+    options.iterations,
+    faceCount,
+    0,
+    [&] {
+      brushes.clear();
+      brushes.reserve(brushNodes.size());
+    },
+    [&] {
+      for (const auto* brushNode : brushNodes)
+      {
+        brushes.push_back(
+          mdl::Brush::create(bounds, brushNode->brush().faces()) | kdl::value());
+      }
+    }));
+  brushes.clear();
+
+  const auto rays = makePickRays(config);
+  const auto editorContext = mdl::EditorContext{};
+  result.push_back(measure(
+    "pick", options.iterations, rays.size(), 0, [] {}, [&] {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = mdl::PickResult{};
+        world->pick(editorContext, ray, pickResult);
+      }
+    }));
+
+  registerValidators(*world, bounds);
+  const auto nodes = collectNodes(*world);
+  const auto validators = world->registeredValidators();
+  result.push_back(measure(
+    "validate",
+    options.iterations,
+    nodes.size(),
+    0,
+    [&] {
+      for (auto* node : nodes)
+      {
+        node->invalidateIssues();
+      }
+    },
+    [&] {
+      for (auto* node : nodes)
+      {
+        node->issues(validators);
+      }
+    }));
+
+  return result;
+}
+
+QJsonObject toJson(const Options& options)
+{
+  auto formats = QJsonArray{};
+  for (const auto format : options.formats)
+  {
+    formats.append(QString::fromStdString(mdl::formatName(format)));
+  }
+
+  const auto& config = options.generatorConfig;
+  return QJsonObject{
+    {"entities", qint64(config.entityCount)},
+    {"brushesPerEntity", qint64(config.brushesPerEntity)},
+    {"facesPerBrush", qint64(config.facesPerBrush)},
+    {"patches", qint64(config.patchCount)},
+    {"formats", formats},
+    {"iterations", qint64(options.iterations)},
+    {"threads", qint64(options.threads)},
+  };
+}
+
+/**
+ * Returns the in memory sizes of the objects that dominate the memory use of large maps.
+ */
+QJsonObject objectSizes()
+{
+  return QJsonObject{
+    {"brushFace", qint64(sizeof(mdl::BrushFace))},
+    {"brushFaceAttributes", qint64(sizeof(mdl::BrushFaceAttributes))},
+  };
+}
+
+QJsonObject toJson(const mdl::MapFormat mapFormat, const Measurement& measurement)
+{
+  const auto perSecond = [&](const size_t count) {
+    return measurement.meanSeconds > 0.0 ? double(count) / measurement.meanSeconds
+                                         : 0.0;
+  };
+
+  return QJsonObject{
+    {"format", QString::fromStdString(mdl::formatName(mapFormat))},
+    {"benchmark", QString::fromStdString(measurement.benchmark)},
+    {"iterations", qint64(measurement.iterations)},
+    {"minSeconds", measurement.minSeconds},
+    {"meanSeconds", measurement.meanSeconds},
+    {"maxSeconds", measurement.maxSeconds},
+    {"items", qint64(measurement.items)},
+    {"itemsPerSecond", perSecond(measurement.items)},
+    {"bytes", qint64(measurement.bytes)},
+    {"bytesPerSecond", perSecond(measurement.bytes)},
+    {"peakMemoryBytes", qint64(measurement.peakMemoryBytes)},
+  };
+}
+
+bool parseSize(const QCommandLineParser& parser, const QString& name, size_t& value)
+{
+  if (!parser.isSet(name))
+  {
+    return true;
+  }
+
+  auto ok = false;
+  const auto parsed = parser.value(name).toULongLong(&ok);
+  if (!ok)
+  {
+    std::cerr << "Invalid value for --" << name.toStdString() << ": "
+              << parser.value(name).toStdString() << "\n";
+    return false;
+  }
+
+  value = size_t(parsed);
+  return true;
+}
+
+bool parseOptions(const QCoreApplication& app, Options& options)
+{
+  auto parser = QCommandLineParser{};
+  parser.setApplicationDescription(
+    "Measures map loading from map files and map caches, saving, picking and "
+    "validation on generated maps and prints the results as JSON.");
+  parser.addHelpOption();
+  parser.addOptions({
+    {"entities", "Number of brush entities.", "count"},
+    {"brushes-per-entity", "Number of brushes per entity.", "count"},
+    {"faces-per-brush", "Number of faces per brush, at least 5.", "count"},
+    {"patches", "Number of patches for formats that support them.", "count"},
+    {"formats",
+     "Comma separated list of map formats (default: Standard,Valve,Quake3).",
+     "names"},
+    {"iterations", "Number of iterations per benchmark (default: 3).", "count"},
+    {"threads", "Number of worker threads (default: all cores).", "count"},
+    {"output", "Write the JSON results to the given file.", "path"},
+  });
+  parser.process(app);
+
+  auto& config = options.generatorConfig;
+  if (
+    !parseSize(parser, "entities", config.entityCount)
+    || !parseSize(parser, "brushes-per-entity", config.brushesPerEntity)
+    || !parseSize(parser, "faces-per-brush", config.facesPerBrush)
+    || !parseSize(parser, "patches", config.patchCount)
+    || !parseSize(parser, "iterations", options.iterations)
+    || !parseSize(parser, "threads", options.threads))
+  {
+    return false;
+  }
+
+  if (config.facesPerBrush < 5)
+  {
+    std::cerr << "--faces-per-brush must be at least 5\n";
+    return false;
+  }
+
+  if (options.iterations == 0 || options.threads == 0)
+  {
+    std::cerr << "--iterations and --threads must be at least 1\n";
+    return false;
+  }
+
+  const auto formatNames = parser.isSet("formats")
+                             ? parser.value("formats").split(',', Qt::SkipEmptyParts)
+                             : QStringList{"Standard", "Valve", "Quake3"};
+  for (const auto& name : formatNames)
+  {
+    const auto format = mdl::formatFromName(name.trimmed().toStdString());
+    if (format == mdl::MapFormat::Unknown)
+    {
+      std::cerr << "Unknown map format: " << name.toStdString() << "\n";
+      return false;
+    }
+    options.formats.push_back(format);
+  }
+
+  options.outputPath = parser.value("output");
+  return true;
+}
+
+} // namespace
+} // namespace tb::benchmark
+
+int main(int argc, char* argv[])
+{
+  using namespace tb::benchmark;
+
+  QCoreApplication::setApplicationName("TrenchBroom-benchmark");
+  auto app = QCoreApplication{argc, argv};
+
+  auto options = Options{};
+  if (!parseOptions(app, options))
+  {
+    return 1;
+  }
+
+  auto taskManager = kdl::task_manager{options.threads};
+
+  auto results = QJsonArray{};
+  for (const auto format : options.formats)
+  {
+    for (const auto& measurement : runBenchmarks(format, options, taskManager))
+    {
+      results.append(toJson(format, measurement));
+    }
+  }
+
+  const auto json = QJsonDocument{QJsonObject{
+                                    {"config", toJson(options)},
+                                    {"results", results},
+                                    {"objectSizes", objectSizes()},
+                                    {"peakMemoryBytes", qint64(peakMemory())},
+                                  }}
+                      .toJson();
+
+  if (options.outputPath.isEmpty())
+  {
+    QTextStream{stdout} << json;
+    return 0;
+  }
+
+  auto file = QFile{options.outputPath};
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    std::cerr << "Could not open " << options.outputPath.toStdString() << "\n";
+    return 1;
+  }
+  file.write(json);
+  return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MapGenerator.h"
+
+#include "mdl/BezierPatch.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CircleShape.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/contracts.h"
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace tb::benchmark
+{
+namespace
+{
+
+constexpr auto CellSize = 64.0;
+constexpr auto ObjectSize = 48.0;
+constexpr auto MaterialCount = size_t(16);
+
+bool supportsPatches(const mdl::MapFormat mapFormat)
+{
+  return mapFormat == mdl::MapFormat::Quake3 || mapFormat == mdl::MapFormat::Quake3_Valve
+         || mapFormat == mdl::MapFormat::Quake3_Legacy;
+}
+
+size_t objectCount(const MapGeneratorConfig& config)
+{
+  return (config.entityCount + 1) * config.brushesPerEntity + config.patchCount;
+}
+
+size_t cellsPerAxis(const MapGeneratorConfig& config)
+{
+  return std::max(size_t(1), size_t(std::ceil(std::cbrt(double(objectCount(config))))));
+}
+
+std::string materialName(const size_t index)
+{
+  return fmt::format("material_{}", index % MaterialCount);
+}
+
+/**
+ * Hands out the cells of a cubic grid that is centered at the origin.
+ */
+class Grid
+{
+private:
+  size_t m_cellsPerAxis;
+  size_t m_nextCell = 0;
+
+public:
+  explicit Grid(const size_t cellsPerAxis)
+    : m_cellsPerAxis{cellsPerAxis}
+  {
+  }
+
+  vm::bbox3d nextObjectBounds()
+  {
+    const auto i = m_nextCell++;
+    const auto x = i % m_cellsPerAxis;
+    const auto y = (i / m_cellsPerAxis) % m_cellsPerAxis;
+    const auto z = i / m_cellsPerAxis / m_cellsPerAxis;
+    contract_assert(z < m_cellsPerAxis);
+
+    const auto offset = -double(m_cellsPerAxis) * CellSize / 2.0;
+    const auto min =
+      vm::vec3d{double(x), double(y), double(z)} * CellSize + vm::vec3d::fill(offset);
+    const auto margin = (CellSize - ObjectSize) / 2.0;
+    return vm::bbox3d{
+      min + vm::vec3d::fill(margin), min + vm::vec3d::fill(CellSize - margin)};
+  }
+};
+
+std::vector<mdl::Node*> createBrushNodes(
+  const mdl::BrushBuilder& brushBuilder,
+  Grid& grid,
+  const MapGeneratorConfig& config)
+{
+  auto result = std::vector<mdl::Node*>{};
+  result.reserve(config.brushesPerEntity);
+
+  for (size_t i = 0; i < config.brushesPerEntity; ++i)
+  {
+    auto brush = brushBuilder.createCylinder(
+                   grid.nextObjectBounds(),
+                   mdl::EdgeAlignedCircle{config.facesPerBrush - 2},
+                   vm::axis::z,
+                   materialName(i))
+                 | kdl::value();
+    result.push_back(new mdl::BrushNode{std::move(brush)});
+  }
+
+  return result;
+}
+
+mdl::PatchNode* createPatchNode(Grid& grid, const size_t index)
+{
+  const auto bounds = grid.nextObjectBounds();
+  const auto center = bounds.center();
+  const auto step = bounds.size() / 2.0;
+
+  auto controlPoints = std::vector<mdl::BezierPatch::Point>{};
+  controlPoints.reserve(9);
+  for (size_t row = 0; row < 3; ++row)
+  {
+    for (size_t col = 0; col < 3; ++col)
+    {
+      const auto isCenter = row == 1 && col == 1;
+      controlPoints.push_back(mdl::BezierPatch::Point{
+        bounds.min.x() + double(col) * step.x(),
+        bounds.min.y() + double(row) * step.y(),
+        isCenter ? bounds.max.z() : center.z(),
+        double(col) / 2.0,
+        double(row) / 2.0});
+    }
+  }
+
+  return new mdl::PatchNode{
+    mdl::BezierPatch{3, 3, std::move(controlPoints), materialName(index)}};
+}
+
+} // namespace
+
+vm::bbox3d worldBounds(const MapGeneratorConfig& config)
+{
+  const auto extent = double(cellsPerAxis(config)) * CellSize;
+  return vm::bbox3d{std::max(8192.0, extent)};
+}
+
+vm::bbox3d objectBounds(const MapGeneratorConfig& config)
+{
+  return vm::bbox3d{double(cellsPerAxis(config)) * CellSize / 2.0};
+}
+
+std::unique_ptr<mdl::WorldNode> generateWorld(
+  const mdl::MapFormat mapFormat, const MapGeneratorConfig& config)
+{
+  contract_pre(config.facesPerBrush >= 5);
+
+  const auto brushBuilder = mdl::BrushBuilder{mapFormat, worldBounds(config)};
+  auto grid = Grid{cellsPerAxis(config)};
+
+  auto world = std::make_unique<mdl::WorldNode>(
+    mdl::EntityPropertyConfig{}, mdl::Entity{}, mapFormat);
+  auto* layer = world->defaultLayer();
+
+  layer->addChildren(createBrushNodes(brushBuilder, grid, config));
+
+  for (size_t i = 0; i < config.entityCount; ++i)
+  {
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{{
+      {mdl::EntityPropertyKeys::Classname, "func_detail"},
+      {"targetname", fmt::format("detail_{}", i)},
+    }}};
+    entityNode->addChildren(createBrushNodes(brushBuilder, grid, config));
+    layer->addChild(entityNode);
+  }
+
+  if (supportsPatches(mapFormat))
+  {
+    for (size_t i = 0; i < config.patchCount; ++i)
+    {
+      layer->addChild(createPatchNode(grid, i));
+    }
+  }
+
+  return world;
+}
+
+} // namespace tb::benchmark
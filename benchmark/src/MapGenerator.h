@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/MapFormat.h"
+
+#include "vm/bbox.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace tb::mdl
+{
+class WorldNode;
+}
+
+namespace tb::benchmark
+{
+
+struct MapGeneratorConfig
+{
+  std::size_t entityCount = 100;
+  std::size_t brushesPerEntity = 100;
+  std::size_t facesPerBrush = 6;
+  std::size_t patchCount = 100;
+};
+
+/**
+ * Returns world bounds that are large enough to contain a world generated with the given
+ * config.
+ */
+vm::bbox3d worldBounds(const MapGeneratorConfig& config);
+
+/**
+ * Returns the bounds of the grid that the objects of a world generated with the given
+ * config are laid out on.
+ */
+vm::bbox3d objectBounds(const MapGeneratorConfig& config);
+
+/**
+ * Generates a synthetic world for the given map format.
+ *
+ * The worldspawn entity and each of the configured number of brush entities receive the
+ * configured number of brushes. Every brush is a prism with the configured number of
+ * faces, which must be at least 5. Patches are only generated if the given map format
+ * supports them. All objects are laid out on a grid that is centered at the origin.
+ */
+std::unique_ptr<mdl::WorldNode> generateWorld(
+  mdl::MapFormat mapFormat, const MapGeneratorConfig& config);
+
+} // namespace tb::benchmark
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PeakMemory.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace tb::benchmark
+{
+
+std::size_t peakMemory()
+{
+#if defined(_WIN32)
+  auto counters = PROCESS_MEMORY_COUNTERS{};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return std::size_t(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  auto usage = rusage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#if defined(__APPLE__)
+    // macOS reports bytes
+    return std::size_t(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+  }
+  return 0;
+#endif
+}
+
+} // namespace tb::benchmark
@@ -198,6 +198,7 @@ Preference<bool> EnableMSAA("render/Enable multisampling", true);
 
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
+Preference<bool> UseMapCache("Editor/Use map cache", false);
 
 Preference<std::filesystem::path>& RendererFontPath()
 {
@@ -392,6 +393,7 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureMagFilter,
     &AlignmentLock,
     &UVLock,
+    &UseMapCache,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
@@ -135,6 +135,7 @@ extern Preference<bool> EnableMSAA;
 
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
+extern Preference<bool> UseMapCache;
 
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
@@ -0,0 +1,759 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceAttributes.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/MapFormat.h"
+#include "mdl/UVCoordSystem.h"
+
+#include "kd/contracts.h"
+#include "kd/reflection_impl.h"
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <variant>
+
+namespace tb::io
+{
+
+kdl_reflect_impl(MapCacheKey);
+
+namespace
+{
+
+constexpr auto Magic = std::string_view{"TBMCACHE"};
+constexpr auto Version = std::uint32_t{2};
+
+enum class ObjectType : std::uint8_t
+{
+  Entity = 0,
+  Brush = 1,
+  Patch = 2,
+};
+
+enum class ColorType : std::uint8_t
+{
+  None = 0,
+  RgbaF = 1,
+  RgbaB = 2,
+  RgbF = 3,
+  RgbB = 4,
+};
+
+/**
+ * Appends the binary representation of the cached data to a buffer.
+ */
+class BufferWriter
+{
+private:
+  std::string m_buffer;
+
+public:
+  std::string& buffer() { return m_buffer; }
+
+  template <typename T>
+    requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+  void write(const T value)
+  {
+    m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T, size_t S>
+  void write(const vm::vec<T, S>& vec)
+  {
+    for (size_t i = 0; i < S; ++i)
+    {
+      write(vec[i]);
+    }
+  }
+
+  template <typename T>
+  void write(const std::optional<T>& value)
+  {
+    write(std::uint8_t(value ? 1 : 0));
+    if (value)
+    {
+      write(*value);
+    }
+  }
+
+  void write(const std::string_view str)
+  {
+    write(std::uint64_t(str.size()));
+    m_buffer.append(str);
+  }
+
+  void write(const FileLocation& location)
+  {
+    write(std::uint64_t(location.line));
+    write(std::uint64_t(location.column.value_or(0)));
+  }
+
+  void write(const MapCacheKey& key)
+  {
+    write(key.fileSize);
+    write(key.contentHash);
+    write(key.modificationTime);
+  }
+
+  void write(const Color& color)
+  {
+    if (color.is<RgbaF>())
+    {
+      write(ColorType::RgbaF);
+      write(color.to<RgbaF>().toVec());
+    }
+    else if (color.is<RgbaB>())
+    {
+      write(ColorType::RgbaB);
+      write(color.to<RgbaB>().toVec());
+    }
+    else if (color.is<RgbF>())
+    {
+      write(ColorType::RgbF);
+      write(color.to<RgbF>().toVec());
+    }
+    else
+    {
+      write(ColorType::RgbB);
+      write(color.to<RgbB>().toVec());
+    }
+  }
+
+  void write(const mdl::BrushFaceAttributes& attribs)
+  {
+    write(std::string_view{attribs.materialName()});
+    write(attribs.offset());
+    write(attribs.scale());
+    write(attribs.rotation());
+    write(attribs.surfaceContents());
+    write(attribs.surfaceFlags());
+    write(attribs.surfaceValue());
+
+    if (const auto& color = attribs.color())
+    {
+      write(*color);
+    }
+    else
+    {
+      write(ColorType::None);
+    }
+  }
+
+  void write(const vm::plane3d& plane)
+  {
+    write(plane.normal);
+    write(plane.distance);
+  }
+
+  void writeIndices(const std::vector<size_t>& indices)
+  {
+    write(std::uint64_t(indices.size()));
+    for (const auto index : indices)
+    {
+      write(std::uint32_t(index));
+    }
+  }
+
+  void write(const mdl::BrushGeometry::Topology& topology)
+  {
+    write(std::uint64_t(topology.vertexPositions.size()));
+    for (const auto& position : topology.vertexPositions)
+    {
+      write(position);
+    }
+
+    write(std::uint64_t(topology.facePlanes.size()));
+    for (const auto& plane : topology.facePlanes)
+    {
+      write(plane);
+    }
+
+    writeIndices(topology.faceSizes);
+    writeIndices(topology.halfEdgeOrigins);
+    writeIndices(topology.edgeHalfEdges);
+  }
+
+  void write(const mdl::BrushFace& face, const mdl::MapFormat mapFormat)
+  {
+    for (const auto& point : face.points())
+    {
+      write(point);
+    }
+    write(face.attributes());
+
+    if (mdl::isParallelUVCoordSystem(mapFormat))
+    {
+      write(face.uvCoordSystem().uAxis());
+      write(face.uvCoordSystem().vAxis());
+    }
+
+    write(std::uint64_t(face.lineNumber()));
+    write(std::uint64_t(face.lineCount()));
+  }
+
+  void write(const MapReader::EntityInfo& entityInfo, const mdl::MapFormat)
+  {
+    write(ObjectType::Entity);
+    write(entityInfo.startLocation);
+    write(entityInfo.endLocation);
+
+    write(std::uint64_t(entityInfo.properties.size()));
+    for (const auto& property : entityInfo.properties)
+    {
+      write(std::string_view{property.key()});
+      write(std::string_view{property.value()});
+    }
+  }
+
+  void write(
+    const MapReader::BrushInfo& brushInfo,
+    const mdl::Brush& brush,
+    const mdl::MapFormat mapFormat)
+  {
+    write(ObjectType::Brush);
+    write(brushInfo.startLocation);
+    write(brushInfo.endLocation);
+    write(optionalIndex(brushInfo.parentIndex));
+
+    write(std::uint64_t(brush.faceCount()));
+    for (const auto& face : brush.faces())
+    {
+      write(face, mapFormat);
+    }
+    write(brush.topology());
+  }
+
+  void write(const MapReader::PatchInfo& patchInfo, const mdl::MapFormat)
+  {
+    write(ObjectType::Patch);
+    write(patchInfo.startLocation);
+    write(patchInfo.endLocation);
+    write(optionalIndex(patchInfo.parentIndex));
+
+    write(std::uint64_t(patchInfo.rowCount));
+    write(std::uint64_t(patchInfo.columnCount));
+    write(std::uint64_t(patchInfo.controlPoints.size()));
+    for (const auto& controlPoint : patchInfo.controlPoints)
+    {
+      write(controlPoint);
+    }
+    write(std::string_view{patchInfo.materialName});
+  }
+
+private:
+  static std::optional<std::uint64_t> optionalIndex(const std::optional<size_t>& index)
+  {
+    return index ? std::optional{std::uint64_t(*index)} : std::nullopt;
+  }
+};
+
+/**
+ * The data of a brush face as it is stored in the cache. Faces are created from this
+ * data in parallel once the entire cache has been read.
+ */
+struct CachedBrushFace
+{
+  std::array<vm::vec3d, 3> points;
+  mdl::BrushFaceAttributes attribs;
+  vm::vec3d uAxis;
+  vm::vec3d vAxis;
+  size_t lineNumber;
+  size_t lineCount;
+};
+
+struct CachedBrush
+{
+  size_t objectIndex;
+  std::vector<CachedBrushFace> faces;
+};
+
+/**
+ * Reads the binary representation written by MapCacheWriter. Throws ReaderException if
+ * the data is truncated.
+ */
+class MapCacheReader
+{
+private:
+  fs::Reader m_reader;
+
+public:
+  explicit MapCacheReader(const std::string_view data)
+    : m_reader{fs::Reader::from(data.data(), data.data() + data.size())}
+  {
+  }
+
+  template <typename T>
+    requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+  T read()
+  {
+    auto result = T{};
+    m_reader.read(reinterpret_cast<char*>(&result), sizeof(T));
+    return result;
+  }
+
+  template <typename T, size_t S>
+  vm::vec<T, S> readVec()
+  {
+    auto result = vm::vec<T, S>{};
+    for (size_t i = 0; i < S; ++i)
+    {
+      result[i] = read<T>();
+    }
+    return result;
+  }
+
+  vm::plane3d readPlane()
+  {
+    const auto normal = readVec<double, 3>();
+    const auto distance = read<double>();
+    return {distance, normal};
+  }
+
+  std::vector<size_t> readIndices()
+  {
+    const auto count = readSize();
+    auto result = std::vector<size_t>{};
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      result.push_back(size_t(read<std::uint32_t>()));
+    }
+    return result;
+  }
+
+  mdl::BrushGeometry::Topology readTopology()
+  {
+    auto result = mdl::BrushGeometry::Topology{};
+
+    const auto vertexCount = readSize();
+    result.vertexPositions.reserve(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      result.vertexPositions.push_back(readVec<double, 3>());
+    }
+
+    const auto faceCount = readSize();
+    result.facePlanes.reserve(faceCount);
+    for (size_t i = 0; i < faceCount; ++i)
+    {
+      result.facePlanes.push_back(readPlane());
+    }
+
+    result.faceSizes = readIndices();
+    result.halfEdgeOrigins = readIndices();
+    result.edgeHalfEdges = readIndices();
+    return result;
+  }
+
+  template <typename T>
+  std::optional<T> readOptional()
+  {
+    return read<std::uint8_t>() != 0 ? std::optional{read<T>()} : std::nullopt;
+  }
+
+  size_t readSize()
+  {
+    const auto size = read<std::uint64_t>();
+    if (size > m_reader.size() - m_reader.position())
+    {
+      throw fs::ReaderException{fmt::format("Invalid size: {}", size)};
+    }
+    return size_t(size);
+  }
+
+  std::string readString() { return m_reader.readString(readSize()); }
+
+  bool readMagic() { return m_reader.readString(Magic.size()) == Magic; }
+
+  FileLocation readLocation()
+  {
+    const auto line = read<std::uint64_t>();
+    const auto column = read<std::uint64_t>();
+    return {
+      size_t(line), column != 0 ? std::optional{size_t(column)} : std::nullopt};
+  }
+
+  std::optional<FileLocation> readOptionalLocation()
+  {
+    return read<std::uint8_t>() != 0 ? std::optional{readLocation()} : std::nullopt;
+  }
+
+  std::optional<size_t> readOptionalIndex()
+  {
+    return read<std::uint8_t>() != 0 ? std::optional{size_t(read<std::uint64_t>())}
+                                     : std::nullopt;
+  }
+
+  MapCacheKey readKey()
+  {
+    const auto fileSize = read<std::uint64_t>();
+    const auto contentHash = read<std::uint64_t>();
+    const auto modificationTime = read<std::int64_t>();
+    return {fileSize, contentHash, modificationTime};
+  }
+
+  std::optional<Color> readColor()
+  {
+    switch (read<ColorType>())
+    {
+    case ColorType::None:
+      return std::nullopt;
+    case ColorType::RgbaF: {
+      const auto v = readVec<float, 4>();
+      return RgbaF{v[0], v[1], v[2], v[3]};
+    }
+    case ColorType::RgbaB: {
+      const auto v = readVec<std::uint8_t, 4>();
+      return RgbaB{v[0], v[1], v[2], v[3]};
+    }
+    case ColorType::RgbF: {
+      const auto v = readVec<float, 3>();
+      return RgbF{v[0], v[1], v[2]};
+    }
+    case ColorType::RgbB: {
+      const auto v = readVec<std::uint8_t, 3>();
+      return RgbB{v[0], v[1], v[2]};
+    }
+    }
+    throw fs::ReaderException{"Invalid color type"};
+  }
+
+  mdl::BrushFaceAttributes readAttributes()
+  {
+    auto attribs = mdl::BrushFaceAttributes{readString()};
+    attribs.setOffset(readVec<float, 2>());
+    attribs.setScale(readVec<float, 2>());
+    attribs.setRotation(read<float>());
+    attribs.setSurfaceContents(readOptional<int>());
+    attribs.setSurfaceFlags(readOptional<int>());
+    attribs.setSurfaceValue(readOptional<float>());
+    attribs.setColor(readColor());
+    return attribs;
+  }
+
+  CachedBrushFace readFace(const mdl::MapFormat mapFormat)
+  {
+    const auto p0 = readVec<double, 3>();
+    const auto p1 = readVec<double, 3>();
+    const auto p2 = readVec<double, 3>();
+    auto attribs = readAttributes();
+
+    auto uAxis = vm::vec3d{};
+    auto vAxis = vm::vec3d{};
+    if (mdl::isParallelUVCoordSystem(mapFormat))
+    {
+      uAxis = readVec<double, 3>();
+      vAxis = readVec<double, 3>();
+    }
+
+    const auto lineNumber = size_t(read<std::uint64_t>());
+    const auto lineCount = size_t(read<std::uint64_t>());
+    return {{p0, p1, p2}, std::move(attribs), uAxis, vAxis, lineNumber, lineCount};
+  }
+
+  MapReader::EntityInfo readEntity()
+  {
+    auto startLocation = readLocation();
+    auto endLocation = readOptionalLocation();
+
+    const auto propertyCount = readSize();
+    auto properties = std::vector<mdl::EntityProperty>{};
+    properties.reserve(propertyCount);
+    for (size_t i = 0; i < propertyCount; ++i)
+    {
+      auto key = readString();
+      auto value = readString();
+      properties.emplace_back(std::move(key), std::move(value));
+    }
+
+    return {std::move(properties), startLocation, endLocation};
+  }
+
+  MapReader::BrushInfo readBrush(
+    const size_t objectIndex,
+    const mdl::MapFormat mapFormat,
+    std::vector<CachedBrush>& cachedBrushes)
+  {
+    auto startLocation = readLocation();
+    auto endLocation = readOptionalLocation();
+    auto parentIndex = readOptionalIndex();
+
+    const auto faceCount = readSize();
+    auto faces = std::vector<CachedBrushFace>{};
+    faces.reserve(faceCount);
+    for (size_t i = 0; i < faceCount; ++i)
+    {
+      faces.push_back(readFace(mapFormat));
+    }
+    cachedBrushes.push_back({objectIndex, std::move(faces)});
+
+    return {{}, startLocation, endLocation, parentIndex, readTopology()};
+  }
+
+  MapReader::PatchInfo readPatch()
+  {
+    auto startLocation = readLocation();
+    auto endLocation = readOptionalLocation();
+    auto parentIndex = readOptionalIndex();
+
+    const auto rowCount = size_t(read<std::uint64_t>());
+    const auto columnCount = size_t(read<std::uint64_t>());
+    const auto controlPointCount = readSize();
+    auto controlPoints = std::vector<mdl::BezierPatch::Point>{};
+    controlPoints.reserve(controlPointCount);
+    for (size_t i = 0; i < controlPointCount; ++i)
+    {
+      controlPoints.push_back(readVec<double, 5>());
+    }
+    auto materialName = readString();
+
+    return {
+      rowCount,
+      columnCount,
+      std::move(controlPoints),
+      std::move(materialName),
+      startLocation,
+      endLocation,
+      parentIndex};
+  }
+
+  MapReader::ObjectInfo readObject(
+    const size_t objectIndex,
+    const mdl::MapFormat mapFormat,
+    std::vector<CachedBrush>& cachedBrushes)
+  {
+    switch (read<ObjectType>())
+    {
+    case ObjectType::Entity:
+      return readEntity();
+    case ObjectType::Brush:
+      return readBrush(objectIndex, mapFormat, cachedBrushes);
+    case ObjectType::Patch:
+      return readPatch();
+    }
+    throw fs::ReaderException{"Invalid object type"};
+  }
+};
+
+Result<mdl::BrushFace> createBrushFace(
+  const CachedBrushFace& cachedFace, const mdl::MapFormat mapFormat)
+{
+  const auto& [p0, p1, p2] = cachedFace.points;
+  auto face = mdl::isParallelUVCoordSystem(mapFormat)
+                ? mdl::BrushFace::createFromValve(
+                    p0,
+                    p1,
+                    p2,
+                    cachedFace.attribs,
+                    cachedFace.uAxis,
+                    cachedFace.vAxis,
+                    mapFormat)
+                : mdl::BrushFace::createFromStandard(
+                    p0, p1, p2, cachedFace.attribs, mapFormat);
+  return face | kdl::transform([&](auto f) {
+           f.setFilePosition(cachedFace.lineNumber, cachedFace.lineCount);
+           return f;
+         });
+}
+
+/**
+ * 64 bit FNV-1a. Unlike std::hash, the result doesn't depend on the standard library or
+ * the process, so it can be stored in the cache.
+ */
+std::uint64_t hashContents(const std::string_view contents)
+{
+  auto hash = std::uint64_t{0xcbf29ce484222325};
+  for (const auto c : contents)
+  {
+    hash ^= std::uint64_t(static_cast<unsigned char>(c));
+    hash *= std::uint64_t{0x100000001b3};
+  }
+  return hash;
+}
+
+} // namespace
+
+MapCacheKey makeMapCacheKey(
+  const std::string_view contents,
+  const std::filesystem::file_time_type modificationTime)
+{
+  return {
+    std::uint64_t(contents.size()),
+    hashContents(contents),
+    std::int64_t(modificationTime.time_since_epoch().count())};
+}
+
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath)
+{
+  auto result = mapPath;
+  result += ".tbcache";
+  return result;
+}
+
+MapCacheWriter::MapCacheWriter()
+  : m_mapFormat{mdl::MapFormat::Unknown}
+{
+}
+
+void MapCacheWriter::reset(const mdl::MapFormat mapFormat, const size_t objectCount)
+{
+  m_mapFormat = mapFormat;
+  m_objects.clear();
+  m_objects.resize(objectCount);
+}
+
+void MapCacheWriter::addEntity(
+  const size_t index, const MapReader::EntityInfo& entityInfo)
+{
+  contract_pre(index < m_objects.size());
+
+  auto writer = BufferWriter{};
+  writer.write(entityInfo, m_mapFormat);
+  m_objects[index] = std::move(writer.buffer());
+}
+
+void MapCacheWriter::addBrush(
+  const size_t index, const MapReader::BrushInfo& brushInfo, const mdl::Brush& brush)
+{
+  contract_pre(index < m_objects.size());
+
+  auto writer = BufferWriter{};
+  writer.write(brushInfo, brush, m_mapFormat);
+  m_objects[index] = std::move(writer.buffer());
+}
+
+void MapCacheWriter::addPatch(const size_t index, const MapReader::PatchInfo& patchInfo)
+{
+  contract_pre(index < m_objects.size());
+
+  auto writer = BufferWriter{};
+  writer.write(patchInfo, m_mapFormat);
+  m_objects[index] = std::move(writer.buffer());
+}
+
+bool MapCacheWriter::complete() const
+{
+  return std::ranges::none_of(
+    m_objects, [](const auto& object) { return object.empty(); });
+}
+
+void MapCacheWriter::write(std::ostream& stream, const MapCacheKey& key) const
+{
+  contract_pre(complete());
+
+  auto writer = BufferWriter{};
+  for (const auto c : Magic)
+  {
+    writer.write(c);
+  }
+  writer.write(Version);
+  writer.write(key);
+  writer.write(std::int32_t(m_mapFormat));
+  writer.write(std::uint64_t(m_objects.size()));
+
+  const auto& header = writer.buffer();
+  stream.write(header.data(), std::streamsize(header.size()));
+  for (const auto& object : m_objects)
+  {
+    stream.write(object.data(), std::streamsize(object.size()));
+  }
+}
+
+Result<MapCache> readMapCache(
+  const std::string_view data,
+  const MapCacheKey& expectedKey,
+  kdl::task_manager& taskManager)
+{
+  try
+  {
+    auto reader = MapCacheReader{data};
+    if (!reader.readMagic())
+    {
+      return Error{"Not a map cache"};
+    }
+
+    if (const auto version = reader.read<std::uint32_t>(); version != Version)
+    {
+      return Error{fmt::format("Unsupported map cache version: {}", version)};
+    }
+
+    if (reader.readKey() != expectedKey)
+    {
+      return Error{"Map cache is out of date"};
+    }
+
+    const auto mapFormat = mdl::MapFormat(reader.read<std::int32_t>());
+
+    const auto objectCount = reader.readSize();
+    auto objectInfos = std::vector<MapReader::ObjectInfo>{};
+    objectInfos.reserve(objectCount);
+
+    auto cachedBrushes = std::vector<CachedBrush>{};
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+      objectInfos.push_back(reader.readObject(i, mapFormat, cachedBrushes));
+    }
+
+    auto errors = std::vector<std::optional<Error>>(cachedBrushes.size());
+    taskManager.run_range(0, cachedBrushes.size(), 64, [&](const size_t i) {
+      const auto& cachedBrush = cachedBrushes[i];
+      auto& brushInfo =
+        std::get<MapReader::BrushInfo>(objectInfos[cachedBrush.objectIndex]);
+      brushInfo.faces.reserve(cachedBrush.faces.size());
+
+      for (const auto& cachedFace : cachedBrush.faces)
+      {
+        createBrushFace(cachedFace, mapFormat)
+          | kdl::transform([&](auto face) { brushInfo.faces.push_back(std::move(face)); })
+          | kdl::transform_error([&](auto e) { errors[i] = std::move(e); });
+      }
+    });
+
+    for (auto& error : errors)
+    {
+      if (error)
+      {
+        return std::move(*error);
+      }
+    }
+
+    return MapCache{mapFormat, std::move(objectInfos)};
+  }
+  catch (const fs::ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+} // namespace tb::io
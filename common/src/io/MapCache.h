@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+#include "io/MapReader.h"
+
+#include "kd/reflection_decl.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb::mdl
+{
+class Brush;
+enum class MapFormat;
+} // namespace tb::mdl
+
+namespace tb::io
+{
+
+/**
+ * Identifies the contents of a map file. A map cache is only used if its key is equal to
+ * the key computed from the map file being loaded.
+ */
+struct MapCacheKey
+{
+  std::uint64_t fileSize = 0;
+  std::uint64_t contentHash = 0;
+  std::int64_t modificationTime = 0;
+
+  kdl_reflect_decl(MapCacheKey, fileSize, contentHash, modificationTime);
+};
+
+/**
+ * Computes the key of the given map file contents. The content hash is stable across
+ * runs and platforms.
+ */
+MapCacheKey makeMapCacheKey(
+  std::string_view contents, std::filesystem::file_time_type modificationTime);
+
+/**
+ * Returns the path of the cache file for the map file at the given path, which is the map
+ * file path with the extension ".tbcache" appended.
+ */
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath);
+
+/**
+ * The contents of a map cache: the map format the map file was parsed as, and the object
+ * infos recorded while parsing it. The brush infos contain the faces and the topology of
+ * the created brushes.
+ */
+struct MapCache
+{
+  mdl::MapFormat mapFormat;
+  std::vector<MapReader::ObjectInfo> objectInfos;
+};
+
+/**
+ * Records the objects of a map while MapReader creates nodes from them, and writes them
+ * to a map cache in a binary format.
+ *
+ * Every object is serialized into a separate buffer when it is added, so objects with
+ * different indices can be added concurrently. Brushes are recorded with the faces and
+ * the geometry topology of the created brush so that reading the cache doesn't need to
+ * compute the brush geometry again.
+ */
+class MapCacheWriter
+{
+private:
+  mdl::MapFormat m_mapFormat;
+  std::vector<std::string> m_objects;
+
+public:
+  MapCacheWriter();
+
+  /**
+   * Discards any recorded objects and prepares to record the given number of objects of
+   * a map in the given format.
+   */
+  void reset(mdl::MapFormat mapFormat, size_t objectCount);
+
+  void addEntity(size_t index, const MapReader::EntityInfo& entityInfo);
+
+  /**
+   * Records a brush. The faces of the given brush info are ignored, the faces of the
+   * given brush are recorded instead.
+   */
+  void addBrush(
+    size_t index, const MapReader::BrushInfo& brushInfo, const mdl::Brush& brush);
+
+  void addPatch(size_t index, const MapReader::PatchInfo& patchInfo);
+
+  /**
+   * Indicates whether every object was recorded. This is not the case if a node could
+   * not be created for some object, and such maps should not be cached.
+   */
+  bool complete() const;
+
+  /**
+   * Writes the recorded objects to the given stream, which must have been opened in
+   * binary mode.
+   */
+  void write(std::ostream& stream, const MapCacheKey& key) const;
+};
+
+/**
+ * Reads a map cache that was written by MapCacheWriter.
+ *
+ * Returns an error if the given data is not a map cache, if it was written by an
+ * incompatible version, if its key is not equal to the given key or if it is corrupt.
+ * The brush faces are created in parallel using the given task manager.
+ */
+Result<MapCache> readMapCache(
+  std::string_view data, const MapCacheKey& expectedKey, kdl::task_manager& taskManager);
+
+} // namespace tb::io
@@ -0,0 +1,262 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapChunks.h"
+
+#include "kd/reflection_impl.h"
+
+#include <optional>
+
+namespace tb::io
+{
+
+kdl_reflect_impl(MapChunk);
+
+namespace
+{
+
+/**
+ * A minimal scanner that mirrors how QuakeMapTokenizer consumes its input. It only
+ * recognizes the tokens that are relevant to determine the nesting depth of braces, and it
+ * tracks the current line and column in the same way as the tokenizer does.
+ */
+class MapChunkScanner
+{
+private:
+  std::string_view m_str;
+  size_t m_pos = 0;
+  size_t m_line = 1;
+  size_t m_column = 1;
+
+public:
+  explicit MapChunkScanner(const std::string_view str)
+    : m_str{str}
+  {
+  }
+
+  bool eof() const { return m_pos >= m_str.size(); }
+
+  size_t pos() const { return m_pos; }
+
+  FileLocation location() const { return {m_line, m_column}; }
+
+  char curChar() const { return !eof() ? m_str[m_pos] : 0; }
+
+  char lookAhead(const size_t offset = 1) const
+  {
+    return m_pos + offset < m_str.size() ? m_str[m_pos + offset] : 0;
+  }
+
+  void advance()
+  {
+    switch (curChar())
+    {
+    case '\r':
+      if (lookAhead() == '\n')
+      {
+        ++m_column;
+        break;
+      }
+      ++m_line;
+      m_column = 1;
+      break;
+    case '\n':
+      ++m_line;
+      m_column = 1;
+      break;
+    default:
+      ++m_column;
+      break;
+    }
+    ++m_pos;
+  }
+
+  void discardUntilEol()
+  {
+    while (!eof() && curChar() != '\n' && curChar() != '\r')
+    {
+      advance();
+    }
+  }
+
+  void discardWord()
+  {
+    while (!eof() && !isWhitespace(curChar()))
+    {
+      advance();
+    }
+  }
+
+  /**
+   * Skips a quoted string, assuming that the opening quotation mark was already consumed.
+   * Returns false if the string is not terminated.
+   */
+  bool discardQuotedString()
+  {
+    auto escaped = false;
+    while (!eof())
+    {
+      const auto c = curChar();
+      if (c == '"')
+      {
+        // A backslash before a quotation mark at the end of a line or before a closing
+        // brace is treated as a trailing backslash, see QuakeMapTokenizer.
+        if (!escaped || lookAhead() == '\n' || lookAhead() == '}')
+        {
+          advance();
+          return true;
+        }
+      }
+
+      escaped = c == '\\' ? !escaped : false;
+      advance();
+    }
+
+    return false;
+  }
+
+  /**
+   * Returns true if the current character is a brace that is followed by whitespace or
+   * the end of the input.
+   */
+  bool atBrace(const char brace) const
+  {
+    return curChar() == brace && (lookAhead() == 0 || isWhitespace(lookAhead()));
+  }
+
+  static bool isWhitespace(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+};
+
+} // namespace
+
+std::vector<MapChunk> splitMapIntoChunks(
+  const std::string_view str, const size_t targetChunkSize)
+{
+  const auto singleChunk = std::vector<MapChunk>{MapChunk{str, {1, 1}, false}};
+  if (str.size() <= targetChunkSize)
+  {
+    return singleChunk;
+  }
+
+  auto chunks = std::vector<MapChunk>{};
+  auto chunkStart = size_t(0);
+  auto chunkLocation = FileLocation{1, 1};
+  auto chunkStartsInsideEntity = false;
+
+  const auto startChunk = [&](const MapChunkScanner& scanner, const size_t depth) {
+    if (scanner.pos() - chunkStart >= targetChunkSize)
+    {
+      chunks.push_back(MapChunk{
+        str.substr(chunkStart, scanner.pos() - chunkStart),
+        chunkLocation,
+        chunkStartsInsideEntity});
+
+      chunkStart = scanner.pos();
+      chunkLocation = scanner.location();
+      chunkStartsInsideEntity = depth == 1;
+    }
+  };
+
+  auto scanner = MapChunkScanner{str};
+  auto depth = size_t(0);
+  while (!scanner.eof())
+  {
+    switch (scanner.curChar())
+    {
+    case '/':
+      scanner.advance();
+      if (scanner.curChar() == '/')
+      {
+        scanner.advance();
+        if (scanner.curChar() == '/' && scanner.lookAhead() == ' ')
+        {
+          scanner.advance();
+        }
+        else
+        {
+          scanner.discardUntilEol();
+        }
+      }
+      break;
+    case ';':
+      scanner.discardUntilEol();
+      break;
+    case '"':
+      scanner.advance();
+      if (!scanner.discardQuotedString())
+      {
+        return singleChunk;
+      }
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case '(':
+    case ')':
+    case '[':
+    case ']':
+      scanner.advance();
+      break;
+    case '{':
+      if (!scanner.atBrace('{'))
+      {
+        scanner.discardWord();
+        break;
+      }
+      if (depth < 2)
+      {
+        startChunk(scanner, depth);
+      }
+      ++depth;
+      scanner.advance();
+      break;
+    case '}':
+      if (!scanner.atBrace('}'))
+      {
+        scanner.discardWord();
+        break;
+      }
+      if (depth == 0)
+      {
+        return singleChunk;
+      }
+      --depth;
+      scanner.advance();
+      break;
+    default:
+      scanner.discardWord();
+      break;
+    }
+  }
+
+  if (depth != 0)
+  {
+    return singleChunk;
+  }
+
+  chunks.push_back(
+    MapChunk{str.substr(chunkStart), chunkLocation, chunkStartsInsideEntity});
+  return chunks;
+}
+
+} // namespace tb::io
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FileLocation.h"
+
+#include "kd/reflection_decl.h"
+
+#include <string_view>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * A contiguous part of a map file that can be parsed independently of the other parts.
+ */
+struct MapChunk
+{
+  /** The text of this chunk. */
+  std::string_view str;
+
+  /** The location of the first character of this chunk in the map file. */
+  FileLocation location;
+
+  /**
+   * Whether this chunk starts inside of an entity that was opened by a preceding chunk.
+   * If this is the case, the chunk begins with the brushes or patches of that entity.
+   */
+  bool startsInsideEntity = false;
+
+  kdl_reflect_decl(MapChunk, str, location, startsInsideEntity);
+};
+
+/**
+ * Splits the given map file into chunks of approximately the given size.
+ *
+ * Chunks are only split before the opening brace of an entity or before the opening brace
+ * of a brush or patch that belongs to an entity, so every chunk contains a sequence of
+ * complete objects. The split respects comments and quoted strings.
+ *
+ * Braces are only recognized if they are followed by whitespace or the end of the input,
+ * which distinguishes them from material names such as "{fence". If the structure of the
+ * given string cannot be determined reliably, e.g. because braces are unbalanced or a
+ * quoted string is not terminated, a single chunk containing the entire string is
+ * returned and the caller must parse it sequentially to report any errors.
+ */
+std::vector<MapChunk> splitMapIntoChunks(std::string_view str, size_t targetChunkSize);
+
+} // namespace tb::io
@@ -20,6 +20,7 @@
 #include "MapFileSerializer.h"
 
 #include "Macros.h"
+#include "io/NumberFormat.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -37,11 +38,11 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <sstream>
 #include <utility>
-#include <variant>
 #include <vector>
 
 namespace tb::io
@@ -56,30 +57,30 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>{stream}, "\n");
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
+    buffer.push_back('\n');
   }
 
 protected:
-  void writeFacePoints(std::ostream& stream, const mdl::BrushFace& face) const
+  static void writeNumbers(std::string& buffer, const auto&... values)
+  {
+    ((buffer.push_back(' '), appendNumber(buffer, values)), ...);
+  }
+
+  void writeFacePoints(std::string& buffer, const mdl::BrushFace& face) const
   {
     const auto& points = face.points();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>{stream},
-      "( {} {} {} ) ( {} {} {} ) ( {} {} {} )",
-      points[0].x(),
-      points[0].y(),
-      points[0].z(),
-      points[1].x(),
-      points[1].y(),
-      points[1].z(),
-      points[2].x(),
-      points[2].y(),
-      points[2].z());
+    buffer.push_back('(');
+    writeNumbers(buffer, points[0].x(), points[0].y(), points[0].z());
+    buffer.append(" ) (");
+    writeNumbers(buffer, points[1].x(), points[1].y(), points[1].z());
+    buffer.append(" ) (");
+    writeNumbers(buffer, points[2].x(), points[2].y(), points[2].z());
+    buffer.append(" )");
   }
 
   static bool shouldQuoteMaterialName(const auto& materialName)
@@ -88,22 +89,30 @@ protected:
            || materialName.find_first_of("\"\\ \t") != std::string::npos;
   }
 
-  static std::string quoteMaterialName(const auto& materialName)
-  {
-    return fmt::format(R"("{}")", kdl::str_escape(materialName, R"(")"));
-  }
-
-  void writeMaterialInfo(std::ostream& stream, const mdl::BrushFace& face) const
+  static void writeMaterialName(std::string& buffer, const mdl::BrushFace& face)
   {
     const auto& materialName = face.attributes().materialName().empty()
                                  ? mdl::BrushFaceAttributes::NoMaterialName
                                  : face.attributes().materialName();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>{stream},
-      " {} {} {} {} {} {}",
-      shouldQuoteMaterialName(materialName) ? quoteMaterialName(materialName)
-                                            : materialName,
+    buffer.push_back(' ');
+    if (shouldQuoteMaterialName(materialName))
+    {
+      buffer.push_back('"');
+      buffer.append(kdl::str_escape(materialName, R"(")"));
+      buffer.push_back('"');
+    }
+    else
+    {
+      buffer.append(materialName);
+    }
+  }
+
+  void writeMaterialInfo(std::string& buffer, const mdl::BrushFace& face) const
+  {
+    writeMaterialName(buffer, face);
+    writeNumbers(
+      buffer,
       face.attributes().xOffset(),
       face.attributes().yOffset(),
       face.attributes().rotation(),
@@ -111,30 +120,21 @@ protected:
       face.attributes().yScale());
   }
 
-  void writeValveMaterialInfo(std::ostream& stream, const mdl::BrushFace& face) const
+  void writeValveMaterialInfo(std::string& buffer, const mdl::BrushFace& face) const
   {
-    const auto& materialName = face.attributes().materialName().empty()
-                                 ? mdl::BrushFaceAttributes::NoMaterialName
-                                 : face.attributes().materialName();
     const auto uAxis = face.uAxis();
     const auto vAxis = face.vAxis();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>{stream},
-      " {} [ {} {} {} {} ] [ {} {} {} {} ] {} {} {}",
-      shouldQuoteMaterialName(materialName) ? quoteMaterialName(materialName)
-                                            : materialName,
-
-      uAxis.x(),
-      uAxis.y(),
-      uAxis.z(),
-      face.attributes().xOffset(),
+    writeMaterialName(buffer, face);
 
-      vAxis.x(),
-      vAxis.y(),
-      vAxis.z(),
-      face.attributes().yOffset(),
+    buffer.append(" [");
+    writeNumbers(buffer, uAxis.x(), uAxis.y(), uAxis.z(), face.attributes().xOffset());
+    buffer.append(" ] [");
+    writeNumbers(buffer, vAxis.x(), vAxis.y(), vAxis.z(), face.attributes().yOffset());
+    buffer.append(" ]");
 
+    writeNumbers(
+      buffer,
       face.attributes().rotation(),
       face.attributes().xScale(),
       face.attributes().yScale());
@@ -150,25 +150,24 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>{stream}, "\n");
+    buffer.push_back('\n');
   }
 
 protected:
-  void writeSurfaceAttributes(std::ostream& stream, const mdl::BrushFace& face) const
+  void writeSurfaceAttributes(std::string& buffer, const mdl::BrushFace& face) const
   {
-    fmt::format_to(
-      std::ostreambuf_iterator<char>{stream},
-      " {} {} {}",
+    writeNumbers(
+      buffer,
       face.resolvedSurfaceContents(),
       face.resolvedSurfaceFlags(),
       face.resolvedSurfaceValue());
@@ -184,17 +183,17 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeValveMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>{stream}, "\n");
+    buffer.push_back('\n');
   }
 };
 
@@ -211,29 +210,30 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
     if (face.attributes().hasColor())
     {
-      writeSurfaceColor(stream, face);
+      writeSurfaceColor(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>{stream}, "\n");
+    buffer.push_back('\n');
   }
 
 protected:
-  void writeSurfaceColor(std::ostream& stream, const mdl::BrushFace& face) const
+  void writeSurfaceColor(std::string& buffer, const mdl::BrushFace& face) const
   {
     if (const auto color = face.resolvedColor())
     {
-      stream << " " << color->to<RgbB>().toString();
+      buffer.push_back(' ');
+      buffer.append(color->to<RgbB>().toString());
     }
   }
 };
@@ -247,12 +247,11 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
-    fmt::format_to(
-      std::ostreambuf_iterator<char>{stream}, " 0\n"); // extra value written here
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
+    buffer.append(" 0\n"); // extra value written here
   }
 };
 
@@ -265,11 +264,11 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const mdl::BrushFace& face) const override
+  void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveMaterialInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>{stream}, "\n");
+    writeFacePoints(buffer, face);
+    writeValveMaterialInfo(buffer, face);
+    buffer.push_back('\n');
   }
 };
 
@@ -307,80 +306,37 @@ MapFileSerializer::MapFileSerializer(std::ostream& stream)
 }
 
 void MapFileSerializer::doBeginFile(
-  const std::vector<const mdl::Node*>& rootNodes, kdl::task_manager& taskManager)
+  const std::vector<const mdl::Node*>& /* rootNodes */, kdl::task_manager& taskManager)
 {
-  contract_pre(m_nodeToPrecomputedString.empty());
-
-  // collect nodes
-  auto nodesToSerialize =
-    std::vector<std::variant<const mdl::BrushNode*, const mdl::PatchNode*>>{};
-  nodesToSerialize.reserve(rootNodes.size());
-
-  mdl::Node::visitAll(
-    rootNodes,
-    kdl::overload(
-      [](auto&& thisLambda, const mdl::WorldNode* world) {
-        world->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::LayerNode* layer) {
-        layer->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::GroupNode* group) {
-        group->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::EntityNode* entity) {
-        entity->visitChildren(thisLambda);
-      },
-      [&](const mdl::BrushNode* brush) { nodesToSerialize.emplace_back(brush); },
-      [&](const mdl::PatchNode* patchNode) {
-        nodesToSerialize.emplace_back(patchNode);
-      }));
-
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const mdl::Node*, PrecomputedString>;
-  auto tasks = nodesToSerialize | std::views::transform([&](const auto& node) {
-                 return std::function{[&]() {
-                   return std::visit(
-                     kdl::overload(
-                       [&](const mdl::BrushNode* brushNode) {
-                         return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-                       },
-                       [&](const mdl::PatchNode* patchNode) {
-                         return Entry{patchNode, writePatch(patchNode->patch())};
-                       }),
-                     node);
-                 }};
-               });
-
-  // render strings and move them into a map
-  for (auto& entry : taskManager.run_tasks_and_wait(std::move(tasks)))
-  {
-    m_nodeToPrecomputedString.insert(std::move(entry));
-  }
+  m_taskManager = &taskManager;
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  writeWindow();
+}
 
 void MapFileSerializer::doBeginEntity(const mdl::Node* /* node */)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "// entity {}\n", entityNo());
+  fmt::format_to(std::back_inserter(m_pendingText), "// entity {}\n", entityNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "{{\n");
+  fmt::format_to(std::back_inserter(m_pendingText), "{{\n");
   ++m_line;
 }
 
 void MapFileSerializer::doEndEntity(const mdl::Node* node)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "}}\n");
+  fmt::format_to(std::back_inserter(m_pendingText), "}}\n");
   ++m_line;
   setFilePosition(node);
+  writeWindowIfFull();
 }
 
 void MapFileSerializer::doEntityProperty(const mdl::EntityProperty& attribute)
 {
   fmt::format_to(
-    std::ostreambuf_iterator<char>{m_stream},
+    std::back_inserter(m_pendingText),
     "\"{}\" \"{}\"\n",
     escapeEntityProperties(attribute.key()),
     escapeEntityProperties(attribute.value()));
@@ -389,48 +345,89 @@ void MapFileSerializer::doEntityProperty(const mdl::EntityProperty& attribute)
 
 void MapFileSerializer::doBrush(const mdl::BrushNode* brush)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "// brush {}\n", brushNo());
+  fmt::format_to(std::back_inserter(m_pendingText), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "{{\n");
+  fmt::format_to(std::back_inserter(m_pendingText), "{{\n");
   ++m_line;
 
-  // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  contract_assert(it != std::end(m_nodeToPrecomputedString));
+  writePendingNode(brush);
 
-  const auto& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
-
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "}}\n");
+  fmt::format_to(std::back_inserter(m_pendingText), "}}\n");
   ++m_line;
   setFilePosition(brush);
+  writeWindowIfFull();
 }
 
 void MapFileSerializer::doBrushFace(const mdl::BrushFace& face)
 {
   const size_t lines = 1u;
-  doWriteBrushFace(m_stream, face);
+  doWriteBrushFace(m_pendingText, face);
   face.setFilePosition(m_line, lines);
   m_line += lines;
 }
 
 void MapFileSerializer::doPatch(const mdl::PatchNode* patchNode)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "// brush {}\n", brushNo());
+  fmt::format_to(std::back_inserter(m_pendingText), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
 
-  // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
-  contract_assert(it != std::end(m_nodeToPrecomputedString));
-
-  const auto& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  writePendingNode(patchNode);
 
   setFilePosition(patchNode);
+  writeWindowIfFull();
+}
+
+/**
+ * Adds the given node to the current window. Its string is computed when the window is
+ * written, but its line count is known in advance so that the file positions of all
+ * nodes can be set right away.
+ */
+void MapFileSerializer::writePendingNode(const mdl::Node* node)
+{
+  m_pendingNodes.push_back(PendingNode{std::exchange(m_pendingText, {}), node});
+  m_line += lineCount(node);
+}
+
+void MapFileSerializer::writeWindowIfFull()
+{
+  if (m_pendingNodes.size() >= WindowSize || m_pendingText.size() >= MaxPendingTextSize)
+  {
+    writeWindow();
+  }
+}
+
+void MapFileSerializer::writeWindow()
+{
+  auto strings = std::vector<PrecomputedString>(m_pendingNodes.size());
+  const auto writeString = [&](const size_t i) {
+    strings[i] = writeNode(m_pendingNodes[i].node);
+  };
+
+  if (m_taskManager)
+  {
+    m_taskManager->run_range(0, m_pendingNodes.size(), WindowGrain, writeString);
+  }
+  else
+  {
+    for (size_t i = 0; i < m_pendingNodes.size(); ++i)
+    {
+      writeString(i);
+    }
+  }
+
+  for (size_t i = 0; i < m_pendingNodes.size(); ++i)
+  {
+    contract_assert(strings[i].lineCount == lineCount(m_pendingNodes[i].node));
+
+    m_stream << m_pendingNodes[i].precedingText;
+    m_stream << strings[i].string;
+  }
+  m_stream << m_pendingText;
+
+  m_pendingNodes.clear();
+  m_pendingText.clear();
 }
 
 void MapFileSerializer::setFilePosition(const mdl::Node* node)
@@ -454,12 +451,13 @@ size_t MapFileSerializer::startLine()
 MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
   const mdl::Brush& brush) const
 {
-  auto stream = std::stringstream{};
+  auto string = std::string{};
+  string.reserve(brush.faces().size() * 96);
   for (const auto& face : brush.faces())
   {
-    doWriteBrushFace(stream, face);
+    doWriteBrushFace(string, face);
   }
-  return {stream.str(), brush.faces().size()};
+  return {std::move(string), brush.faces().size()};
 }
 
 MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
@@ -514,4 +512,36 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
   return {stream.str(), lineCount};
 }
 
+MapFileSerializer::PrecomputedString MapFileSerializer::writeNode(
+  const mdl::Node* node) const
+{
+  auto result = PrecomputedString{};
+  node->accept(kdl::overload(
+    [](const mdl::WorldNode*) {},
+    [](const mdl::LayerNode*) {},
+    [](const mdl::GroupNode*) {},
+    [](const mdl::EntityNode*) {},
+    [&](const mdl::BrushNode* brushNode) {
+      result = writeBrushFaces(brushNode->brush());
+    },
+    [&](const mdl::PatchNode* patchNode) { result = writePatch(patchNode->patch()); }));
+  return result;
+}
+
+size_t MapFileSerializer::lineCount(const mdl::Node* node)
+{
+  auto result = size_t(0);
+  node->accept(kdl::overload(
+    [](const mdl::WorldNode*) {},
+    [](const mdl::LayerNode*) {},
+    [](const mdl::GroupNode*) {},
+    [](const mdl::EntityNode*) {},
+    [&](const mdl::BrushNode* brushNode) { result = brushNode->brush().faces().size(); },
+    [&](const mdl::PatchNode* patchNode) {
+      // see writePatch
+      result = patchNode->patch().pointRowCount() + 9u;
+    }));
+  return result;
+}
+
 } // namespace tb::io
@@ -24,7 +24,7 @@
 
 #include <iosfwd>
 #include <memory>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 
@@ -57,7 +57,27 @@ private:
     std::string string;
     size_t lineCount;
   };
-  std::unordered_map<const mdl::Node*, PrecomputedString> m_nodeToPrecomputedString;
+
+  struct PendingNode
+  {
+    std::string precedingText;
+    const mdl::Node* node;
+  };
+
+  /**
+   * The output is collected in a window and written to the stream once the window refers
+   * to WindowSize brushes and patches, or once the text between them exceeds
+   * MaxPendingTextSize bytes. The brushes and patches of a window are serialized to
+   * strings in parallel, regardless of the entities they belong to, so only one window is
+   * held in memory at a time.
+   */
+  static constexpr size_t WindowSize = 4096;
+  static constexpr size_t WindowGrain = 32;
+  static constexpr size_t MaxPendingTextSize = 1024 * 1024;
+
+  kdl::task_manager* m_taskManager = nullptr;
+  std::vector<PendingNode> m_pendingNodes;
+  std::string m_pendingText;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
@@ -81,14 +101,18 @@ private:
   void doPatch(const mdl::PatchNode* patchNode) override;
 
 private:
+  void writePendingNode(const mdl::Node* node);
+  void writeWindowIfFull();
+  void writeWindow();
   void setFilePosition(const mdl::Node* node);
   size_t startLine();
 
 private: // threadsafe
-  virtual void doWriteBrushFace(
-    std::ostream& stream, const mdl::BrushFace& face) const = 0;
+  virtual void doWriteBrushFace(std::string& buffer, const mdl::BrushFace& face) const = 0;
   PrecomputedString writeBrushFaces(const mdl::Brush& brush) const;
   PrecomputedString writePatch(const mdl::BezierPatch& patch) const;
+  PrecomputedString writeNode(const mdl::Node* node) const;
+  static size_t lineCount(const mdl::Node* node);
 };
 
 } // namespace io
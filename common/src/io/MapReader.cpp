@@ -19,10 +19,13 @@
 
 #include "MapReader.h"
 
+#include "BufferedParserStatus.h"
 #include "Error.h" // IWYU pragma: keep
 #include "FileLocation.h"
 #include "ParserStatus.h"
 #include "Uuid.h"
+#include "io/MapCache.h"
+#include "io/MapChunks.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
@@ -47,6 +50,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -60,6 +64,12 @@ namespace tb::io
 namespace
 {
 
+/**
+ * Maps are split into chunks of roughly this size, which are then parsed in parallel.
+ * Smaller maps are parsed sequentially.
+ */
+constexpr auto ParallelParseChunkSize = size_t(256 * 1024);
+
 template <typename T>
 auto getFilePosition(const T& info)
 {
@@ -68,24 +78,190 @@ auto getFilePosition(const T& info)
   return std::tuple{startLine, lineCount};
 }
 
+/** The object infos parsed from a map chunk. */
+struct ChunkInfo
+{
+  /**
+   * If the chunk starts inside of an entity, the first element is a placeholder for that
+   * entity. Its end location is set if the entity is closed in this chunk.
+   */
+  std::vector<MapReader::ObjectInfo> objectInfos;
+
+  /** Whether the chunk starts inside of an entity. */
+  bool startsInsideEntity;
+
+  /** The index of the entity that is still open at the end of the chunk, if any. */
+  std::optional<size_t> openEntityInfo;
+};
+
+/**
+ * Checks that every chunk that starts inside of an entity follows a chunk that left an
+ * entity open, and that no entity is left open at the end.
+ */
+bool checkChunkInfos(const std::vector<ChunkInfo>& chunkInfos)
+{
+  auto entityOpen = false;
+  for (const auto& chunkInfo : chunkInfos)
+  {
+    if (chunkInfo.startsInsideEntity != entityOpen)
+    {
+      return false;
+    }
+    entityOpen = chunkInfo.openEntityInfo != std::nullopt;
+  }
+  return !entityOpen;
+}
+
+/**
+ * Concatenates the object infos of the given chunks, fixing up the parent indices of
+ * brushes and patches and the end locations of entities that span multiple chunks.
+ */
+std::vector<MapReader::ObjectInfo> mergeChunkInfos(std::vector<ChunkInfo> chunkInfos)
+{
+  auto result = std::vector<MapReader::ObjectInfo>{};
+  auto openEntityInfo = std::optional<size_t>{};
+
+  for (auto& chunkInfo : chunkInfos)
+  {
+    const auto offset = result.size();
+    const auto toGlobalIndex = [&](const size_t localIndex) {
+      if (chunkInfo.startsInsideEntity)
+      {
+        return localIndex == 0 ? *openEntityInfo : offset + localIndex - 1;
+      }
+      return offset + localIndex;
+    };
+
+    auto objectInfos = std::span{chunkInfo.objectInfos};
+    if (chunkInfo.startsInsideEntity)
+    {
+      const auto& placeholder = std::get<MapReader::EntityInfo>(objectInfos.front());
+      if (placeholder.endLocation)
+      {
+        auto& entityInfo = std::get<MapReader::EntityInfo>(result[*openEntityInfo]);
+        entityInfo.endLocation = placeholder.endLocation;
+      }
+      objectInfos = objectInfos.subspan(1);
+    }
+
+    for (auto& objectInfo : objectInfos)
+    {
+      std::visit(
+        kdl::overload(
+          [](MapReader::EntityInfo&) {},
+          [&](MapReader::BrushInfo& brushInfo) {
+            if (brushInfo.parentIndex)
+            {
+              brushInfo.parentIndex = toGlobalIndex(*brushInfo.parentIndex);
+            }
+          },
+          [&](MapReader::PatchInfo& patchInfo) {
+            if (patchInfo.parentIndex)
+            {
+              patchInfo.parentIndex = toGlobalIndex(*patchInfo.parentIndex);
+            }
+          }),
+        objectInfo);
+      result.push_back(std::move(objectInfo));
+    }
+
+    openEntityInfo = chunkInfo.openEntityInfo
+                       ? std::optional{toGlobalIndex(*chunkInfo.openEntityInfo)}
+                       : std::nullopt;
+  }
+
+  return result;
+}
+
 } // namespace
 
+/**
+ * Parses a single map chunk into object infos.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+private:
+  bool m_startsInsideEntity;
+
+public:
+  ChunkReader(
+    const MapChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat)
+    : MapReader{chunk, sourceMapFormat, targetMapFormat, {}}
+    , m_startsInsideEntity{chunk.startsInsideEntity}
+  {
+    if (m_startsInsideEntity)
+    {
+      // stands in for the entity that was opened by a preceding chunk
+      m_currentEntityInfo = m_objectInfos.size();
+      m_objectInfos.emplace_back(EntityInfo{{}, chunk.location, std::nullopt});
+    }
+  }
+
+  Result<ChunkInfo> read(ParserStatus& status)
+  {
+    return parseEntityChunk(m_startsInsideEntity, status) | kdl::transform([&]() {
+             return ChunkInfo{
+               std::move(m_objectInfos), m_startsInsideEntity, m_currentEntityInfo};
+           });
+  }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+};
+
 MapReader::MapReader(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat,
   mdl::EntityPropertyConfig entityPropertyConfig)
   : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  , m_str{str}
+  , m_entityPropertyConfig{std::move(entityPropertyConfig)}
+{
+}
+
+MapReader::MapReader(
+  const MapChunk& chunk,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat,
+  mdl::EntityPropertyConfig entityPropertyConfig)
+  : StandardMapParser{chunk.str, chunk.location, sourceMapFormat, targetMapFormat}
+  , m_str{chunk.str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
 Result<void> MapReader::readEntities(
-  const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
+  const vm::bbox3d& worldBounds,
+  ParserStatus& status,
+  kdl::task_manager& taskManager,
+  MapCacheWriter* mapCacheWriter)
 {
   m_worldBounds = worldBounds;
-  return parseEntities(status)
-         | kdl::transform([&]() { createNodes(status, taskManager); });
+  if (parseEntitiesInParallel(status, taskManager))
+  {
+    createNodes(status, taskManager, mapCacheWriter);
+    return kdl::void_success;
+  }
+
+  return parseEntities(status) | kdl::transform([&]() {
+           createNodes(status, taskManager, mapCacheWriter);
+         });
 }
 
 Result<void> MapReader::readBrushes(
@@ -103,6 +279,17 @@ Result<void> MapReader::readBrushFaces(
   return parseBrushFaces(status);
 }
 
+void MapReader::readObjectInfos(
+  std::vector<ObjectInfo> objectInfos,
+  const vm::bbox3d& worldBounds,
+  ParserStatus& status,
+  kdl::task_manager& taskManager)
+{
+  m_worldBounds = worldBounds;
+  m_objectInfos = std::move(objectInfos);
+  createNodes(status, taskManager);
+}
+
 // implement MapParser interface
 
 void MapReader::onBeginEntity(
@@ -127,7 +314,8 @@ void MapReader::onEndEntity(const FileLocation& endLocation, ParserStatus& /* st
 
 void MapReader::onBeginBrush(const FileLocation& location, ParserStatus& /* status */)
 {
-  m_objectInfos.emplace_back(BrushInfo{{}, location, std::nullopt, m_currentEntityInfo});
+  m_objectInfos.emplace_back(
+    BrushInfo{{}, location, std::nullopt, m_currentEntityInfo, std::nullopt});
 }
 
 void MapReader::onEndBrush(const FileLocation& endLocation, ParserStatus& /* status */)
@@ -199,6 +387,72 @@ void MapReader::onPatch(
 
 // helper methods
 
+/**
+ * Splits the input into chunks and parses them in parallel. The messages logged while
+ * parsing each chunk are recorded and forwarded to the given status in order. Progress is
+ * reported to the given status as the chunks complete.
+ *
+ * Returns false if the input was not split into multiple chunks or if any chunk failed
+ * to parse. In that case, nothing was logged to the given status and the caller must
+ * parse the input sequentially, which reports any errors with their exact locations.
+ */
+bool MapReader::parseEntitiesInParallel(
+  ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto chunks = splitMapIntoChunks(m_str, ParallelParseChunkSize);
+  if (chunks.size() < 2)
+  {
+    return false;
+  }
+
+  auto chunkStatuses = std::vector<BufferedParserStatus>(chunks.size());
+  auto tasks = std::vector<std::function<Result<ChunkInfo>()>>{};
+  tasks.reserve(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    tasks.emplace_back([&, i]() {
+      auto reader = ChunkReader{chunks[i], m_sourceMapFormat, m_targetMapFormat};
+      return reader.read(chunkStatuses[i]);
+    });
+  }
+
+  // the tasks refer to the chunks and their statuses, so wait for all of them before
+  // looking at any result
+  auto futures = taskManager.run_tasks(std::move(tasks));
+  auto parsedSize = size_t(0);
+  for (size_t i = 0; i < futures.size(); ++i)
+  {
+    futures[i].wait();
+    parsedSize += chunks[i].str.size();
+    status.progress(std::min(double(parsedSize) / double(m_str.size()), 1.0));
+  }
+
+  auto chunkInfos = std::vector<ChunkInfo>{};
+  chunkInfos.reserve(chunks.size());
+  for (auto& future : futures)
+  {
+    auto chunkResult = future.get();
+    if (!chunkResult)
+    {
+      return false;
+    }
+    chunkInfos.push_back(std::move(chunkResult).value());
+  }
+
+  if (!checkChunkInfos(chunkInfos))
+  {
+    return false;
+  }
+
+  for (auto& chunkStatus : chunkStatuses)
+  {
+    chunkStatus.forwardTo(status);
+  }
+
+  m_objectInfos = mergeChunkInfos(std::move(chunkInfos));
+  return true;
+}
+
 namespace
 {
 /** The type of a node's container. */
@@ -590,7 +844,12 @@ CreateNodeResult createNodeFromEntityInfo(
 CreateNodeResult createBrushNode(
   MapReader::BrushInfo brushInfo, const vm::bbox3d& worldBounds)
 {
-  return mdl::Brush::create(worldBounds, std::move(brushInfo.faces))
+  auto brush =
+    brushInfo.topology
+      ? mdl::Brush::createFromTopology(
+          worldBounds, std::move(brushInfo.faces), *brushInfo.topology)
+      : mdl::Brush::create(worldBounds, std::move(brushInfo.faces));
+  return std::move(brush)
          | kdl::transform([&](auto brush) {
              auto brushNode = std::make_unique<mdl::BrushNode>(std::move(brush));
              const auto [startLine, lineCount] = getFilePosition(brushInfo);
@@ -634,35 +893,69 @@ CreateNodeResult createPatchNode(MapReader::PatchInfo patchInfo)
  * sparse, that is, it contains empty optionals in place of nodes that we failed to
  * create. We need the indices to remain correct because we use them to refer to parent
  * nodes later.
+ *
+ * If a map cache writer is given, every object is recorded in it by the task that creates
+ * its node. Entities and patches are recorded before they are moved into their nodes, and
+ * brushes are recorded once they have been created so that their geometry is cached too.
  */
 std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   const mdl::EntityPropertyConfig& entityPropertyConfig,
   std::vector<MapReader::ObjectInfo> objectInfos,
   const vm::bbox3d& worldBounds,
   const mdl::MapFormat mapFormat,
+  MapCacheWriter* mapCacheWriter,
   ParserStatus& status,
   kdl::task_manager& taskManager)
 {
+  if (mapCacheWriter)
+  {
+    mapCacheWriter->reset(mapFormat, objectInfos.size());
+  }
+
   // create nodes in parallel, moving data out of objectInfos
   // we store optionals in the result vector to make the elements default constructible,
   // which is a requirement for parallel transform
-  auto tasks = objectInfos | std::views::transform([&](auto& objectInfo) {
-                 return std::function{[&]() -> CreateNodeResult {
-                   return std::visit(
-                     kdl::overload(
-                       [&](MapReader::EntityInfo& entityInfo) {
-                         return createNodeFromEntityInfo(
-                           entityPropertyConfig, std::move(entityInfo), mapFormat);
-                       },
-                       [&](MapReader::BrushInfo& brushInfo) {
-                         return createBrushNode(std::move(brushInfo), worldBounds);
-                       },
-                       [&](MapReader::PatchInfo& patchInfo) {
-                         return createPatchNode(std::move(patchInfo));
-                       }),
-                     objectInfo);
-                 }};
-               });
+  auto tasks =
+    std::views::iota(size_t(0), objectInfos.size())
+    | std::views::transform([&](const size_t index) {
+        return std::function{[&, index]() -> CreateNodeResult {
+          return std::visit(
+            kdl::overload(
+              [&](MapReader::EntityInfo& entityInfo) {
+                if (mapCacheWriter)
+                {
+                  mapCacheWriter->addEntity(index, entityInfo);
+                }
+                return createNodeFromEntityInfo(
+                  entityPropertyConfig, std::move(entityInfo), mapFormat);
+              },
+              [&](MapReader::BrushInfo& brushInfo) {
+                const auto brushInfoWithoutFaces = MapReader::BrushInfo{
+                  {},
+                  brushInfo.startLocation,
+                  brushInfo.endLocation,
+                  brushInfo.parentIndex,
+                  std::nullopt};
+                auto result = createBrushNode(std::move(brushInfo), worldBounds);
+                if (mapCacheWriter && result)
+                {
+                  const auto& brushNode =
+                    static_cast<const mdl::BrushNode&>(*result.value().node);
+                  mapCacheWriter->addBrush(
+                    index, brushInfoWithoutFaces, brushNode.brush());
+                }
+                return result;
+              },
+              [&](MapReader::PatchInfo& patchInfo) {
+                if (mapCacheWriter)
+                {
+                  mapCacheWriter->addPatch(index, patchInfo);
+                }
+                return createPatchNode(std::move(patchInfo));
+              }),
+            objectInfos[index]);
+        }};
+      });
 
   auto results = taskManager.run_tasks_and_wait(std::move(tasks));
   return results | std::views::transform([&](auto& createNodeResult) {
@@ -925,7 +1218,8 @@ std::unordered_map<mdl::Node*, mdl::Node*> buildNodeToParentMap(
  * Nodes for which the parent node is not known (e.g. when parsing only brushes) are added
  * to a default parent, which is returned from the `onWorldNode` callback.
  */
-void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager)
+void MapReader::createNodes(
+  ParserStatus& status, kdl::task_manager& taskManager, MapCacheWriter* mapCacheWriter)
 {
   // create nodes from the recorded object infos
   auto nodeInfos = createNodesFromObjectInfos(
@@ -933,6 +1227,7 @@ void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager
     std::move(m_objectInfos),
     m_worldBounds,
     m_targetMapFormat,
+    mapCacheWriter,
     status,
     taskManager);
 
@@ -43,6 +43,11 @@ namespace tb
 {
 class ParserStatus;
 
+namespace io
+{
+class MapCacheWriter;
+}
+
 namespace mdl
 {
 class BrushNode;
@@ -58,6 +63,7 @@ class WorldNode;
 
 namespace io
 {
+struct MapChunk;
 
 /**
  * Abstract superclass containing common code for:
@@ -69,7 +75,8 @@ namespace io
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). Large inputs are split into chunks which are parsed in parallel, and
+ * the resulting object infos are concatenated.
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -92,6 +99,13 @@ public: // only public so that helper methods can see these declarations
     FileLocation startLocation;
     std::optional<FileLocation> endLocation;
     std::optional<size_t> parentIndex;
+    /**
+     * The topology of the brush geometry if it is already known, e.g. when the brush info
+     * was read from a map cache. If set, the faces must be in the order of its face
+     * planes and the geometry is restored from it instead of being computed from the
+     * faces.
+     */
+    std::optional<mdl::BrushGeometry::Topology> topology;
   };
 
   struct PatchInfo
@@ -108,6 +122,9 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
 
@@ -132,11 +149,25 @@ protected:
     mdl::MapFormat targetMapFormat,
     mdl::EntityPropertyConfig entityPropertyConfig);
 
+private:
+  MapReader(
+    const MapChunk& chunk,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat,
+    mdl::EntityPropertyConfig entityPropertyConfig);
+
+protected:
   /**
    * Attempts to parse as one or more entities.
+   *
+   * If a map cache writer is given, the parsed objects are recorded in it while the
+   * nodes are created.
    */
   Result<void> readEntities(
-    const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
+    const vm::bbox3d& worldBounds,
+    ParserStatus& status,
+    kdl::task_manager& taskManager,
+    MapCacheWriter* mapCacheWriter = nullptr);
   /**
    * Attempts to parse as one or more brushes without any enclosing entity.
    */
@@ -146,6 +177,15 @@ protected:
    * Attempts to parse as one or more brush faces.
    */
   Result<void> readBrushFaces(const vm::bbox3d& worldBounds, ParserStatus& status);
+  /**
+   * Creates nodes from previously recorded object infos instead of parsing, e.g. when
+   * restoring a map from a map cache.
+   */
+  void readObjectInfos(
+    std::vector<ObjectInfo> objectInfos,
+    const vm::bbox3d& worldBounds,
+    ParserStatus& status,
+    kdl::task_manager& taskManager);
 
 protected: // implement MapParser interface
   void onBeginEntity(
@@ -184,7 +224,11 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
-  void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
+  bool parseEntitiesInParallel(ParserStatus& status, kdl::task_manager& taskManager);
+  void createNodes(
+    ParserStatus& status,
+    kdl::task_manager& taskManager,
+    MapCacheWriter* mapCacheWriter = nullptr);
 
 private: // subclassing interface - these will be called in the order that nodes should be
          // inserted
@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberFormat.h"
+
+#include "kd/contracts.h"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <string_view>
+
+namespace tb::io
+{
+namespace
+{
+
+template <typename T>
+void appendFloatingPoint(std::string& buffer, const T value, const int maxFixedExponent)
+{
+#if defined(__APPLE__)
+  // floating point std::to_chars is not available on all supported macOS versions
+  fmt::format_to(std::back_inserter(buffer), "{}", value);
+#else
+  if (!std::isfinite(value))
+  {
+    fmt::format_to(std::back_inserter(buffer), "{}", value);
+    return;
+  }
+
+  // shortest round trip representation in exponent notation, e.g. -1.25e+02
+  char chars[32];
+  const auto [end, ec] =
+    std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::scientific);
+  contract_assert(ec == std::errc{});
+
+  const auto str = std::string_view{chars, end};
+  const auto ePos = str.find('e');
+
+  auto exponentStr = str.substr(ePos + 1);
+  if (exponentStr.front() == '+')
+  {
+    exponentStr.remove_prefix(1);
+  }
+
+  auto exponent = 0;
+  std::from_chars(
+    exponentStr.data(), exponentStr.data() + exponentStr.size(), exponent);
+
+  if (exponent < -4 || exponent >= maxFixedExponent)
+  {
+    buffer.append(str);
+    return;
+  }
+
+  auto mantissa = str.substr(0, ePos);
+  if (mantissa.front() == '-')
+  {
+    buffer.push_back('-');
+    mantissa.remove_prefix(1);
+  }
+
+  // collect the significant digits without the decimal point
+  char digits[32];
+  auto digitCount = 0;
+  for (const auto c : mantissa)
+  {
+    if (c != '.')
+    {
+      digits[digitCount++] = c;
+    }
+  }
+
+  if (exponent < 0)
+  {
+    // 0.00ddd
+    buffer.append("0.");
+    buffer.append(size_t(-exponent - 1), '0');
+    buffer.append(digits, size_t(digitCount));
+  }
+  else if (exponent + 1 >= digitCount)
+  {
+    // ddd00
+    buffer.append(digits, size_t(digitCount));
+    buffer.append(size_t(exponent + 1 - digitCount), '0');
+  }
+  else
+  {
+    // dd.ddd
+    buffer.append(digits, size_t(exponent + 1));
+    buffer.push_back('.');
+    buffer.append(digits + exponent + 1, size_t(digitCount - exponent - 1));
+  }
+#endif
+}
+
+} // namespace
+
+void appendNumber(std::string& buffer, const int value)
+{
+  char chars[16];
+  const auto [end, ec] = std::to_chars(chars, chars + sizeof(chars), value);
+  contract_assert(ec == std::errc{});
+
+  buffer.append(chars, end);
+}
+
+void appendNumber(std::string& buffer, const float value)
+{
+  // newer versions of fmt switch to exponent notation at 1e7 for float, older versions
+  // use the same range as for double
+  static const auto maxFixedExponent =
+    fmt::format("{}", 1e7f).find('e') == std::string::npos ? 16 : 7;
+
+  appendFloatingPoint(buffer, value, maxFixedExponent);
+}
+
+void appendNumber(std::string& buffer, const double value)
+{
+  appendFloatingPoint(buffer, value, 16);
+}
+
+} // namespace tb::io
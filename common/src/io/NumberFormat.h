@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace tb::io
+{
+
+/**
+ * Appends the given integer to the given buffer.
+ */
+void appendNumber(std::string& buffer, int value);
+
+/**
+ * Appends the shortest representation of the given value that round trips to the given
+ * buffer.
+ *
+ * The output is identical to that of fmt::format("{}", value): values with a decimal
+ * exponent in [-4, 16) are written in fixed notation without trailing zeros, e.g. 32, 0.5
+ * or 0.0001, and all other values are written in exponent notation, e.g. 1e-05 or
+ * 1.5e+20. Depending on the version of fmt, the upper bound for float is 7 instead.
+ */
+void appendNumber(std::string& buffer, float value);
+void appendNumber(std::string& buffer, double value);
+
+} // namespace tb::io
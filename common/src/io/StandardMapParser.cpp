@@ -64,8 +64,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{tokenNames(), str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{tokenNames(), str, "\"", '\\', line, column}
 {
 }
 
@@ -186,6 +187,19 @@ StandardMapParser::StandardMapParser(
   contract_pre(targetMapFormat != mdl::MapFormat::Unknown);
 }
 
+StandardMapParser::StandardMapParser(
+  const std::string_view str,
+  const FileLocation& startLocation,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat)
+  : m_tokenizer{str, startLocation.line, startLocation.column.value_or(1)}
+  , m_sourceMapFormat{sourceMapFormat}
+  , m_targetMapFormat{targetMapFormat}
+{
+  contract_pre(m_sourceMapFormat != mdl::MapFormat::Unknown);
+  contract_pre(targetMapFormat != mdl::MapFormat::Unknown);
+}
+
 StandardMapParser::~StandardMapParser() = default;
 
 Result<void> StandardMapParser::parseEntities(ParserStatus& status)
@@ -206,6 +220,40 @@ Result<void> StandardMapParser::parseEntities(ParserStatus& status)
   }
 }
 
+Result<void> StandardMapParser::parseEntityChunk(
+  const bool startsInsideEntity, ParserStatus& status)
+{
+  try
+  {
+    if (startsInsideEntity && !parseEntityRemainder(status))
+    {
+      return kdl::void_success;
+    }
+
+    while (m_tokenizer.peekToken(QuakeMapToken::OBrace | QuakeMapToken::Eof)
+             .hasType(QuakeMapToken::OBrace))
+    {
+      const auto startLocation = m_tokenizer.nextToken(QuakeMapToken::OBrace).location();
+
+      auto properties = std::vector<mdl::EntityProperty>();
+      auto propertyKeys = EntityPropertyKeys();
+      parseEntityProperties(properties, propertyKeys, status);
+
+      onBeginEntity(startLocation, properties, status);
+      if (!parseEntityRemainder(status))
+      {
+        break;
+      }
+    }
+
+    return kdl::void_success;
+  }
+  catch (const ParserException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
 Result<void> StandardMapParser::parseBrushesOrPatches(ParserStatus& status)
 {
   try
@@ -268,6 +316,25 @@ void StandardMapParser::parseEntity(ParserStatus& status)
   }
 }
 
+/**
+ * Parses the objects and the closing brace of the current entity. Returns false if the
+ * input ends before the closing brace.
+ */
+bool StandardMapParser::parseEntityRemainder(ParserStatus& status)
+{
+  parseObjects(status);
+
+  const auto token = m_tokenizer.skipAndNextToken(
+    QuakeMapToken::Comment, QuakeMapToken::CBrace | QuakeMapToken::Eof);
+  if (token.hasType(QuakeMapToken::Eof))
+  {
+    return false;
+  }
+
+  onEndEntity(token.location(), status);
+  return true;
+}
+
 void StandardMapParser::parseEntityProperties(
   std::vector<mdl::EntityProperty>& properties,
   EntityPropertyKeys& keys,
@@ -67,7 +67,7 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -102,10 +102,33 @@ public:
   StandardMapParser(
     std::string_view str, mdl::MapFormat sourceMapFormat, mdl::MapFormat targetMapFormat);
 
+  /**
+   * Creates a new parser for a part of a larger string. The given location is the location
+   * of the first character of the given string in the larger string, and all reported
+   * locations are relative to it.
+   *
+   * @param str the string to parse
+   * @param startLocation the location of the given string
+   * @param sourceMapFormat the expected format of the given string
+   * @param targetMapFormat the format to convert the created objects to
+   */
+  StandardMapParser(
+    std::string_view str,
+    const FileLocation& startLocation,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat);
+
   ~StandardMapParser() override;
 
 protected:
   Result<void> parseEntities(ParserStatus& status);
+  /**
+   * Parses a chunk of entities as returned by splitMapIntoChunks. If the chunk starts
+   * inside of an entity, the brushes and patches of that entity and its closing brace are
+   * parsed first. The last entity of the chunk may be left open if the input ends before
+   * its closing brace, in which case onEndEntity is not called for it.
+   */
+  Result<void> parseEntityChunk(bool startsInsideEntity, ParserStatus& status);
   Result<void> parseBrushesOrPatches(ParserStatus& status);
   Result<void> parseBrushFaces(ParserStatus& status);
 
@@ -113,6 +136,7 @@ protected:
 
 private:
   void parseEntity(ParserStatus& status);
+  bool parseEntityRemainder(ParserStatus& status);
   void parseEntityProperties(
     std::vector<mdl::EntityProperty>& properties,
     EntityPropertyKeys& keys,
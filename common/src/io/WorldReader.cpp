@@ -72,7 +72,8 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
   const vm::bbox3d& worldBounds,
   const mdl::EntityPropertyConfig& entityPropertyConfig,
   ParserStatus& status,
-  kdl::task_manager& taskManager)
+  kdl::task_manager& taskManager,
+  MapCacheWriter* mapCacheWriter)
 {
   auto parserErrors = std::vector<std::tuple<mdl::MapFormat, std::string>>{};
 
@@ -84,7 +85,7 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
     }
 
     auto reader = WorldReader{str, mapFormat, entityPropertyConfig};
-    if (auto result = reader.read(worldBounds, status, taskManager))
+    if (auto result = reader.read(worldBounds, status, taskManager, mapCacheWriter))
     {
       return result;
     }
@@ -171,15 +172,35 @@ void setLinkIds(mdl::WorldNode& worldNode, ParserStatus& status)
 } // namespace
 
 Result<std::unique_ptr<mdl::WorldNode>> WorldReader::read(
-  const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
+  const vm::bbox3d& worldBounds,
+  ParserStatus& status,
+  kdl::task_manager& taskManager,
+  MapCacheWriter* mapCacheWriter)
+{
+  return readEntities(worldBounds, status, taskManager, mapCacheWriter)
+         | kdl::transform([&]() { return finishWorld(status); });
+}
+
+std::unique_ptr<mdl::WorldNode> WorldReader::fromObjectInfos(
+  const mdl::MapFormat mapFormat,
+  std::vector<ObjectInfo> objectInfos,
+  const vm::bbox3d& worldBounds,
+  const mdl::EntityPropertyConfig& entityPropertyConfig,
+  ParserStatus& status,
+  kdl::task_manager& taskManager)
+{
+  auto reader = WorldReader{"", mapFormat, entityPropertyConfig};
+  reader.readObjectInfos(std::move(objectInfos), worldBounds, status, taskManager);
+  return reader.finishWorld(status);
+}
+
+std::unique_ptr<mdl::WorldNode> WorldReader::finishWorld(ParserStatus& status)
 {
-  return readEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
-           sanitizeLayerSortIndicies(*m_worldNode, status);
-           setLinkIds(*m_worldNode, status);
-           m_worldNode->rebuildNodeTree();
-           m_worldNode->enableNodeTreeUpdates();
-           return std::move(m_worldNode);
-         });
+  sanitizeLayerSortIndicies(*m_worldNode, status);
+  setLinkIds(*m_worldNode, status);
+  m_worldNode->rebuildNodeTree();
+  m_worldNode->enableNodeTreeUpdates();
+  return std::move(m_worldNode);
 }
 
 mdl::Node* WorldReader::onWorldNode(
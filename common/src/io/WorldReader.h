@@ -56,8 +56,35 @@ public:
     mdl::MapFormat sourceAndTargetMapFormat,
     const mdl::EntityPropertyConfig& entityPropertyConfig);
 
+  /**
+   * Reads the world. If a map cache writer is given, the parsed objects are recorded in
+   * it.
+   */
   Result<std::unique_ptr<mdl::WorldNode>> read(
-    const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
+    const vm::bbox3d& worldBounds,
+    ParserStatus& status,
+    kdl::task_manager& taskManager,
+    MapCacheWriter* mapCacheWriter = nullptr);
+
+  /**
+   * Creates a world from object infos that were recorded when a map was parsed, e.g. by
+   * reading them from a map cache.
+   *
+   * @param mapFormat the format of the map that the object infos were recorded from
+   * @param objectInfos the object infos
+   * @param worldBounds world bounds
+   * @param entityPropertyConfig the entity property config to use
+   * @param status status
+   * @param taskManager the task manager to use for parallel tasks
+   * @return the world node
+   */
+  static std::unique_ptr<mdl::WorldNode> fromObjectInfos(
+    mdl::MapFormat mapFormat,
+    std::vector<ObjectInfo> objectInfos,
+    const vm::bbox3d& worldBounds,
+    const mdl::EntityPropertyConfig& entityPropertyConfig,
+    ParserStatus& status,
+    kdl::task_manager& taskManager);
 
   /**
    * Try to parse the given string as the given map formats, in order.
@@ -68,6 +95,7 @@ public:
    * @param worldBounds world bounds
    * @param status status
    * @param taskManager the task manager to use for parallel tasks
+   * @param mapCacheWriter if given, records the objects of the map
    * @return the world node or an error if `str` can't be parsed by any of the given
    * formats
    */
@@ -77,7 +105,11 @@ public:
     const vm::bbox3d& worldBounds,
     const mdl::EntityPropertyConfig& entityPropertyConfig,
     ParserStatus& status,
-    kdl::task_manager& taskManager);
+    kdl::task_manager& taskManager,
+    MapCacheWriter* mapCacheWriter = nullptr);
+
+private:
+  std::unique_ptr<mdl::WorldNode> finishWorld(ParserStatus& status);
 
 private: // implement MapReader interface
   mdl::Node* onWorldNode(
@@ -109,6 +109,45 @@ Result<Brush> Brush::create(const vm::bbox3d& worldBounds, std::vector<BrushFace
          | kdl::transform([&]() { return std::move(brush); });
 }
 
+Result<Brush> Brush::createFromTopology(
+  const vm::bbox3d& worldBounds,
+  std::vector<BrushFace> faces,
+  const BrushGeometry::Topology& topology)
+{
+  if (faces.size() != topology.facePlanes.size())
+  {
+    return Error{"Brush topology does not match its faces"};
+  }
+
+  auto geometry = BrushGeometry::fromTopology(topology);
+  if (!geometry)
+  {
+    return Error{"Brush topology is invalid"};
+  }
+
+  // create would clip such a brush with the world bounds
+  if (!worldBounds.contains(geometry->bounds()))
+  {
+    return Error{"Brush is incomplete"};
+  }
+
+  auto brush = Brush{std::move(faces)};
+  brush.m_geometry = std::make_unique<BrushGeometry>(std::move(*geometry));
+
+  auto faceIndex = size_t(0);
+  for (BrushFaceGeometry* faceGeometry : brush.m_geometry->faces())
+  {
+    faceGeometry->setPayload(faceIndex);
+    brush.m_faces[faceIndex].setGeometry(faceGeometry);
+    ++faceIndex;
+  }
+
+  // too expensive for contract_post
+  assert(brush.checkFaceLinks());
+
+  return brush;
+}
+
 Result<void> Brush::updateGeometryFromFaces(const vm::bbox3d& worldBounds)
 {
   // First, add all faces to the brush geometry
@@ -172,6 +211,13 @@ const vm::bbox3d& Brush::bounds() const
   return m_geometry->bounds();
 }
 
+BrushGeometry::Topology Brush::topology() const
+{
+  contract_pre(m_geometry != nullptr);
+
+  return m_geometry->topology();
+}
+
 std::optional<size_t> Brush::findFace(const std::string& materialName) const
 {
   return kdl::index_of(m_faces, [&](const BrushFace& face) {
@@ -1166,6 +1212,13 @@ std::vector<Result<Brush>> Brush::subtract(
 
     for (const BrushGeometry& fragment : result)
     {
+      if (!fragment.bounds().intersects(subtrahend->bounds()))
+      {
+        // disjoint, so the subtraction would leave the fragment unchanged
+        nextResults.push_back(fragment);
+        continue;
+      }
+
       auto subFragments = fragment.subtract(*subtrahend->m_geometry);
       nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
     }
@@ -77,6 +77,19 @@ public:
   static Result<Brush> create(
     const vm::bbox3d& worldBounds, std::vector<BrushFace> faces);
 
+  /**
+   * Creates a brush from the given faces and the topology of its geometry as returned by
+   * topology(), without computing the geometry from the faces. The faces must be in the
+   * order of the face planes of the topology.
+   *
+   * Returns an error if the topology is inconsistent or doesn't match the faces, or if
+   * the brush is not contained in the given world bounds.
+   */
+  static Result<Brush> createFromTopology(
+    const vm::bbox3d& worldBounds,
+    std::vector<BrushFace> faces,
+    const BrushGeometry::Topology& topology);
+
 private:
   explicit Brush(std::vector<BrushFace> faces);
 
@@ -85,6 +98,12 @@ private:
 public:
   const vm::bbox3d& bounds() const;
 
+  /**
+   * Returns the topology of this brush's geometry. Its face planes are in the order of
+   * the faces of this brush.
+   */
+  BrushGeometry::Topology topology() const;
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& materialName) const;
   std::optional<size_t> findFace(const vm::vec3d& normal) const;
@@ -47,6 +47,26 @@
 
 namespace tb::mdl
 {
+namespace
+{
+
+BrushFace::UVCoordSystems toUVCoordSystems(std::unique_ptr<UVCoordSystem> uvCoordSystem)
+{
+  contract_pre(uvCoordSystem != nullptr);
+
+  if (const auto* paraxial = dynamic_cast<ParaxialUVCoordSystem*>(uvCoordSystem.get()))
+  {
+    return *paraxial;
+  }
+
+  const auto* parallel = dynamic_cast<ParallelUVCoordSystem*>(uvCoordSystem.get());
+  contract_assert(parallel != nullptr);
+
+  return *parallel;
+}
+
+} // namespace
+
 const BrushVertex* BrushFace::TransformHalfEdgeToVertex::operator()(
   const BrushHalfEdge* halfEdge) const
 {
@@ -65,7 +85,7 @@ BrushFace::BrushFace(const BrushFace& other)
   , m_boundary{other.m_boundary}
   , m_attributes{other.m_attributes}
   , m_materialReference{other.m_materialReference}
-  , m_uvCoordSystem{other.m_uvCoordSystem ? other.m_uvCoordSystem->clone() : nullptr}
+  , m_uvCoordSystem{other.m_uvCoordSystem}
   , m_lineNumber{other.m_lineNumber}
   , m_lineCount{other.m_lineCount}
   , m_selected{other.m_selected}
@@ -128,15 +148,15 @@ Result<BrushFace> BrushFace::create(
                                                 point1,
                                                 point2,
                                                 attributes,
-                                                std::make_unique<ParallelUVCoordSystem>(
-                                                  point0, point1, point2, attributes))
+                                                ParallelUVCoordSystem{
+                                                  point0, point1, point2, attributes})
                                             : BrushFace::create(
                                                 point0,
                                                 point1,
                                                 point2,
                                                 attributes,
-                                                std::make_unique<ParaxialUVCoordSystem>(
-                                                  point0, point1, point2, attributes));
+                                                ParaxialUVCoordSystem{
+                                                  point0, point1, point2, attributes});
 }
 
 Result<BrushFace> BrushFace::createFromStandard(
@@ -148,24 +168,21 @@ Result<BrushFace> BrushFace::createFromStandard(
 {
   contract_pre(mapFormat != MapFormat::Unknown);
 
-  auto uvCoordSystem = std::unique_ptr<UVCoordSystem>{};
-  auto attribs = BrushFaceAttributes{""};
-
   if (isParallelUVCoordSystem(mapFormat))
   {
     // Convert paraxial to parallel
-    std::tie(uvCoordSystem, attribs) =
+    auto [uvCoordSystem, attribs] =
       ParallelUVCoordSystem::fromParaxial(point0, point1, point2, inputAttribs);
-  }
-  else
-  {
-    // Pass through paraxial
-    uvCoordSystem =
-      std::make_unique<ParaxialUVCoordSystem>(point0, point1, point2, inputAttribs);
-    attribs = inputAttribs;
+    return BrushFace::create(point0, point1, point2, attribs, std::move(uvCoordSystem));
   }
 
-  return BrushFace::create(point0, point1, point2, attribs, std::move(uvCoordSystem));
+  // Pass through paraxial
+  return BrushFace::create(
+    point0,
+    point1,
+    point2,
+    inputAttribs,
+    ParaxialUVCoordSystem{point0, point1, point2, inputAttribs});
 }
 
 Result<BrushFace> BrushFace::createFromValve(
@@ -179,22 +196,16 @@ Result<BrushFace> BrushFace::createFromValve(
 {
   contract_pre(mapFormat != MapFormat::Unknown);
 
-  auto uvCoordSystem = std::unique_ptr<UVCoordSystem>{};
-  auto attribs = BrushFaceAttributes{""};
-
   if (isParallelUVCoordSystem(mapFormat))
   {
     // Pass through parallel
-    uvCoordSystem = std::make_unique<ParallelUVCoordSystem>(uAxis, vAxis);
-    attribs = inputAttribs;
-  }
-  else
-  {
-    // Convert parallel to paraxial
-    std::tie(uvCoordSystem, attribs) = ParaxialUVCoordSystem::fromParallel(
-      point1, point2, point3, inputAttribs, uAxis, vAxis);
+    return BrushFace::create(
+      point1, point2, point3, inputAttribs, ParallelUVCoordSystem{uAxis, vAxis});
   }
 
+  // Convert parallel to paraxial
+  auto [uvCoordSystem, attribs] = ParaxialUVCoordSystem::fromParallel(
+    point1, point2, point3, inputAttribs, uAxis, vAxis);
   return BrushFace::create(point1, point2, point3, attribs, std::move(uvCoordSystem));
 }
 
@@ -204,6 +215,17 @@ Result<BrushFace> BrushFace::create(
   const vm::vec3d& point2,
   const BrushFaceAttributes& attributes,
   std::unique_ptr<UVCoordSystem> uvCoordSystem)
+{
+  return create(
+    point0, point1, point2, attributes, toUVCoordSystems(std::move(uvCoordSystem)));
+}
+
+Result<BrushFace> BrushFace::create(
+  const vm::vec3d& point0,
+  const vm::vec3d& point1,
+  const vm::vec3d& point2,
+  const BrushFaceAttributes& attributes,
+  UVCoordSystems uvCoordSystem)
 {
   auto points = Points{{vm::correct(point0), vm::correct(point1), vm::correct(point2)}};
   if (const auto plane = vm::from_points(points[0], points[1], points[2]))
@@ -218,12 +240,21 @@ BrushFace::BrushFace(
   const vm::plane3d& boundary,
   BrushFaceAttributes attributes,
   std::unique_ptr<UVCoordSystem> uvCoordSystem)
+  : BrushFace{
+      points, boundary, std::move(attributes), toUVCoordSystems(std::move(uvCoordSystem))}
+{
+}
+
+BrushFace::BrushFace(
+  const BrushFace::Points& points,
+  const vm::plane3d& boundary,
+  BrushFaceAttributes attributes,
+  UVCoordSystems uvCoordSystem)
   : m_points{points}
   , m_boundary{boundary}
   , m_attributes{std::move(attributes)}
   , m_uvCoordSystem{std::move(uvCoordSystem)}
 {
-  contract_pre(m_uvCoordSystem != nullptr);
 }
 
 void BrushFace::sortFaces(std::vector<BrushFace>& faces)
@@ -244,13 +275,13 @@ void BrushFace::sortFaces(std::vector<BrushFace>& faces)
 
 std::unique_ptr<UVCoordSystemSnapshot> BrushFace::takeUVCoordSystemSnapshot() const
 {
-  return m_uvCoordSystem->takeSnapshot();
+  return uvCoordSystem().takeSnapshot();
 }
 
 void BrushFace::restoreUVCoordSystemSnapshot(
   const UVCoordSystemSnapshot& coordSystemSnapshot)
 {
-  coordSystemSnapshot.restore(*m_uvCoordSystem);
+  coordSystemSnapshot.restore(mutableUVCoordSystem());
 }
 
 void BrushFace::copyUVCoordSystemFromFace(
@@ -265,14 +296,14 @@ void BrushFace::copyUVCoordSystemFromFace(
     vm::intersect_plane_plane(sourceFacePlane, m_boundary).value_or(vm::line3d{});
   const auto refPoint = vm::project_point(seam, center());
 
-  coordSystemSnapshot.restore(*m_uvCoordSystem);
+  coordSystemSnapshot.restore(mutableUVCoordSystem());
 
   // Get the UV coords at the refPoint using the source face's attributes and tex coord
   // system
   const auto desriedCoords =
-    m_uvCoordSystem->uvCoords(refPoint, attributes, vm::vec2f{1, 1});
+    uvCoordSystem().uvCoords(refPoint, attributes, vm::vec2f{1, 1});
 
-  m_uvCoordSystem->setNormal(
+  mutableUVCoordSystem().setNormal(
     sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
 
   // Adjust the offset on this face so that the UV coordinates at the refPoint stay
@@ -280,7 +311,7 @@ void BrushFace::copyUVCoordSystemFromFace(
   if (!vm::is_zero(seam.direction, vm::Cd::almost_zero()))
   {
     const auto currentCoords =
-      m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f::one());
+      uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f::one());
     const auto offsetChange = desriedCoords - currentCoords;
     m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
   }
@@ -396,7 +427,8 @@ void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 {
   const auto oldRotation = m_attributes.rotation();
   m_attributes = attributes;
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  mutableUVCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 bool BrushFace::setAttributes(const BrushFace& other)
@@ -475,15 +507,21 @@ std::optional<Color> BrushFace::resolvedColor() const
 
 void BrushFace::resetUVCoordSystemCache()
 {
-  if (m_uvCoordSystem)
-  {
-    m_uvCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
-  }
+  mutableUVCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
 }
 
 const UVCoordSystem& BrushFace::uvCoordSystem() const
 {
-  return *m_uvCoordSystem;
+  return std::visit(
+    [](const auto& uvCoordSystem) -> const UVCoordSystem& { return uvCoordSystem; },
+    m_uvCoordSystem);
+}
+
+UVCoordSystem& BrushFace::mutableUVCoordSystem()
+{
+  return std::visit(
+    [](auto& uvCoordSystem) -> UVCoordSystem& { return uvCoordSystem; },
+    m_uvCoordSystem);
 }
 
 const Material* BrushFace::material() const
@@ -518,58 +556,59 @@ bool BrushFace::setMaterial(Material* material)
 
 vm::vec3d BrushFace::uAxis() const
 {
-  return m_uvCoordSystem->uAxis();
+  return uvCoordSystem().uAxis();
 }
 
 vm::vec3d BrushFace::vAxis() const
 {
-  return m_uvCoordSystem->vAxis();
+  return uvCoordSystem().vAxis();
 }
 
 void BrushFace::resetUVAxes()
 {
-  m_uvCoordSystem->reset(m_boundary.normal);
+  mutableUVCoordSystem().reset(m_boundary.normal);
 }
 
 void BrushFace::resetUVAxesToParaxial()
 {
-  m_uvCoordSystem->resetToParaxial(m_boundary.normal, 0.0f);
+  mutableUVCoordSystem().resetToParaxial(m_boundary.normal, 0.0f);
 }
 
 void BrushFace::convertToParaxial()
 {
   auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+    uvCoordSystem().toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
 
   m_attributes = newAttributes;
-  m_uvCoordSystem = std::move(newUVCoordSystem);
+  m_uvCoordSystem = toUVCoordSystems(std::move(newUVCoordSystem));
 }
 
 void BrushFace::convertToParallel()
 {
   auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+    uvCoordSystem().toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
 
   m_attributes = newAttributes;
-  m_uvCoordSystem = std::move(newUVCoordSystem);
+  m_uvCoordSystem = toUVCoordSystems(std::move(newUVCoordSystem));
 }
 
 void BrushFace::moveUV(
   const vm::vec3d& up, const vm::vec3d& right, const vm::vec2f& offset)
 {
-  m_uvCoordSystem->translate(m_boundary.normal, up, right, offset, m_attributes);
+  mutableUVCoordSystem().translate(m_boundary.normal, up, right, offset, m_attributes);
 }
 
 void BrushFace::rotateUV(const float angle)
 {
   const auto oldRotation = m_attributes.rotation();
-  m_uvCoordSystem->rotate(m_boundary.normal, angle, m_attributes);
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  mutableUVCoordSystem().rotate(m_boundary.normal, angle, m_attributes);
+  mutableUVCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 void BrushFace::shearUV(const vm::vec2f& factors)
 {
-  m_uvCoordSystem->shear(m_boundary.normal, factors);
+  mutableUVCoordSystem().shear(m_boundary.normal, factors);
 }
 
 void BrushFace::flipUV(
@@ -577,7 +616,7 @@ void BrushFace::flipUV(
   const vm::vec3d& cameraRight,
   const vm::direction cameraRelativeFlipDirection)
 {
-  const auto texToWorld = m_uvCoordSystem->fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1});
+  const auto texToWorld = uvCoordSystem().fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1});
 
   const auto texUAxisInWorld = vm::normalize((texToWorld * vm::vec4d(1, 0, 0, 0)).xyz());
   const auto texVAxisInWorld = vm::normalize((texToWorld * vm::vec4d(0, 1, 0, 0)).xyz());
@@ -637,7 +676,7 @@ Result<void> BrushFace::transform(const vm::mat4x4d& transform, const bool lockA
   }
 
   return setPoints(m_points[0], m_points[1], m_points[2]) | kdl::transform([&]() {
-           m_uvCoordSystem->transform(
+           mutableUVCoordSystem().transform(
              oldBoundary,
              m_boundary,
              transform,
@@ -676,15 +715,15 @@ Result<void> BrushFace::updatePointsFromVertices()
                // Get the UV coordinates at the refPoint using the old face's attribs
                // and UV coordinage system
                const auto desriedCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
 
-               m_uvCoordSystem->setNormal(
+               mutableUVCoordSystem().setNormal(
                  oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
 
                // Adjust the offset on this face so that the UV coordinates at the
                // refPoint stay the same
                const auto currentCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
                const auto offsetChange = desriedCoords - currentCoords;
                m_attributes.setOffset(
                  correct(modOffset(m_attributes.offset() + offsetChange), 4));
@@ -695,7 +734,7 @@ Result<void> BrushFace::updatePointsFromVertices()
 vm::mat4x4d BrushFace::projectToBoundaryMatrix() const
 {
   const auto texZAxis =
-    m_uvCoordSystem->fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1}) * vm::vec3d{0, 0, 1};
+    uvCoordSystem().fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1}) * vm::vec3d{0, 0, 1};
   const auto worldToPlaneMatrix =
     vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
   const auto planeToWorldMatrix = vm::invert(worldToPlaneMatrix);
@@ -705,20 +744,20 @@ vm::mat4x4d BrushFace::projectToBoundaryMatrix() const
 vm::mat4x4d BrushFace::toUVCoordSystemMatrix(
   const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const
 {
-  return project ? vm::mat4x4d::zero_out<2>() * m_uvCoordSystem->toMatrix(offset, scale)
-                 : m_uvCoordSystem->toMatrix(offset, scale);
+  return project ? vm::mat4x4d::zero_out<2>() * uvCoordSystem().toMatrix(offset, scale)
+                 : uvCoordSystem().toMatrix(offset, scale);
 }
 
 vm::mat4x4d BrushFace::fromUVCoordSystemMatrix(
   const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const
 {
-  return project ? projectToBoundaryMatrix() * m_uvCoordSystem->fromMatrix(offset, scale)
-                 : m_uvCoordSystem->fromMatrix(offset, scale);
+  return project ? projectToBoundaryMatrix() * uvCoordSystem().fromMatrix(offset, scale)
+                 : uvCoordSystem().fromMatrix(offset, scale);
 }
 
 float BrushFace::measureUVAngle(const vm::vec2f& center, const vm::vec2f& point) const
 {
-  return m_uvCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+  return uvCoordSystem().measureAngle(m_attributes.rotation(), center, point);
 }
 
 size_t BrushFace::vertexCount() const
@@ -764,6 +803,11 @@ size_t BrushFace::lineNumber() const
   return m_lineNumber;
 }
 
+size_t BrushFace::lineCount() const
+{
+  return m_lineCount;
+}
+
 void BrushFace::setFilePosition(const size_t lineNumber, const size_t lineCount) const
 {
   m_lineNumber = lineNumber;
@@ -791,7 +835,7 @@ void BrushFace::deselect()
 
 vm::vec2f BrushFace::uvCoords(const vm::vec3d& point) const
 {
-  return m_uvCoordSystem->uvCoords(point, m_attributes, textureSize());
+  return uvCoordSystem().uvCoords(point, m_attributes, textureSize());
 }
 
 std::optional<double> BrushFace::intersectWithRay(const vm::ray3d& ray) const
@@ -24,6 +24,8 @@
 #include "mdl/AssetReference.h"
 #include "mdl/BrushFaceAttributes.h"
 #include "mdl/BrushGeometry.h"
+#include "mdl/ParallelUVCoordSystem.h"
+#include "mdl/ParaxialUVCoordSystem.h"
 #include "mdl/Tag.h"
 
 #include "kd/reflection_decl.h"
@@ -38,14 +40,12 @@
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <variant>
 #include <vector>
 
 namespace tb::mdl
 {
 class Material;
-class UVCoordSystem;
-class UVCoordSystemSnapshot;
-enum class WrapStyle;
 enum class MapFormat;
 
 class BrushFace : public Taggable
@@ -81,13 +81,19 @@ private:
   };
 
 public:
+  /**
+   * The UV coordinate system is stored inline so that copying a face does not require
+   * an allocation.
+   */
+  using UVCoordSystems = std::variant<ParaxialUVCoordSystem, ParallelUVCoordSystem>;
+
 private:
   BrushFace::Points m_points;
   vm::plane3d m_boundary;
   BrushFaceAttributes m_attributes;
 
   AssetReference<Material> m_materialReference;
-  std::unique_ptr<UVCoordSystem> m_uvCoordSystem;
+  UVCoordSystems m_uvCoordSystem;
   BrushFaceGeometry* m_geometry = nullptr;
 
   mutable size_t m_lineNumber = 0;
@@ -165,12 +171,25 @@ public:
     const BrushFaceAttributes& attributes,
     std::unique_ptr<UVCoordSystem> uvCoordSystem);
 
+  static Result<BrushFace> create(
+    const vm::vec3d& point0,
+    const vm::vec3d& point1,
+    const vm::vec3d& point2,
+    const BrushFaceAttributes& attributes,
+    UVCoordSystems uvCoordSystem);
+
   BrushFace(
     const BrushFace::Points& points,
     const vm::plane3d& boundary,
     BrushFaceAttributes attributes,
     std::unique_ptr<UVCoordSystem> uvCoordSystem);
 
+  BrushFace(
+    const BrushFace::Points& points,
+    const vm::plane3d& boundary,
+    BrushFaceAttributes attributes,
+    UVCoordSystems uvCoordSystem);
+
   static void sortFaces(std::vector<BrushFace>& faces);
 
   std::unique_ptr<UVCoordSystemSnapshot> takeUVCoordSystemSnapshot() const;
@@ -259,6 +278,7 @@ public:
   void setGeometry(BrushFaceGeometry* geometry);
 
   size_t lineNumber() const;
+  size_t lineCount() const;
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
 
   bool selected() const;
@@ -274,6 +294,8 @@ private:
     const vm::vec3d& point0, const vm::vec3d& point1, const vm::vec3d& point2);
   void correctPoints();
 
+  UVCoordSystem& mutableUVCoordSystem();
+
 public: // brush renderer
   /**
    * This is used to cache results of evaluating the BrushRenderer Filter.
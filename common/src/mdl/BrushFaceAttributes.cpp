@@ -52,7 +52,7 @@ kdl_reflect_impl(BrushFaceAttributes);
 
 const std::string& BrushFaceAttributes::materialName() const
 {
-  return m_materialName;
+  return m_materialName.str();
 }
 
 const vm::vec2f& BrushFaceAttributes::offset() const
@@ -134,9 +134,9 @@ bool BrushFaceAttributes::valid() const
 
 bool BrushFaceAttributes::setMaterialName(const std::string& materialName)
 {
-  if (materialName != m_materialName)
+  if (materialName != m_materialName.str())
   {
-    m_materialName = materialName;
+    m_materialName = kdl::interned_string{materialName};
     return true;
   }
   return false;
@@ -21,6 +21,7 @@
 
 #include "Color.h"
 
+#include "kd/interned_string.h"
 #include "kd/reflection_decl.h"
 
 #include "vm/vec.h"
@@ -39,7 +40,7 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  kdl::interned_string m_materialName;
 
   vm::vec2f m_offset = vm::vec2f{0, 0};
   vm::vec2f m_scale = vm::vec2f{1, 1};
@@ -43,16 +43,39 @@
 #include "vm/vec.h"
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+std::vector<double> makeFacePlanes(const Brush& brush)
+{
+  const auto faceCount = brush.faceCount();
+
+  auto result = std::vector<double>(4 * faceCount);
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    const auto& boundary = brush.face(i).boundary();
+    result[i] = boundary.normal.x();
+    result[faceCount + i] = boundary.normal.y();
+    result[2 * faceCount + i] = boundary.normal.z();
+    result[3 * faceCount + i] = boundary.distance;
+  }
+  return result;
+}
+
+} // namespace
+
 const HitType::Type BrushNode::BrushHitType = HitType::freeType();
 
 BrushNode::BrushNode(Brush brush)
   : m_brushRendererBrushCache(std::make_unique<render::BrushRendererBrushCache>())
   , m_brush(std::move(brush))
+  , m_facePlanes{makeFacePlanes(m_brush)}
 {
   clearSelectedFaces();
 }
@@ -97,6 +120,7 @@ Brush BrushNode::setBrush(Brush brush)
 
   using std::swap;
   swap(m_brush, brush);
+  m_facePlanes = makeFacePlanes(m_brush);
 
   updateSelectedFaceCount();
   invalidateIssues();
@@ -364,15 +388,76 @@ void BrushNode::doFindNodesContaining(const vm::vec3d& point, std::vector<Node*>
 std::optional<std::tuple<double, size_t>> BrushNode::findFaceHit(
   const vm::ray3d& ray) const
 {
-  if (vm::intersect_ray_bbox(ray, logicalBounds()))
+  if (!vm::intersect_ray_bbox(ray, logicalBounds()))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+    return std::nullopt;
+  }
+
+  const auto faceCount = m_brush.faceCount();
+  const auto* normalX = m_facePlanes.data();
+  const auto* normalY = normalX + faceCount;
+  const auto* normalZ = normalY + faceCount;
+  const auto* distance = normalZ + faceCount;
+
+  // The ray enters the brush through the front facing plane that it intersects last.
+  // Like vm::intersect_ray_plane, ignore planes that are almost parallel to the ray.
+  auto entryFaceIndex = faceCount;
+  auto entryDistance = std::numeric_limits<double>::lowest();
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    const auto cos = normalX[i] * ray.direction.x() + normalY[i] * ray.direction.y()
+                     + normalZ[i] * ray.direction.z();
+    const auto originDistance = normalX[i] * ray.origin.x() + normalY[i] * ray.origin.y()
+                                + normalZ[i] * ray.origin.z() - distance[i];
+    if (cos < -vm::Cd::almost_zero() && -originDistance / cos > entryDistance)
     {
-      const auto& face = m_brush.face(i);
-      if (const auto distance = face.intersectWithRay(ray))
-      {
-        return std::tuple{*distance, i};
-      }
+      entryFaceIndex = i;
+      entryDistance = -originDistance / cos;
+    }
+  }
+
+  if (entryFaceIndex == faceCount || entryDistance < -vm::Cd::almost_zero())
+  {
+    return std::nullopt;
+  }
+
+  // The ray misses the brush if the entry point is clearly outside of any other face
+  // plane, and it hits the entry face if the entry point is clearly inside all of them.
+  const auto entryPoint = vm::point_at_distance(ray, entryDistance);
+  auto maxEntryPointDistance = std::numeric_limits<double>::lowest();
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    const auto entryPointDistance = normalX[i] * entryPoint.x()
+                                    + normalY[i] * entryPoint.y()
+                                    + normalZ[i] * entryPoint.z() - distance[i];
+    if (i != entryFaceIndex)
+    {
+      maxEntryPointDistance = std::max(maxEntryPointDistance, entryPointDistance);
+    }
+  }
+
+  constexpr auto epsilon = vm::Cd::almost_zero() * 10.0;
+  if (maxEntryPointDistance > epsilon)
+  {
+    return std::nullopt;
+  }
+
+  if (maxEntryPointDistance < -epsilon)
+  {
+    const auto& boundary = m_brush.face(entryFaceIndex).boundary();
+    if (const auto hitDistance = vm::intersect_ray_plane(ray, boundary))
+    {
+      return std::tuple{*hitDistance, entryFaceIndex};
+    }
+  }
+
+  // The ray passes close to an edge or a vertex, so check every face.
+  for (size_t i = 0u; i < faceCount; ++i)
+  {
+    const auto& face = m_brush.face(i);
+    if (const auto hitDistance = face.intersectWithRay(ray))
+    {
+      return std::tuple{*hitDistance, i};
     }
   }
   return std::nullopt;
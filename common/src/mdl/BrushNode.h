@@ -64,6 +64,13 @@ private:
   Brush m_brush;               // must be destroyed before the brush renderer cache
   size_t m_selectedFaceCount = 0u;
 
+  /**
+   * The normals and distances of the brush's face boundaries, stored as four consecutive
+   * arrays of x, y and z components and distances. Used to intersect rays with the brush
+   * without visiting the face geometries.
+   */
+  std::vector<double> m_facePlanes;
+
 public:
   explicit BrushNode(Brush brush);
   ~BrushNode() override;
@@ -27,6 +27,8 @@
 
 #include "kd/reflection_impl.h"
 
+#include <algorithm>
+
 namespace tb::mdl
 {
 
@@ -75,6 +77,7 @@ DecalDefinition::DecalDefinition(const FileLocation& location)
 
 DecalDefinition::DecalDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_variableNames{m_expression.variableNames()}
 {
 }
 
@@ -85,12 +88,13 @@ void DecalDefinition::append(const DecalDefinition& other)
   auto cases =
     std::vector<el::ExpressionNode>{std::move(m_expression), other.m_expression};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_variableNames = m_expression.variableNames();
 }
 
 Result<DecalSpecification> DecalDefinition::decalSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
+  return el::withUntracedEvaluationContext(
     [&](auto& context) {
       return convertToDecal(context, m_expression.evaluate(context));
     },
@@ -102,6 +106,11 @@ Result<DecalSpecification> DecalDefinition::defaultDecalSpecification() const
   return decalSpecification(el::NullVariableStore{});
 }
 
+bool DecalDefinition::referencesVariable(const std::string& variableName) const
+{
+  return std::ranges::binary_search(m_variableNames, variableName);
+}
+
 kdl_reflect_impl(DecalDefinition);
 
 } // namespace tb::mdl
@@ -24,6 +24,9 @@
 
 #include "kd/reflection_decl.h"
 
+#include <string>
+#include <vector>
+
 namespace tb
 {
 struct FileLocation;
@@ -47,6 +50,7 @@ class DecalDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  std::vector<std::string> m_variableNames;
 
 public:
   DecalDefinition();
@@ -72,6 +76,13 @@ public:
    */
   Result<DecalSpecification> defaultDecalSpecification() const;
 
+  /**
+   * Indicates whether the decal expression references a variable with the given name.
+   * If it doesn't, then changing the value of that variable cannot change the result of
+   * evaluating the decal expression.
+   */
+  bool referencesVariable(const std::string& variableName) const;
+
   kdl_reflect_decl(DecalDefinition, m_expression);
 };
 
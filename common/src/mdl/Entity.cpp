@@ -96,6 +96,8 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -149,6 +151,8 @@ void Entity::setDefinition(const EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 const EntityModel* Entity::model() const
@@ -184,12 +188,20 @@ const EntityModelFrame* Entity::modelFrame() const
 
 Result<ModelSpecification> Entity::modelSpecification() const
 {
-  if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedModelSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = ModelSpecification{};
+    }
   }
-  return ModelSpecification{};
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4d& Entity::modelTransformation(
@@ -215,12 +227,20 @@ const vm::mat4x4d& Entity::modelTransformation(
 
 Result<DecalSpecification> Entity::decalSpecification() const
 {
-  if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition.decalSpecification(variableStore);
+    if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition.decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = DecalSpecification{};
+    }
   }
-  return DecalSpecification{};
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -234,11 +254,15 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 void Entity::addOrUpdateProperty(
   std::string key, std::string value, const bool defaultToProtected)
 {
+  invalidateCachedSpecifications(key);
+
   auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
@@ -283,6 +307,9 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
+
     oldIt->setKey(std::move(newKey));
 
     m_cachedClassname = std::nullopt;
@@ -299,6 +326,8 @@ void Entity::removeProperty(const std::string& key)
   {
     m_properties.erase(it);
 
+    invalidateCachedSpecifications(key);
+
     m_cachedClassname = std::nullopt;
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
@@ -318,6 +347,8 @@ void Entity::removeNumberedProperty(const std::string& prefix)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    m_cachedModelSpecification = std::nullopt;
+    m_cachedDecalSpecification = std::nullopt;
   }
 }
 
@@ -472,4 +503,19 @@ void Entity::transform(const vm::mat4x4d& transformation, const bool updateAngle
   }
 }
 
+void Entity::invalidateCachedSpecifications(const std::string& key)
+{
+  if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+  {
+    if (pointDefinition->modelDefinition.referencesVariable(key))
+    {
+      m_cachedModelSpecification = std::nullopt;
+    }
+    if (pointDefinition->decalDefinition.referencesVariable(key))
+    {
+      m_cachedDecalSpecification = std::nullopt;
+    }
+  }
+}
+
 } // namespace tb::mdl
@@ -22,7 +22,9 @@
 #include "Result.h"
 #include "el/Forward.h" // IWYU pragma: keep
 #include "mdl/AssetReference.h"
+#include "mdl/DecalDefinition.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/ModelSpecification.h"
 
 #include "kd/reflection_decl.h"
 
@@ -36,12 +38,10 @@
 
 namespace tb::mdl
 {
-struct DecalSpecification;
 class Entity;
 struct EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 
 enum class SetDefaultPropertyMode
 {
@@ -108,6 +108,14 @@ private:
   mutable std::optional<vm::mat4x4d> m_cachedRotation;
   mutable std::optional<vm::mat4x4d> m_cachedModelTransformation;
 
+  /**
+   * The model and decal specifications only depend on the properties that are referenced
+   * by the model and decal expressions, so changes to other properties do not invalidate
+   * them.
+   */
+  mutable std::optional<Result<ModelSpecification>> m_cachedModelSpecification;
+  mutable std::optional<Result<DecalSpecification>> m_cachedDecalSpecification;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -181,6 +189,9 @@ public: // property management
   std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
   void transform(const vm::mat4x4d& transformation, bool updateAngleProperty);
+
+private:
+  void invalidateCachedSpecifications(const std::string& key);
 };
 
 } // namespace tb::mdl
@@ -48,6 +48,7 @@ void GameFileSystem::initialize(
   Logger& logger)
 {
   unmountAll();
+  fs::Disk::clearDirectoryCache();
 
   addDefaultAssetPaths(config, logger);
 
@@ -134,23 +135,26 @@ Result<std::unique_ptr<fs::FileSystem>> createImageFileSystem(
 
   if (kdl::ci::str_is_equal(packageFormat, "idpak"))
   {
-    return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return fs::createImageFileSystem<fs::IdPakFileSystem>(std::move(file));
-           })
+    return fs::Disk::openFile(path, fs::FileMapping::Mapped)
+           | kdl::and_then([&](auto file) {
+               return fs::createImageFileSystem<fs::IdPakFileSystem>(std::move(file));
+             })
            | kdl::transform(setMetadataAndCast);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "dkpak"))
   {
-    return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return fs::createImageFileSystem<fs::DkPakFileSystem>(std::move(file));
-           })
+    return fs::Disk::openFile(path, fs::FileMapping::Mapped)
+           | kdl::and_then([&](auto file) {
+               return fs::createImageFileSystem<fs::DkPakFileSystem>(std::move(file));
+             })
            | kdl::transform(setMetadataAndCast);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
-    return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return fs::createImageFileSystem<fs::ZipFileSystem>(std::move(file));
-           })
+    return fs::Disk::openFile(path, fs::FileMapping::Mapped)
+           | kdl::and_then([&](auto file) {
+               return fs::createImageFileSystem<fs::ZipFileSystem>(std::move(file));
+             })
            | kdl::transform(setMetadataAndCast);
   }
   return Error{"Unknown package format: " + packageFormat};
@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IncrementalValidation.h"
+
+#include "mdl/Node.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/ranges/to.h"
+#include "kd/task_manager.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace tb::mdl
+{
+namespace
+{
+
+void collectNodes(Node& node, std::vector<Node*>& result)
+{
+  result.push_back(&node);
+  for (auto* child : node.children())
+  {
+    collectNodes(*child, result);
+  }
+}
+
+} // namespace
+
+IncrementalValidation::IncrementalValidation(
+  WorldNode& worldNode, kdl::task_manager& taskManager)
+  : m_validators{worldNode.registeredValidators()}
+  , m_taskManager{taskManager}
+{
+  m_nodes.reserve(worldNode.descendantCount() + 1);
+  collectNodes(worldNode, m_nodes);
+}
+
+size_t IncrementalValidation::nodeCount() const
+{
+  return m_nodes.size();
+}
+
+size_t IncrementalValidation::validatedNodeCount() const
+{
+  return m_nextNodeIndex;
+}
+
+bool IncrementalValidation::done() const
+{
+  return m_nextNodeIndex == m_nodes.size();
+}
+
+std::vector<const Issue*> IncrementalValidation::validateNext(const size_t maxNodeCount)
+{
+  const auto begin = m_nextNodeIndex;
+  const auto end = std::min(begin + maxNodeCount, m_nodes.size());
+  m_nextNodeIndex = end;
+
+  // bounds are computed lazily and some validators read the bounds of other nodes, so
+  // make sure that they are valid before validating in parallel
+  for (auto i = begin; i < end; ++i)
+  {
+    m_nodes[i]->logicalBounds();
+  }
+
+  auto issuesPerNode = std::vector<std::vector<const Issue*>>(end - begin);
+  m_taskManager.run_range(begin, end, 64, [&](const size_t i) {
+    issuesPerNode[i - begin] = m_nodes[i]->issues(m_validators);
+  });
+
+  return issuesPerNode | std::views::join | kdl::ranges::to<std::vector>();
+}
+
+} // namespace tb::mdl
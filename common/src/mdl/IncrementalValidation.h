@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb::mdl
+{
+class Issue;
+class Node;
+class Validator;
+class WorldNode;
+
+/**
+ * Validates the nodes of a world in batches.
+ *
+ * The nodes are collected in traversal order when the validation is created. Every call
+ * to validateNext validates the next batch of nodes in parallel using the given task
+ * manager and returns the issues of these nodes. Nodes whose issues are still valid are
+ * not validated again.
+ *
+ * A validation must be discarded whenever nodes are added to or removed from the world,
+ * since it keeps pointers to the nodes it collected.
+ */
+class IncrementalValidation
+{
+private:
+  std::vector<Node*> m_nodes;
+  std::vector<const Validator*> m_validators;
+  kdl::task_manager& m_taskManager;
+  size_t m_nextNodeIndex = 0;
+
+public:
+  IncrementalValidation(WorldNode& worldNode, kdl::task_manager& taskManager);
+
+  size_t nodeCount() const;
+  size_t validatedNodeCount() const;
+  bool done() const;
+
+  /**
+   * Validates up to the given number of nodes and returns their issues.
+   */
+  std::vector<const Issue*> validateNext(size_t maxNodeCount);
+};
+
+} // namespace tb::mdl
@@ -30,6 +30,7 @@
 
 #include "kd/overload.h"
 
+#include <atomic>
 #include <string>
 
 namespace tb::mdl
@@ -104,7 +105,8 @@ bool Issue::hidden() const
 
 size_t Issue::nextSeqId()
 {
-  static size_t seqId = 0;
+  // issues may be created by validators running in parallel
+  static auto seqId = std::atomic<size_t>{0};
   return seqId++;
 }
 
@@ -19,14 +19,18 @@
 
 #include "Map.h"
 
+#include "BufferedParserStatus.h"
 #include "Logger.h"
 #include "PreferenceManager.h"
+#include "Preferences.h"
 #include "SimpleParserStatus.h"
+#include "Uuid.h"
 #include "fs/DiskIO.h"
 #include "fs/PathInfo.h"
 #include "io/GameConfigParser.h"
 #include "io/LoadEntityDefinitions.h"
 #include "io/LoadMaterialCollections.h"
+#include "io/MapCache.h"
 #include "io/MapHeader.h"
 #include "io/NodeReader.h"
 #include "io/NodeWriter.h"
@@ -69,6 +73,8 @@
 #include "mdl/Map_Nodes.h"
 #include "mdl/Map_Selection.h"
 #include "mdl/Map_World.h"
+#include "mdl/Material.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/MaterialManager.h"
 #include "mdl/MissingClassnameValidator.h"
 #include "mdl/MissingDefinitionValidator.h"
@@ -108,9 +114,13 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <future>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 
@@ -119,41 +129,177 @@ namespace tb::mdl
 namespace
 {
 
+std::optional<io::MapCacheKey> makeMapCacheKey(
+  const std::filesystem::path& path, const std::string_view contents)
+{
+  auto error = std::error_code{};
+  const auto modificationTime = std::filesystem::last_write_time(path, error);
+  return !error ? std::optional{io::makeMapCacheKey(contents, modificationTime)}
+                : std::nullopt;
+}
+
+std::unique_ptr<WorldNode> loadMapCache(
+  const std::filesystem::path& path,
+  const io::MapCacheKey& key,
+  const std::vector<MapFormat>& possibleFormats,
+  const vm::bbox3d& worldBounds,
+  const EntityPropertyConfig& entityPropertyConfig,
+  ParserStatus& parserStatus,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  const auto cachePath = io::mapCachePath(path);
+  if (fs::Disk::pathInfo(cachePath) != fs::PathInfo::File)
+  {
+    return nullptr;
+  }
+
+  return fs::Disk::openFile(cachePath) | kdl::and_then([&](auto file) {
+           auto fileReader = file->reader().buffer();
+           return io::readMapCache(fileReader.stringView(), key, taskManager);
+         })
+         | kdl::and_then([&](auto mapCache) -> Result<std::unique_ptr<WorldNode>> {
+             if (
+               std::ranges::find(possibleFormats, mapCache.mapFormat)
+               == possibleFormats.end())
+             {
+               return Error{fmt::format(
+                 "Unexpected map format {}", formatName(mapCache.mapFormat))};
+             }
+
+             return io::WorldReader::fromObjectInfos(
+               mapCache.mapFormat,
+               std::move(mapCache.objectInfos),
+               worldBounds,
+               entityPropertyConfig,
+               parserStatus,
+               taskManager);
+           })
+         | kdl::transform_error([&](const auto& e) {
+             logger.debug() << fmt::format("Ignoring map cache {}: {}", cachePath, e.msg);
+             return std::unique_ptr<WorldNode>{};
+           })
+         | kdl::value();
+}
+
+/**
+ * Writes the map cache on a dedicated thread so that it doesn't delay loading the map.
+ *
+ * The write doesn't run on the task manager's workers because a thread waiting for a
+ * batch of tasks might otherwise pick it up. The cache is written to a temporary file
+ * first which then replaces the cache file, so that a concurrent load never reads a
+ * partially written cache. The returned future must be waited for before the logger is
+ * destroyed.
+ */
+std::future<void> writeMapCache(
+  const std::filesystem::path& path,
+  const io::MapCacheKey& key,
+  io::MapCacheWriter mapCacheWriter,
+  Logger& logger)
+{
+  if (!mapCacheWriter.complete())
+  {
+    return {};
+  }
+
+  return std::async(
+    std::launch::async,
+    [=, &logger, writer = std::move(mapCacheWriter)]() {
+      const auto cachePath = io::mapCachePath(path);
+      auto tempPath = cachePath;
+      tempPath += "." + generateUuid();
+
+      fs::Disk::withOutputStream(
+        tempPath,
+        std::ios::out | std::ios::binary,
+        [&](auto& stream) { writer.write(stream, key); })
+        | kdl::and_then([&]() { return fs::Disk::moveFile(tempPath, cachePath); })
+        | kdl::or_else([&](auto e) {
+            return fs::Disk::deleteFile(tempPath)
+                   | kdl::and_then([&](auto) { return Result<void>{std::move(e)}; });
+          })
+        | kdl::transform_error([&](const auto& e) {
+            logger.warn() << fmt::format(
+              "Could not write map cache {}: {}", cachePath, e.msg);
+          });
+    });
+}
+
 Result<std::unique_ptr<WorldNode>> loadMap(
   const GameConfig& config,
   const MapFormat mapFormat,
   const vm::bbox3d& worldBounds,
   const std::filesystem::path& path,
+  std::future<void>* mapCacheWrite,
   kdl::task_manager& taskManager,
   Logger& logger)
 {
   const auto entityPropertyConfig = EntityPropertyConfig{
     config.entityConfig.scaleExpression, config.entityConfig.setDefaultProperties};
 
-  auto parserStatus = SimpleParserStatus{logger};
+  auto simpleParserStatus = SimpleParserStatus{logger};
   return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
            auto fileReader = file->reader().buffer();
-           if (mapFormat == MapFormat::Unknown)
+
+           // If the format is unknown, try all formats listed in the game config
+           const auto possibleFormats =
+             mapFormat == MapFormat::Unknown
+               ? config.fileFormats | std::views::transform([](const auto& formatConfig) {
+                   return formatFromName(formatConfig.format);
+                 })
+                   | kdl::ranges::to<std::vector>()
+               : std::vector{mapFormat};
+
+           const auto mapCacheKey = mapCacheWrite
+                                      ? makeMapCacheKey(path, fileReader.stringView())
+                                      : std::nullopt;
+           if (mapCacheKey)
            {
-             // Try all formats listed in the game config
-             const auto possibleFormats =
-               config.fileFormats | std::views::transform([](const auto& formatConfig) {
-                 return formatFromName(formatConfig.format);
-               })
-               | kdl::ranges::to<std::vector>();
-
-             return io::WorldReader::tryRead(
-               fileReader.stringView(),
-               possibleFormats,
-               worldBounds,
-               entityPropertyConfig,
-               parserStatus,
-               taskManager);
+             if (
+               auto worldNode = loadMapCache(
+                 path,
+                 *mapCacheKey,
+                 possibleFormats,
+                 worldBounds,
+                 entityPropertyConfig,
+                 simpleParserStatus,
+                 taskManager,
+                 logger))
+             {
+               return Result<std::unique_ptr<WorldNode>>{std::move(worldNode)};
+             }
            }
 
-           auto worldReader =
-             io::WorldReader{fileReader.stringView(), mapFormat, entityPropertyConfig};
-           return worldReader.read(worldBounds, parserStatus, taskManager);
+           // The cache doesn't record parser messages, so a map is only cached if it
+           // was parsed without any
+           auto bufferedParserStatus = BufferedParserStatus{};
+           auto& parserStatus =
+             mapCacheKey ? static_cast<ParserStatus&>(bufferedParserStatus)
+                         : static_cast<ParserStatus&>(simpleParserStatus);
+
+           auto mapCacheWriter = io::MapCacheWriter{};
+           auto* mapCacheWriterPtr = mapCacheKey ? &mapCacheWriter : nullptr;
+
+           auto result =
+             mapFormat == MapFormat::Unknown
+               ? io::WorldReader::tryRead(
+                   fileReader.stringView(),
+                   possibleFormats,
+                   worldBounds,
+                   entityPropertyConfig,
+                   parserStatus,
+                   taskManager,
+                   mapCacheWriterPtr)
+               : io::WorldReader{fileReader.stringView(), mapFormat, entityPropertyConfig}
+                   .read(worldBounds, parserStatus, taskManager, mapCacheWriterPtr);
+
+           if (result && mapCacheKey && bufferedParserStatus.empty())
+           {
+             *mapCacheWrite =
+               writeMapCache(path, *mapCacheKey, std::move(mapCacheWriter), logger);
+           }
+           bufferedParserStatus.forwardTo(simpleParserStatus);
+           return result;
          });
 }
 
@@ -172,7 +318,7 @@ Result<std::unique_ptr<WorldNode>> createMap(
       && fs::Disk::pathInfo(initialMapFilePath) == fs::PathInfo::File)
     {
       return loadMap(
-        config, format, worldBounds, initialMapFilePath, taskManager, logger);
+        config, format, worldBounds, initialMapFilePath, nullptr, taskManager, logger);
     }
   }
 
@@ -457,6 +603,7 @@ Map::Map(kdl::task_manager& taskManager, Logger& logger)
   , m_grid{std::make_unique<Grid>(4)}
   , m_worldBounds{DefaultWorldBounds}
   , m_nodeIndex{std::make_unique<NodeIndex>()}
+  , m_materialIndex{std::make_unique<MaterialIndex>()}
   , m_entityLinkManager{std::make_unique<EntityLinkManager>(*m_nodeIndex)}
   , m_vertexHandles{std::make_unique<VertexHandleManager>()}
   , m_edgeHandles{std::make_unique<EdgeHandleManager>()}
@@ -471,6 +618,11 @@ Map::Map(kdl::task_manager& taskManager, Logger& logger)
 Map::~Map()
 {
   clearWorld();
+
+  if (m_mapCacheWrite.valid())
+  {
+    m_mapCacheWrite.wait();
+  }
 }
 
 Logger& Map::logger()
@@ -607,6 +759,11 @@ void Map::setCurrentMaterialName(const std::string& currentMaterialName)
   }
 }
 
+const MaterialIndex& Map::materialIndex() const
+{
+  return *m_materialIndex;
+}
+
 const EntityLinkManager& Map::entityLinkManager() const
 {
   return *m_entityLinkManager;
@@ -644,7 +801,14 @@ Result<void> Map::load(
 
   clear();
 
-  return loadMap(game->config(), mapFormat, worldBounds, path, m_taskManager, m_logger)
+  return loadMap(
+           game->config(),
+           mapFormat,
+           worldBounds,
+           path,
+           pref(Preferences::UseMapCache) ? &m_mapCacheWrite : nullptr,
+           m_taskManager,
+           m_logger)
          | kdl::transform([&](auto worldNode) {
              setWorld(worldBounds, std::move(worldNode), std::move(game), path);
              mapWasLoadedNotifier(*this);
@@ -741,6 +905,7 @@ void Map::clear()
     mapWillBeClearedNotifier(*this);
 
     m_nodeIndex->clear();
+    m_materialIndex->clear();
     m_entityLinkManager->clear();
     m_editorContext->reset();
     m_cachedSelection = std::nullopt;
@@ -1112,6 +1277,15 @@ void Map::clearMaterials()
 void Map::setMaterials()
 {
   m_world->accept(makeSetMaterialsVisitor(*m_materialManager));
+
+  // load the textures of the materials used by the map before all other textures
+  prioritizeResources(
+    m_materialManager->materials()
+    | std::views::filter([](const auto* material) { return material->usageCount() > 0; })
+    | std::views::transform(
+      [](const auto* material) { return material->textureResource().id(); })
+    | kdl::ranges::to<std::vector>());
+
   materialUsageCountsDidChangeNotifier();
 }
 
@@ -1212,6 +1386,7 @@ void Map::addToNodeIndex(const std::vector<Node*>& nodes, const bool recurse)
   for (auto* node : nodes)
   {
     m_nodeIndex->addNode(*node);
+    m_materialIndex->addNode(*node);
 
     if (recurse)
     {
@@ -1225,6 +1400,7 @@ void Map::removeFromNodeIndex(const std::vector<Node*>& nodes, const bool recurs
   for (auto* node : nodes)
   {
     m_nodeIndex->removeNode(*node);
+    m_materialIndex->removeNode(*node);
 
     if (recurse)
     {
@@ -1328,6 +1504,11 @@ bool Map::needsResourceProcessing() const
   return m_resourceManager->needsProcessing();
 }
 
+void Map::prioritizeResources(const std::vector<ResourceId>& resourceIds)
+{
+  m_resourceManager->prioritize(resourceIds);
+}
+
 bool Map::canUndoCommand() const
 {
   return m_commandProcessor->undoCommandName() != nullptr;
@@ -31,6 +31,7 @@
 #include "vm/bbox.h"
 
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -68,6 +69,7 @@ class Grid;
 class GroupNode;
 class Issue;
 class LayerNode;
+class MaterialIndex;
 class MaterialManager;
 class Node;
 class NodeIndex;
@@ -97,6 +99,9 @@ private:
 
   kdl::task_manager& m_taskManager;
 
+  // the most recent map cache write, which must finish before the logger goes away
+  std::future<void> m_mapCacheWrite;
+
   std::unique_ptr<ResourceManager> m_resourceManager;
   std::unique_ptr<EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<EntityModelManager> m_entityModelManager;
@@ -110,6 +115,7 @@ private:
   vm::bbox3d m_worldBounds;
   std::unique_ptr<WorldNode> m_world;
   std::unique_ptr<NodeIndex> m_nodeIndex;
+  std::unique_ptr<MaterialIndex> m_materialIndex;
   std::unique_ptr<EntityLinkManager> m_entityLinkManager;
 
   std::unique_ptr<VertexHandleManager> m_vertexHandles;
@@ -242,6 +248,8 @@ public: // misc
                        : std::vector<NodeType*>{};
   }
 
+  const MaterialIndex& materialIndex() const;
+
   const EntityLinkManager& entityLinkManager() const;
 
 public: // persistence
@@ -362,6 +370,11 @@ public: // resource processing
   void processResourcesAsync(const ProcessContext& processContext);
   bool needsResourceProcessing() const;
 
+  /**
+   * Loads the given resources before all other resources that are waiting to be loaded.
+   */
+  void prioritizeResources(const std::vector<ResourceId>& resourceIds);
+
 public: // command processing
   bool canUndoCommand() const;
   bool canRedoCommand() const;
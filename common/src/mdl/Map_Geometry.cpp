@@ -719,38 +719,47 @@ bool csgSubtract(Map& map)
                              })
                            | kdl::ranges::to<std::vector>();
 
+  const auto mapFormat = map.world()->mapFormat();
+  const auto& worldBounds = map.worldBounds();
+  const auto& materialName = map.currentMaterialName();
+
+  // In parallel, subtract the subtrahends from every minuend, dropping fragments that
+  // could not be turned into valid brushes
+  auto tasks = minuendNodes | std::views::transform([&](const auto& minuendNode) {
+                 return std::function{[&]() {
+                   return minuendNode->brush().subtract(
+                            mapFormat, worldBounds, materialName, subtrahends)
+                          | std::views::filter(
+                            [](const auto& r) { return r | kdl::is_success(); })
+                          | kdl::views::as_rvalue | kdl::fold;
+                 }};
+               });
+
   auto toAdd = std::map<Node*, std::vector<Node*>>{};
   auto toRemove =
     std::vector<Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
-  return minuendNodes | std::views::transform([&](auto* minuendNode) {
-           const auto& minuend = minuendNode->brush();
-           auto currentSubtractionResults = minuend.subtract(
-             map.world()->mapFormat(),
-             map.worldBounds(),
-             map.currentMaterialName(),
-             subtrahends);
-
-           return currentSubtractionResults
-                  | std::views::filter([](const auto r) { return r | kdl::is_success(); })
-                  | kdl::views::as_rvalue | kdl::fold
-                  | kdl::transform([&](auto currentBrushes) {
-                      if (!currentBrushes.empty())
-                      {
-                        auto resultNodes = currentBrushes | kdl::views::as_rvalue
-                                           | std::views::transform([&](auto b) {
-                                               return new BrushNode{std::move(b)};
-                                             })
-                                           | kdl::ranges::to<std::vector>();
-                        auto& toAddForParent = toAdd[minuendNode->parent()];
-                        toAddForParent = kdl::vec_concat(
-                          std::move(toAddForParent), std::move(resultNodes));
-                      }
-
-                      toRemove.push_back(minuendNode);
-                    });
-         })
-         | kdl::fold | kdl::transform([&]() {
+  return map.taskManager().run_tasks_and_wait(tasks) | kdl::fold
+         | kdl::transform([&](auto subtractionResults) {
+             for (size_t i = 0; i < minuendNodes.size(); ++i)
+             {
+               auto* minuendNode = minuendNodes[i];
+               auto& currentBrushes = subtractionResults[i];
+               if (!currentBrushes.empty())
+               {
+                 auto resultNodes = currentBrushes | kdl::views::as_rvalue
+                                    | std::views::transform([&](auto b) {
+                                        return new BrushNode{std::move(b)};
+                                      })
+                                    | kdl::ranges::to<std::vector>();
+                 auto& toAddForParent = toAdd[minuendNode->parent()];
+                 toAddForParent =
+                   kdl::vec_concat(std::move(toAddForParent), std::move(resultNodes));
+               }
+
+               toRemove.push_back(minuendNode);
+             }
+
              deselectAll(map);
              const auto added = addNodes(map, toAdd);
              removeNodes(map, toRemove);
@@ -821,40 +830,60 @@ bool csgHollow(Map& map)
     return false;
   }
 
+  const auto mapFormat = map.world()->mapFormat();
+  const auto& worldBounds = map.worldBounds();
+  const auto& materialName = map.currentMaterialName();
+  const auto thickness = double(map.grid().actualSize());
+
+  struct HollowResult
+  {
+    // a brush counts as hollowed once it could be shrunk, even if the subtraction fails
+    bool shrunk;
+    Result<std::vector<Brush>> fragments;
+  };
+
+  // In parallel, shrink every brush and subtract the shrunken brush from the original
+  const auto hollow = [&](const Brush& originalBrush) {
+    auto shrunkenBrush = originalBrush;
+    auto shrunk = false;
+    auto fragments =
+      shrunkenBrush.expand(worldBounds, -thickness, true) | kdl::and_then([&]() {
+        shrunk = true;
+        return originalBrush.subtract(mapFormat, worldBounds, materialName, shrunkenBrush)
+               | kdl::fold;
+      });
+    return HollowResult{shrunk, std::move(fragments)};
+  };
+
+  auto tasks = brushNodes | std::views::transform([&](const auto& brushNode) {
+                 return std::function{[&]() { return hollow(brushNode->brush()); }};
+               });
+
+  auto hollowResults = map.taskManager().run_tasks_and_wait(tasks);
+
   bool didHollowAnything = false;
   auto toAdd = std::map<Node*, std::vector<Node*>>{};
   auto toRemove = std::vector<Node*>{};
 
-  for (auto* brushNode : brushNodes)
+  for (size_t i = 0; i < brushNodes.size(); ++i)
   {
-    const auto& originalBrush = brushNode->brush();
+    auto* brushNode = brushNodes[i];
+    auto& [shrunk, fragmentsResult] = hollowResults[i];
+    didHollowAnything = didHollowAnything || shrunk;
+
+    std::move(fragmentsResult) | kdl::transform([&](auto fragments) {
+      auto fragmentNodes = fragments | kdl::views::as_rvalue
+                           | std::views::transform([](auto&& b) {
+                               return new BrushNode{std::forward<decltype(b)>(b)};
+                             })
+                           | kdl::ranges::to<std::vector>();
 
-    auto shrunkenBrush = originalBrush;
-    shrunkenBrush.expand(map.worldBounds(), -double(map.grid().actualSize()), true)
-      | kdl::and_then([&]() {
-          didHollowAnything = true;
-
-          return originalBrush.subtract(
-                   map.world()->mapFormat(),
-                   map.worldBounds(),
-                   map.currentMaterialName(),
-                   shrunkenBrush)
-                 | kdl::fold | kdl::transform([&](auto fragments) {
-                     auto fragmentNodes =
-                       fragments | kdl::views::as_rvalue
-                       | std::views::transform([](auto&& b) {
-                           return new BrushNode{std::forward<decltype(b)>(b)};
-                         })
-                       | kdl::ranges::to<std::vector>();
-
-                     auto& toAddForParent = toAdd[brushNode->parent()];
-                     toAddForParent =
-                       kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
-                     toRemove.push_back(brushNode);
-                   });
-        })
-      | kdl::transform_error(
-        [&](const auto& e) { map.logger().error() << "Could not hollow brush: " << e; });
+      auto& toAddForParent = toAdd[brushNode->parent()];
+      toAddForParent = kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
+      toRemove.push_back(brushNode);
+    }) | kdl::transform_error([&](const auto& e) {
+      map.logger().error() << "Could not hollow brush: " << e;
+    });
   }
 
   if (!didHollowAnything)
@@ -30,6 +30,7 @@
 #include "mdl/Map.h"
 #include "mdl/Map_Groups.h"
 #include "mdl/Map_Nodes.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "mdl/PatchNode.h"
@@ -43,11 +44,96 @@
 
 #include <algorithm>
 #include <ranges>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+/**
+ * Sorts the given face handles in the order in which a traversal of the given root node
+ * visits their brush nodes, and the faces of each brush node by their index.
+ *
+ * Only the ancestors of the given brush nodes are traversed.
+ */
+void sortInTraversalOrder(const Node& root, std::vector<BrushFaceHandle>& handles)
+{
+  auto ancestors = std::unordered_set<const Node*>{};
+  for (const auto& handle : handles)
+  {
+    for (const Node* node = handle.node(); node && ancestors.insert(node).second;
+         node = node->parent())
+    {
+    }
+  }
+
+  auto positions = std::unordered_map<const Node*, size_t>{};
+  auto stack = std::vector<const Node*>{&root};
+  while (!stack.empty())
+  {
+    const auto* node = stack.back();
+    stack.pop_back();
+    positions.emplace(node, positions.size());
+
+    const auto& children = node->children();
+    for (auto it = children.rbegin(); it != children.rend(); ++it)
+    {
+      if (ancestors.contains(*it))
+      {
+        stack.push_back(*it);
+      }
+    }
+  }
+
+  std::ranges::sort(handles, [&](const auto& lhs, const auto& rhs) {
+    const auto lhsPosition = positions.at(lhs.node());
+    const auto rhsPosition = positions.at(rhs.node());
+    return lhsPosition != rhsPosition ? lhsPosition < rhsPosition
+                                      : lhs.faceIndex() < rhs.faceIndex();
+  });
+}
+
+/**
+ * Returns the selectable brush faces with the given material in traversal order. The
+ * material index doesn't preserve any order, so the faces are sorted to keep selecting
+ * them deterministic.
+ */
+std::vector<BrushFaceHandle> findSelectableBrushFacesWithMaterial(
+  Map& map, const std::string_view materialName)
+{
+  auto handles = map.materialIndex().findBrushFaces(materialName)
+                 | std::views::filter([&](const auto& h) {
+                     return h.face().attributes().materialName() == materialName
+                            && map.editorContext().selectable(*h.node(), h.face());
+                   })
+                 | kdl::ranges::to<std::vector>();
+
+  sortInTraversalOrder(*map.world(), handles);
+  return handles;
+}
+
+/**
+ * Returns the node that must be selected to select the given brush node, which is either
+ * the selectable group that contains it or the brush node itself. Returns nullptr if
+ * neither is selectable.
+ */
+Node* findNodeToSelect(Map& map, BrushNode& brushNode)
+{
+  for (auto* groupNode = findContainingGroup(&brushNode); groupNode;
+       groupNode = findContainingGroup(groupNode))
+  {
+    if (map.editorContext().selectable(*groupNode))
+    {
+      return groupNode;
+    }
+  }
+  return map.editorContext().selectable(brushNode) ? &brushNode : nullptr;
+}
+
+} // namespace
 
 void selectAllNodes(Map& map)
 {
@@ -89,10 +175,11 @@ void selectSiblingNodes(Map& map)
 
 void selectTouchingNodes(Map& map, const bool del)
 {
-  auto nodes = collectTouchingNodes({map.world()}, map.selection().brushes)
-               | std::views::filter(
-                 [&](const auto* node) { return map.editorContext().selectable(*node); })
-               | kdl::ranges::to<std::vector>();
+  auto nodes =
+    collectTouchingNodes(*map.world(), map.selection().brushes, map.taskManager())
+    | std::views::filter(
+      [&](const auto* node) { return map.editorContext().selectable(*node); })
+    | kdl::ranges::to<std::vector>();
 
   auto transaction = Transaction{map, "Select Touching"};
   if (del)
@@ -155,9 +242,10 @@ void selectTouchingNodes(Map& map, const vm::axis::type cameraAxis, const bool d
 
         const auto nodesToSelect =
           collectContainedNodes(
-            {map.world()}, tallBrushes | std::views::transform([](const auto& b) {
-                             return b.get();
-                           }) | kdl::ranges::to<std::vector>())
+            *map.world(),
+            tallBrushes | std::views::transform([](const auto& b) { return b.get(); })
+              | kdl::ranges::to<std::vector>(),
+            map.taskManager())
           | std::views::filter(
             [&](const auto* node) { return map.editorContext().selectable(*node); })
           | kdl::ranges::to<std::vector>();
@@ -172,10 +260,11 @@ void selectTouchingNodes(Map& map, const vm::axis::type cameraAxis, const bool d
 
 void selectContainedNodes(Map& map, const bool del)
 {
-  auto nodes = collectContainedNodes({map.world()}, map.selection().brushes)
-               | std::views::filter(
-                 [&](const auto* node) { return map.editorContext().selectable(*node); })
-               | kdl::ranges::to<std::vector>();
+  auto nodes =
+    collectContainedNodes(*map.world(), map.selection().brushes, map.taskManager())
+    | std::views::filter(
+      [&](const auto* node) { return map.editorContext().selectable(*node); })
+    | kdl::ranges::to<std::vector>();
 
   auto transaction = Transaction{map, "Select Inside"};
   if (del)
@@ -258,15 +347,16 @@ void selectNodesWithFilePosition(Map& map, const std::vector<size_t>& positions)
 
 void selectBrushesWithMaterial(Map& map, const std::string_view materialName)
 {
-  const auto brushes =
-    collectSelectableNodes(std::vector<Node*>{map.world()}, map.editorContext())
-    | std::views::filter([&](const auto& node) {
-        return std::ranges::any_of(
-          collectSelectableBrushFaces({node}, map.editorContext()), [&](const auto& h) {
-            return h.face().attributes().materialName() == materialName;
-          });
-      })
-    | kdl::ranges::to<std::vector>();
+  auto brushes = std::vector<Node*>{};
+  auto visited = std::unordered_set<Node*>{};
+  for (const auto& handle : findSelectableBrushFacesWithMaterial(map, materialName))
+  {
+    auto* node = findNodeToSelect(map, *handle.node());
+    if (node && visited.insert(node).second)
+    {
+      brushes.push_back(node);
+    }
+  }
 
   auto transaction = Transaction{map, "Select Brushes with Material"};
   deselectAll(map);
@@ -378,11 +468,7 @@ void selectBrushFaces(Map& map, const std::vector<BrushFaceHandle>& handles)
 
 void selectBrushFacesWithMaterial(Map& map, const std::string_view materialName)
 {
-  const auto faces =
-    collectSelectableBrushFaces(std::vector<Node*>{map.world()}, map.editorContext())
-    | std::views::filter(
-      [&](const auto& h) { return h.face().attributes().materialName() == materialName; })
-    | kdl::ranges::to<std::vector>();
+  const auto faces = findSelectableBrushFacesWithMaterial(map, materialName);
 
   auto transaction = Transaction{map, "Select Faces with Material"};
   deselectAll(map);
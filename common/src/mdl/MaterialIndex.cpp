@@ -0,0 +1,137 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MaterialIndex.h"
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Material.h"
+#include "mdl/Node.h"
+
+#include "kd/overload.h"
+#include "kd/string_format.h"
+
+#include <unordered_set>
+
+namespace tb::mdl
+{
+
+MaterialIndex::MaterialIndex() = default;
+
+MaterialIndex::~MaterialIndex() = default;
+
+void MaterialIndex::addNode(Node& node)
+{
+  node.accept(kdl::overload(
+    [](WorldNode*) {},
+    [](LayerNode*) {},
+    [](GroupNode*) {},
+    [](EntityNode*) {},
+    [&](BrushNode* brushNode) {
+      const auto& faces = brushNode->brush().faces();
+      for (size_t i = 0; i < faces.size(); ++i)
+      {
+        const auto key = kdl::str_to_lower(faces[i].attributes().materialName());
+        m_index[key][brushNode].push_back(i);
+      }
+    },
+    [](PatchNode*) {}));
+}
+
+void MaterialIndex::removeNode(Node& node)
+{
+  node.accept(kdl::overload(
+    [](WorldNode*) {},
+    [](LayerNode*) {},
+    [](GroupNode*) {},
+    [](EntityNode*) {},
+    [&](BrushNode* brushNode) {
+      for (const auto& face : brushNode->brush().faces())
+      {
+        const auto key = kdl::str_to_lower(face.attributes().materialName());
+        if (auto it = m_index.find(key); it != m_index.end())
+        {
+          it->second.erase(brushNode);
+          if (it->second.empty())
+          {
+            m_index.erase(it);
+          }
+        }
+      }
+    },
+    [](PatchNode*) {}));
+}
+
+void MaterialIndex::clear()
+{
+  m_index.clear();
+}
+
+std::vector<BrushFaceHandle> MaterialIndex::findBrushFaces(
+  const std::string_view materialName) const
+{
+  auto result = std::vector<BrushFaceHandle>{};
+  if (const auto it = m_index.find(kdl::str_to_lower(materialName)); it != m_index.end())
+  {
+    for (const auto& [brushNode, faceIndices] : it->second)
+    {
+      for (const auto faceIndex : faceIndices)
+      {
+        result.emplace_back(brushNode, faceIndex);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<BrushNode*> MaterialIndex::findBrushNodes(
+  const std::string_view materialName) const
+{
+  auto result = std::vector<BrushNode*>{};
+  if (const auto it = m_index.find(kdl::str_to_lower(materialName)); it != m_index.end())
+  {
+    result.reserve(it->second.size());
+    for (const auto& [brushNode, faceIndices] : it->second)
+    {
+      result.push_back(brushNode);
+    }
+  }
+  return result;
+}
+
+std::vector<BrushNode*> MaterialIndex::findBrushNodes(
+  const std::vector<const Material*>& materials) const
+{
+  auto result = std::vector<BrushNode*>{};
+  auto visited = std::unordered_set<BrushNode*>{};
+  for (const auto* material : materials)
+  {
+    for (auto* brushNode : findBrushNodes(material->name()))
+    {
+      if (visited.insert(brushNode).second)
+      {
+        result.push_back(brushNode);
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/BrushFaceHandle.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class BrushNode;
+class Material;
+class Node;
+
+/**
+ * Maps material names to the brush faces that reference them.
+ *
+ * Material names are compared case insensitively, just like the material manager does
+ * when it binds materials to brush faces. Therefore, the faces that are bound to a
+ * material are exactly the faces that are indexed under its name, and rebinding materials
+ * does not require updating the index.
+ *
+ * The index must be updated whenever a brush node is added or removed, and whenever the
+ * contents of a brush node change. A brush node must be removed before its contents
+ * change and added again afterwards.
+ */
+class MaterialIndex
+{
+private:
+  using FaceIndices = std::vector<size_t>;
+  using BrushFaces = std::unordered_map<BrushNode*, FaceIndices>;
+
+  std::unordered_map<std::string, BrushFaces> m_index;
+
+public:
+  MaterialIndex();
+  ~MaterialIndex();
+
+  void addNode(Node& node);
+  void removeNode(Node& node);
+
+  void clear();
+
+  /**
+   * Returns handles of all brush faces that reference the given material name. The name
+   * is compared case insensitively.
+   */
+  std::vector<BrushFaceHandle> findBrushFaces(std::string_view materialName) const;
+
+  /**
+   * Returns all brush nodes that have at least one face that references the given
+   * material name. The name is compared case insensitively.
+   */
+  std::vector<BrushNode*> findBrushNodes(std::string_view materialName) const;
+
+  /**
+   * Returns all brush nodes that have at least one face that is bound to any of the given
+   * materials. Every brush node is returned only once.
+   */
+  std::vector<BrushNode*> findBrushNodes(
+    const std::vector<const Material*>& materials) const;
+};
+
+} // namespace tb::mdl
@@ -34,6 +34,8 @@
 #include "vm/scalar.h"
 #include "vm/vec_io.h"
 
+#include <algorithm>
+
 namespace tb::mdl
 {
 namespace
@@ -153,6 +155,7 @@ ModelDefinition::ModelDefinition(const FileLocation& location)
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_variableNames{m_expression.variableNames()}
 {
 }
 
@@ -162,12 +165,13 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_variableNames = m_expression.variableNames();
 }
 
 Result<ModelSpecification> ModelDefinition::modelSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
+  return el::withUntracedEvaluationContext(
     [&](auto& context) {
       return convertToModel(context, m_expression.evaluate(context));
     },
@@ -185,7 +189,7 @@ Result<vm::vec3d> ModelDefinition::scale(
   const el::VariableStore& variableStore,
   const std::optional<el::ExpressionNode>& defaultScaleExpression) const
 {
-  return el::withEvaluationContext(
+  return el::withUntracedEvaluationContext(
     [&](auto& context) {
       const auto value = m_expression.evaluate(context);
 
@@ -230,6 +234,11 @@ Result<vm::vec3d> ModelDefinition::scale(
     variableStore);
 }
 
+bool ModelDefinition::referencesVariable(const std::string& variableName) const
+{
+  return std::ranges::binary_search(m_variableNames, variableName);
+}
+
 kdl_reflect_impl(ModelDefinition);
 
 vm::vec3d safeGetModelScale(
@@ -28,6 +28,8 @@
 #include "vm/vec.h"
 
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace tb
 {
@@ -48,6 +50,7 @@ class ModelDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  std::vector<std::string> m_variableNames;
 
 public:
   ModelDefinition();
@@ -74,6 +77,13 @@ public:
    */
   Result<ModelSpecification> defaultModelSpecification() const;
 
+  /**
+   * Indicates whether the model expression references a variable with the given name.
+   * If it doesn't, then changing the value of that variable cannot change the result of
+   * evaluating the model expression.
+   */
+  bool referencesVariable(const std::string& variableName) const;
+
   /**
    * Evaluates the model expression using the given variable store to interpolate
    * variables, and returns the scale value configured for the model, if any. If the model
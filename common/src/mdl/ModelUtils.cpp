@@ -24,12 +24,18 @@
 #include "mdl/EditorContext.h"
 #include "mdl/HitAdapter.h"
 #include "mdl/NodeQueries.h"
+#include "mdl/WorldNode.h"
+#include "octree.h"
 
 #include "kd/contracts.h"
 #include "kd/ranges/to.h"
 #include "kd/stable_remove_duplicates.h"
+#include "kd/task_manager.h"
 #include "kd/vector_utils.h"
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -227,33 +233,14 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
 }
 
 /**
- * Recursively collect brushes and entities from the given vector of node trees such that
- * the returned nodes match the given predicate. A matching brush is only returned if it
- * isn't in the given vector brushes. A node matches the given predicate if there is a
- * brush in the given vector of brushes such that the predicate evaluates to true for that
- * pair of node and brush.
- *
- * The given predicate must be a function that maps a node and a brush to true or false.
+ * Recursively visit the brushes and entities from the given vector of node trees that
+ * are candidates for matching against the given vector of brushes. Closed groups are
+ * visited as a whole, and the given brushes themselves are never visited.
  */
-template <typename P>
-static std::vector<Node*> collectMatchingNodes(
-  const std::vector<Node*>& nodes,
-  const std::vector<BrushNode*>& brushes,
-  const P& predicate)
+template <typename F>
+static void visitMatchCandidates(
+  const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes, const F& visit)
 {
-  auto result = std::vector<Node*>{};
-
-  const auto collectIfMatching = [&](auto* node) {
-    for (const auto* brush : brushes)
-    {
-      if (predicate(node, brush))
-      {
-        result.push_back(node);
-        return;
-      }
-    }
-  };
-
   for (auto* node : nodes)
   {
     node->accept(kdl::overload(
@@ -266,7 +253,7 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(group);
+          visit(group);
         }
       },
       [&](auto&& thisLambda, EntityNode* entity) {
@@ -276,22 +263,53 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(entity);
+          visit(entity);
         }
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
         if (!kdl::vec_contains(brushes, brush))
         {
-          collectIfMatching(brush);
+          visit(brush);
         }
       },
       [&](PatchNode* patch) {
         // if `patch` is one of the search query nodes, don't count it as touching
-        collectIfMatching(patch);
+        visit(patch);
       }));
   }
+}
+
+template <typename P>
+static bool matchesAny(
+  const Node* node, const std::vector<BrushNode*>& brushes, const P& predicate)
+{
+  return std::ranges::any_of(
+    brushes, [&](const auto* brush) { return predicate(node, brush); });
+}
 
+/**
+ * Recursively collect brushes and entities from the given vector of node trees such that
+ * the returned nodes match the given predicate. A matching brush is only returned if it
+ * isn't in the given vector brushes. A node matches the given predicate if there is a
+ * brush in the given vector of brushes such that the predicate evaluates to true for that
+ * pair of node and brush.
+ *
+ * The given predicate must be a function that maps a node and a brush to true or false.
+ */
+template <typename P>
+static std::vector<Node*> collectMatchingNodes(
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  const P& predicate)
+{
+  auto result = std::vector<Node*>{};
+  visitMatchCandidates(nodes, brushes, [&](auto* node) {
+    if (matchesAny(node, brushes, predicate))
+    {
+      result.push_back(node);
+    }
+  });
   return result;
 }
 
@@ -311,6 +329,116 @@ std::vector<Node*> collectContainedNodes(
   });
 }
 
+/**
+ * Like collectMatchingNodes above, but searches the given world and takes the candidates
+ * from its spatial index instead of traversing it. A candidate is the same node that
+ * visitMatchCandidates would visit: a node in the spatial index whose bounds intersect
+ * the bounds of any of the given brushes, unless it is contained in a closed group, or a
+ * closed group that isn't contained in another closed group and whose bounds intersect
+ * the bounds of any of the given brushes. Groups are not part of the spatial index, so
+ * they are taken from the world's set of groups.
+ *
+ * The predicate is evaluated for the candidates in parallel. The result contains the
+ * same nodes as that of collectMatchingNodes, but in no particular order.
+ */
+template <typename P>
+static std::vector<Node*> collectMatchingNodes(
+  WorldNode& worldNode,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager,
+  const P& predicate)
+{
+  const auto isIndexedCandidate = [&](Node* node) {
+    return findOutermostClosedGroup(node) == nullptr
+           && node->accept(kdl::overload(
+             [](const WorldNode*) { return false; },
+             [](const LayerNode*) { return false; },
+             [](const GroupNode*) { return false; },
+             [](const EntityNode* entity) { return !entity->hasChildren(); },
+             [&](BrushNode* brush) { return !kdl::vec_contains(brushes, brush); },
+             [](const PatchNode*) { return true; }));
+  };
+
+  const auto intersectsAnyBrush = [&](const Node* node) {
+    return std::ranges::any_of(brushes, [&](const auto* brush) {
+      return brush->logicalBounds().intersects(node->logicalBounds());
+    });
+  };
+
+  auto candidates = std::vector<Node*>{};
+  auto visited = std::unordered_set<Node*>{};
+  for (const auto* brush : brushes)
+  {
+    // the node tree returns every node stored in a tree node that intersects the given
+    // bounds, so many of them may not be near the brush at all; checking their bounds
+    // here also computes lazily computed bounds before the predicate reads them
+    // concurrently
+    const auto& bounds = brush->logicalBounds();
+    for (auto* node : worldNode.nodeTree().find_intersectors(bounds))
+    {
+      if (
+        bounds.intersects(node->logicalBounds()) && visited.insert(node).second
+        && isIndexedCandidate(node))
+      {
+        candidates.push_back(node);
+      }
+    }
+  }
+
+  auto groupCandidates = std::vector<GroupNode*>{};
+  for (auto* group : worldNode.groupNodes())
+  {
+    if (
+      group->closed() && findOutermostClosedGroup(group) == nullptr
+      && intersectsAnyBrush(group))
+    {
+      groupCandidates.push_back(group);
+    }
+  }
+
+  // the set of groups is unordered, so sort the groups to keep the result deterministic
+  std::ranges::sort(
+    groupCandidates, {}, [](const auto* group) { return group->persistentId(); });
+  candidates.insert(candidates.end(), groupCandidates.begin(), groupCandidates.end());
+
+  auto matches = std::vector<char>(candidates.size(), 0);
+  taskManager.run_range(0, candidates.size(), 64, [&](const auto i) {
+    matches[i] = matchesAny(candidates[i], brushes, predicate) ? 1 : 0;
+  });
+
+  auto result = std::vector<Node*>{};
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (matches[i])
+    {
+      result.push_back(candidates[i]);
+    }
+  }
+  return result;
+}
+
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager)
+{
+  return collectMatchingNodes(
+    worldNode, brushes, taskManager, [](const auto* node, const auto* brush) {
+      return brush->intersects(node);
+    });
+}
+
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager)
+{
+  return collectMatchingNodes(
+    worldNode, brushes, taskManager, [](const auto* node, const auto* brush) {
+      return brush->contains(node);
+    });
+}
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes)
 {
   return collectNodesAndDescendants(
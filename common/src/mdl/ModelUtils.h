@@ -27,6 +27,11 @@
 #include <map>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 
@@ -36,6 +41,7 @@ class GroupNode;
 class BrushNode;
 class EntityNode;
 class LayerNode;
+class WorldNode;
 class EditorContext;
 
 HitType::Type nodeHitType();
@@ -84,6 +90,21 @@ std::vector<Node*> collectTouchingNodes(
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 
+/**
+ * Like the functions above, but searches the entire given world. The nodes to test are
+ * taken from the world's spatial index and its set of groups, so only the nodes near the
+ * given brushes are visited. They are tested in parallel using the given task manager.
+ * The result contains the same nodes as the functions above, but in no particular order.
+ */
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager);
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager);
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
 std::vector<Node*> collectSelectableNodes(
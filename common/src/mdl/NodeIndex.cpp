@@ -34,6 +34,7 @@
 #include "mdl/WorldNode.h"
 
 #include "kd/compact_trie.h"
+#include "kd/trigram_index.h"
 #include "kd/vector_utils.h"
 
 namespace tb::mdl
@@ -72,6 +73,12 @@ void withPatchNode(PatchNode& patchNode, const F& f)
   f(patchNode.patch().materialName());
 }
 
+bool startsWithWildcard(const std::string_view pattern)
+{
+  return !pattern.empty()
+         && (pattern.front() == '*' || pattern.front() == '?' || pattern.front() == '%');
+}
+
 } // namespace
 
 NodeIndex::NodeIndex()
@@ -85,6 +92,10 @@ void NodeIndex::addNode(Node& node)
 {
   const auto addToIndex = [&](const std::string_view key) {
     m_index->insert(key, &node);
+    if (m_substringIndex)
+    {
+      m_substringIndex->insert(key, &node);
+    }
   };
 
   node.accept(kdl::overload(
@@ -100,6 +111,10 @@ void NodeIndex::removeNode(Node& node)
 {
   const auto removeFromIndex = [&](const std::string_view key) {
     m_index->remove(key, &node);
+    if (m_substringIndex)
+    {
+      m_substringIndex->remove(key, &node);
+    }
   };
 
   node.accept(kdl::overload(
@@ -114,13 +129,33 @@ void NodeIndex::removeNode(Node& node)
 void NodeIndex::clear()
 {
   m_index = std::make_unique<NodeStringIndex>();
+  m_substringIndex.reset();
 }
 
 std::vector<Node*> NodeIndex::doFindNodes(const std::string_view pattern) const
 {
   auto result = std::vector<Node*>{};
-  m_index->find_matches(pattern, std::back_inserter(result));
+  if (startsWithWildcard(pattern) && NodeSubstringIndex::has_trigrams(pattern))
+  {
+    substringIndex().find_matches(pattern, std::back_inserter(result));
+  }
+  else
+  {
+    m_index->find_matches(pattern, std::back_inserter(result));
+  }
   return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
+const NodeSubstringIndex& NodeIndex::substringIndex() const
+{
+  if (!m_substringIndex)
+  {
+    m_substringIndex = std::make_unique<NodeSubstringIndex>();
+    m_index->for_each_value([&](const std::string_view key, Node* node) {
+      m_substringIndex->insert(key, node);
+    });
+  }
+  return *m_substringIndex;
+}
+
 } // namespace tb::mdl
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "kd/compact_trie_forward.h"
+#include "kd/trigram_index_forward.h"
 
 #include <memory>
 #include <string_view>
@@ -30,12 +31,23 @@ namespace tb::mdl
 class Node;
 
 using NodeStringIndex = kdl::compact_trie<Node*>;
+using NodeSubstringIndex = kdl::trigram_index<Node*>;
 
 class NodeIndex
 {
 private:
   std::unique_ptr<NodeStringIndex> m_index;
 
+  /**
+   * Indexes the same strings as m_index. It is used for patterns that start with a
+   * wildcard, such as `*substring*`, because the trie must visit most of its nodes to
+   * match such patterns.
+   *
+   * Building it is costly, so it is built from m_index when the first such pattern is
+   * searched for, and kept up to date from then on. It is null until then.
+   */
+  mutable std::unique_ptr<NodeSubstringIndex> m_substringIndex;
+
 public:
   NodeIndex();
   ~NodeIndex();
@@ -68,6 +80,7 @@ public:
 
 private:
   std::vector<Node*> doFindNodes(std::string_view pattern) const;
+  const NodeSubstringIndex& substringIndex() const;
 };
 
 } // namespace tb::mdl
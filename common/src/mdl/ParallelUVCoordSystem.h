@@ -133,7 +133,7 @@ private:
   float computeRotationAngle(
     const vm::plane3d& oldBoundary, const vm::mat4x4d& transformation) const;
 
-  deleteCopyAndMove(ParallelUVCoordSystem);
+  defineCopyAndMove(ParallelUVCoordSystem);
 };
 
 } // namespace tb::mdl
@@ -114,7 +114,7 @@ private:
     const vm::vec3d& newNormal,
     const BrushFaceAttributes& attribs) override;
 
-  deleteCopyAndMove(ParaxialUVCoordSystem);
+  defineCopyAndMove(ParaxialUVCoordSystem);
 };
 
 } // namespace tb::mdl
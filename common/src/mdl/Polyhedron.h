@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "kd/fixed_size_pool.h"
 #include "kd/intrusive_circular_list.h"
 
 #include "vm/bbox.h"
@@ -75,10 +76,13 @@ struct Polyhedron_GetVertexLink
  * The leaving half edge of a vertex is any half edge that has the vertex as its origin.
  * It is used to find the incident faces of a vertex.
  *
+ * Like edges, half edges and faces, vertices are created and destroyed in large numbers
+ * when building brush geometry, so they are allocated from a kdl::fixed_size_pool.
+ *
  * The payload of a vertex can be used to store user data.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Vertex
+class Polyhedron_Vertex : public kdl::pool_allocated<Polyhedron_Vertex<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -233,7 +237,7 @@ struct Polyhedron_GetEdgeLink
  * intrusive circular list.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Edge
+class Polyhedron_Edge : public kdl::pool_allocated<Polyhedron_Edge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -549,7 +553,7 @@ struct Polyhedron_GetHalfEdgeLink
  * boundary the half edge belongs to.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_HalfEdge
+class Polyhedron_HalfEdge : public kdl::pool_allocated<Polyhedron_HalfEdge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -774,7 +778,7 @@ struct Polyhedron_GetFaceLink
  * intrusive circular list.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Face
+class Polyhedron_Face : public kdl::pool_allocated<Polyhedron_Face<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -1452,6 +1456,58 @@ public: // Accessors
    */
   std::optional<FaceHit> pickFace(const vm::ray<T, 3>& ray) const;
 
+  /**
+   * A flat representation of the topology of a polyhedron. It can be stored and used to
+   * restore the polyhedron without computing it again.
+   */
+  struct Topology
+  {
+    /**
+     * The vertex positions, in the order of the vertices of the polyhedron.
+     */
+    std::vector<vm::vec<T, 3>> vertexPositions;
+
+    /**
+     * The face planes, in the order of the faces of the polyhedron.
+     */
+    std::vector<vm::plane<T, 3>> facePlanes;
+
+    /**
+     * The number of half edges in the boundary of each face.
+     */
+    std::vector<std::size_t> faceSizes;
+
+    /**
+     * The index of the origin vertex of every half edge. The half edges are stored face
+     * by face in the order of the face boundaries.
+     */
+    std::vector<std::size_t> halfEdgeOrigins;
+
+    /**
+     * The indices of the two half edges of every edge, in the order of the edges of the
+     * polyhedron.
+     */
+    std::vector<std::size_t> edgeHalfEdges;
+
+    friend bool operator==(const Topology&, const Topology&) = default;
+  };
+
+  /**
+   * Returns the topology of this polyhedron.
+   *
+   * This polyhedron must be a closed polyhedron.
+   */
+  Topology topology() const;
+
+  /**
+   * Restores a polyhedron from the given topology. The vertices, edges, faces and half
+   * edges of the restored polyhedron are in the same order as those of the polyhedron
+   * the topology was taken from. The payloads are set to their default values.
+   *
+   * Returns nullopt if the given topology is inconsistent.
+   */
+  static std::optional<Polyhedron> fromTopology(const Topology& topology);
+
 public: // General purpose methods
   /**
    * Checks whether this polyhedron has a vertex with the given position, up to the given
@@ -28,6 +28,8 @@
 #include "vm/plane.h"
 #include "vm/util.h"
 
+#include <array>
+
 namespace tb::mdl
 {
 
@@ -146,36 +148,58 @@ std::optional<typename Polyhedron<T, FP, VP>::ClipResult::FailureReason> Polyhed
   FP,
   VP>::checkIntersects(const vm::plane<T, 3>& plane) const
 {
-  std::size_t above = 0u;
-  std::size_t below = 0u;
-  std::size_t inside = 0u;
-
-  for (const Vertex* currentVertex : m_vertices)
+  // The vertices are classified in blocks. The positions of a block are copied into one
+  // array per component so that the compiler can compute the distances with vector
+  // instructions and count the results without branching. The distances are computed
+  // exactly like vm::plane::point_distance does, so the results are identical to calling
+  // vm::plane::point_status for every vertex.
+  constexpr auto BlockSize = std::size_t(16);
+  const auto epsilon = vm::constants<T>::point_status_epsilon();
+  const auto& normal = plane.normal;
+
+  auto xs = std::array<T, BlockSize>{};
+  auto ys = std::array<T, BlockSize>{};
+  auto zs = std::array<T, BlockSize>{};
+
+  auto anyAbove = false;
+  auto anyBelow = false;
+
+  // the result only depends on whether any vertex is above or below the plane, so we can
+  // stop as soon as we have found both
+  auto it = m_vertices.begin();
+  const auto end = m_vertices.end();
+  while (it != end && !(anyAbove && anyBelow))
   {
-    const auto status = plane.point_status(
-      currentVertex->position(), vm::constants<T>::point_status_epsilon());
-    switch (status)
+    auto count = std::size_t(0);
+    for (; it != end && count < BlockSize; ++it, ++count)
     {
-    case vm::plane_status::above:
-      ++above;
-      break;
-    case vm::plane_status::below:
-      ++below;
-      break;
-    case vm::plane_status::inside:
-      ++inside;
-      break;
-      switchDefault();
+      const auto& position = (*it)->position();
+      xs[count] = position.x();
+      ys[count] = position.y();
+      zs[count] = position.z();
     }
-  }
 
-  contract_assert(above + below + inside == m_vertices.size());
+    auto above = std::size_t(0);
+    auto below = std::size_t(0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto distance = static_cast<T>(0.0);
+      distance += xs[i] * normal.x();
+      distance += ys[i] * normal.y();
+      distance += zs[i] * normal.z();
+      distance -= plane.distance;
+
+      above += distance > epsilon ? 1u : 0u;
+      below += distance < -epsilon ? 1u : 0u;
+    }
+
+    anyAbove = anyAbove || above > 0;
+    anyBelow = anyBelow || below > 0;
+  }
 
-  return below + inside == m_vertices.size()
-           ? std::optional{ClipResult::FailureReason::Unchanged}
-         : above + inside == m_vertices.size()
-           ? std::optional{ClipResult::FailureReason::Empty}
-           : std::nullopt;
+  return !anyAbove  ? std::optional{ClipResult::FailureReason::Unchanged}
+         : !anyBelow ? std::optional{ClipResult::FailureReason::Empty}
+                     : std::nullopt;
 }
 
 template <typename T, typename FP, typename VP>
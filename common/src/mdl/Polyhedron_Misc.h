@@ -33,9 +33,12 @@
 #include "vm/vec_io.h" // IWYU pragma: keep
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <sstream>
-#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -217,21 +220,28 @@ template <typename T, typename FP, typename VP>
 class Polyhedron<T, FP, VP>::Copy
 {
 private:
-  using VertexMap = std::unordered_map<const Vertex*, Vertex*>;
-  using VertexMapEntry = typename VertexMap::value_type;
-
-  using HalfEdgeMap = std::unordered_map<const HalfEdge*, HalfEdge*>;
-  using HalfEdgeMapEntry = typename HalfEdgeMap::value_type;
+  /**
+   * Maps originals to their copies. The entries are sorted by original so that copies can
+   * be found by binary search. Unlike a hash map, this doesn't allocate per entry.
+   */
+  template <typename E>
+  using CopyMap = std::vector<std::pair<const E*, E*>>;
 
   /**
    * Maps the vertices of the original to their copies.
    */
-  VertexMap m_vertexMap;
+  CopyMap<Vertex> m_vertexMap;
+
+  /**
+   * Maps the half edges of the original to their copies. Half edges that don't belong to
+   * any face are appended after the sorted entries.
+   */
+  CopyMap<HalfEdge> m_halfEdgeMap;
 
   /**
-   * Maps the half edges of the original to their copies.
+   * The number of sorted entries at the start of m_halfEdgeMap.
    */
-  HalfEdgeMap m_halfEdgeMap;
+  std::size_t m_sortedHalfEdgeCount = 0;
 
   /**
    * The copied vertices.
@@ -280,26 +290,51 @@ public:
   }
 
 private:
+  template <typename E>
+  static E* findCopy(
+    const typename CopyMap<E>::const_iterator first,
+    const typename CopyMap<E>::const_iterator last,
+    const E* original)
+  {
+    const auto it = std::lower_bound(
+      first, last, original, [](const auto& entry, const E* key) {
+        return std::less<const E*>{}(entry.first, key);
+      });
+    return it != last && it->first == original ? it->second : nullptr;
+  }
+
+  template <typename E>
+  static void sortCopyMap(CopyMap<E>& map)
+  {
+    std::sort(map.begin(), map.end(), [](const auto& lhs, const auto& rhs) {
+      return std::less<const E*>{}(lhs.first, rhs.first);
+    });
+  }
+
   void copyVertices(const VertexList& originalVertices, const CopyCallback& callback)
   {
+    m_vertexMap.reserve(originalVertices.size());
     for (const auto* currentVertex : originalVertices)
     {
       auto* copy = new Vertex{currentVertex->position()};
       callback.vertexWasCopied(currentVertex, copy);
-      assert(m_vertexMap.count(currentVertex) == 0u);
 
-      m_vertexMap.emplace(currentVertex, copy);
+      m_vertexMap.emplace_back(currentVertex, copy);
       m_vertices.push_back(copy);
-      currentVertex = currentVertex->next();
     }
+    sortCopyMap(m_vertexMap);
   }
 
   void copyFaces(const FaceList& originalFaces, const CopyCallback& callback)
   {
+    // every half edge usually belongs to a face, and there are two per vertex on average
+    m_halfEdgeMap.reserve(2 * m_vertexMap.size());
     for (const auto* currentFace : originalFaces)
     {
       copyFace(currentFace, callback);
     }
+    sortCopyMap(m_halfEdgeMap);
+    m_sortedHalfEdgeCount = m_halfEdgeMap.size();
   }
 
   void copyFace(const Face* originalFace, const CopyCallback& callback)
@@ -321,17 +356,16 @@ private:
 
     auto* myOrigin = findVertex(originalOrigin);
     auto* copy = new HalfEdge{myOrigin};
-    assert(m_halfEdgeMap.count(original) == 0u);
-    m_halfEdgeMap.emplace(original, copy);
+    m_halfEdgeMap.emplace_back(original, copy);
     return copy;
   }
 
   Vertex* findVertex(const Vertex* original)
   {
-    auto it = m_vertexMap.find(original);
-    contract_assert(it != m_vertexMap.end());
+    auto* copy = findCopy(m_vertexMap.begin(), m_vertexMap.end(), original);
+    contract_assert(copy != nullptr);
 
-    return it->second;
+    return copy;
   }
 
   void copyEdges(const EdgeList& originalEdges)
@@ -356,7 +390,19 @@ private:
 
   HalfEdge* findOrCopyHalfEdge(const HalfEdge* original)
   {
-    if (auto it = m_halfEdgeMap.find(original); it != m_halfEdgeMap.end())
+    const auto sortedEnd =
+      std::next(m_halfEdgeMap.begin(), std::ptrdiff_t(m_sortedHalfEdgeCount));
+    if (auto* copy = findCopy(m_halfEdgeMap.cbegin(), sortedEnd, original))
+    {
+      return copy;
+    }
+
+    // only half edges that don't belong to a face are in the unsorted part
+    if (const auto it = std::find_if(
+          sortedEnd, m_halfEdgeMap.end(), [&](const auto& entry) {
+            return entry.first == original;
+          });
+        it != m_halfEdgeMap.end())
     {
       return it->second;
     }
@@ -364,7 +410,7 @@ private:
     const auto* originalOrigin = original->origin();
     auto* myOrigin = findVertex(originalOrigin);
     auto* copy = new HalfEdge{myOrigin};
-    m_halfEdgeMap.emplace(original, copy);
+    m_halfEdgeMap.emplace_back(original, copy);
     return copy;
   }
 
@@ -566,6 +612,169 @@ std::optional<typename Polyhedron<T, FP, VP>::FaceHit> Polyhedron<T, FP, VP>::pi
   return std::nullopt;
 }
 
+template <typename T, typename FP, typename VP>
+typename Polyhedron<T, FP, VP>::Topology Polyhedron<T, FP, VP>::topology() const
+{
+  contract_pre(polyhedron());
+  contract_pre(closed());
+
+  // maps elements to their indices, sorted by element for binary search
+  auto vertexIndices = std::vector<std::pair<const Vertex*, std::size_t>>{};
+  auto halfEdgeIndices = std::vector<std::pair<const HalfEdge*, std::size_t>>{};
+  const auto indexOf = [](const auto& indices, const auto* element) {
+    const auto it = std::lower_bound(
+      indices.begin(), indices.end(), element, [](const auto& entry, const auto* key) {
+        return std::less<>{}(entry.first, key);
+      });
+    contract_assert(it != indices.end() && it->first == element);
+    return it->second;
+  };
+
+  auto result = Topology{};
+
+  result.vertexPositions.reserve(vertexCount());
+  vertexIndices.reserve(vertexCount());
+  for (const auto* vertex : m_vertices)
+  {
+    vertexIndices.emplace_back(vertex, result.vertexPositions.size());
+    result.vertexPositions.push_back(vertex->position());
+  }
+  std::ranges::sort(vertexIndices);
+
+  result.facePlanes.reserve(faceCount());
+  result.faceSizes.reserve(faceCount());
+  result.halfEdgeOrigins.reserve(2 * edgeCount());
+  halfEdgeIndices.reserve(2 * edgeCount());
+  for (const auto* face : m_faces)
+  {
+    result.facePlanes.push_back(face->plane());
+    result.faceSizes.push_back(face->boundary().size());
+    for (const auto* halfEdge : face->boundary())
+    {
+      halfEdgeIndices.emplace_back(halfEdge, result.halfEdgeOrigins.size());
+      result.halfEdgeOrigins.push_back(indexOf(vertexIndices, halfEdge->origin()));
+    }
+  }
+  std::ranges::sort(halfEdgeIndices);
+
+  result.edgeHalfEdges.reserve(2 * edgeCount());
+  for (const auto* edge : m_edges)
+  {
+    result.edgeHalfEdges.push_back(indexOf(halfEdgeIndices, edge->firstEdge()));
+    result.edgeHalfEdges.push_back(indexOf(halfEdgeIndices, edge->secondEdge()));
+  }
+
+  return result;
+}
+
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::fromTopology(
+  const Topology& topology)
+{
+  const auto vertexCount = topology.vertexPositions.size();
+  const auto faceCount = topology.facePlanes.size();
+  const auto halfEdgeCount = topology.halfEdgeOrigins.size();
+
+  if (
+    faceCount < 4 || topology.faceSizes.size() != faceCount
+    || topology.edgeHalfEdges.size() != halfEdgeCount || halfEdgeCount % 2 != 0
+    || vertexCount + faceCount != halfEdgeCount / 2 + 2)
+  {
+    return std::nullopt;
+  }
+
+  // validate everything before allocating any elements
+  auto nextHalfEdge = std::vector<std::size_t>{};
+  nextHalfEdge.reserve(halfEdgeCount);
+  for (const auto faceSize : topology.faceSizes)
+  {
+    const auto first = nextHalfEdge.size();
+    if (faceSize < 3 || faceSize > halfEdgeCount - first)
+    {
+      return std::nullopt;
+    }
+    for (std::size_t i = 0; i < faceSize; ++i)
+    {
+      nextHalfEdge.push_back(first + (i + 1) % faceSize);
+    }
+  }
+  if (nextHalfEdge.size() != halfEdgeCount)
+  {
+    return std::nullopt;
+  }
+
+  auto vertexUsed = std::vector<bool>(vertexCount, false);
+  for (const auto origin : topology.halfEdgeOrigins)
+  {
+    if (origin >= vertexCount)
+    {
+      return std::nullopt;
+    }
+    vertexUsed[origin] = true;
+  }
+  if (std::ranges::find(vertexUsed, false) != vertexUsed.end())
+  {
+    return std::nullopt;
+  }
+
+  auto halfEdgeUsed = std::vector<bool>(halfEdgeCount, false);
+  for (std::size_t i = 0; i < halfEdgeCount; i += 2)
+  {
+    const auto first = topology.edgeHalfEdges[i];
+    const auto second = topology.edgeHalfEdges[i + 1];
+    if (
+      first >= halfEdgeCount || second >= halfEdgeCount || halfEdgeUsed[first]
+      || halfEdgeUsed[second] || first == second
+      || topology.halfEdgeOrigins[first]
+           != topology.halfEdgeOrigins[nextHalfEdge[second]]
+      || topology.halfEdgeOrigins[second]
+           != topology.halfEdgeOrigins[nextHalfEdge[first]])
+    {
+      return std::nullopt;
+    }
+    halfEdgeUsed[first] = true;
+    halfEdgeUsed[second] = true;
+  }
+
+  auto result = Polyhedron{};
+
+  auto vertices = std::vector<Vertex*>{};
+  vertices.reserve(vertexCount);
+  for (const auto& position : topology.vertexPositions)
+  {
+    auto* vertex = new Vertex{position};
+    vertices.push_back(vertex);
+    result.m_vertices.push_back(vertex);
+  }
+
+  auto halfEdges = std::vector<HalfEdge*>{};
+  halfEdges.reserve(halfEdgeCount);
+  for (std::size_t i = 0; i < faceCount; ++i)
+  {
+    auto boundary = HalfEdgeList{};
+    for (std::size_t j = 0; j < topology.faceSizes[i]; ++j)
+    {
+      auto* halfEdge = new HalfEdge{vertices[topology.halfEdgeOrigins[halfEdges.size()]]};
+      halfEdges.push_back(halfEdge);
+      boundary.push_back(halfEdge);
+    }
+    result.m_faces.push_back(new Face{std::move(boundary), topology.facePlanes[i]});
+  }
+
+  for (std::size_t i = 0; i < halfEdgeCount; i += 2)
+  {
+    result.m_edges.push_back(new Edge{
+      halfEdges[topology.edgeHalfEdges[i]], halfEdges[topology.edgeHalfEdges[i + 1]]});
+  }
+
+  result.updateBounds();
+
+  // too expensive for contract_post
+  assert(result.checkInvariant());
+
+  return result;
+}
+
 template <typename T, typename FP, typename VP>
 bool Polyhedron<T, FP, VP>::hasVertex(
   const vm::vec<T, 3>& position, const T epsilon) const
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "mdl/Resource.h"
 
 #include "kd/ranges/to.h"
@@ -26,8 +27,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <list>
 #include <memory>
 #include <ranges>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -42,6 +46,8 @@ public:
 
   virtual long useCount() const = 0;
 
+  virtual bool isUnloaded() const = 0;
+  virtual bool isLoading() const = 0;
   virtual bool isDropped() const = 0;
   virtual bool needsProcessing() const = 0;
 
@@ -65,6 +71,8 @@ public:
 
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
+  bool isUnloaded() const override { return m_resource->isUnloaded(); }
+  bool isLoading() const override { return m_resource->isLoading(); }
   bool isDropped() const override { return m_resource->isDropped(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
   void drop() override { m_resource->drop(); }
@@ -82,23 +90,70 @@ public:
   };
 };
 
+/**
+ * Drives the resources added to it through their states.
+ *
+ * Unloaded resources wait in a queue until they are loaded. The queue is processed in
+ * the order in which the resources were added unless some of them are prioritized. Only
+ * a limited number of resources are loading at any time, so that prioritized resources
+ * don't have to wait for all other resources to load.
+ *
+ * A resource is dropped and removed once the manager holds the only reference to it.
+ * Loading, uploading and dropping resources are checked for this whenever they are
+ * processed, all other resources are checked a few at a time.
+ *
+ * The cost of processing depends on the number of loading, uploading and dropping
+ * resources, but not on the total number of resources. Checking whether processing is
+ * needed takes constant time; released resources are considered until the checks have
+ * gone through all resources without finding one.
+ */
 class ResourceManager
 {
 private:
-  std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
+  enum class Stage
+  {
+    Pending,
+    Loading,
+    Active,
+    Idle,
+  };
+
+  struct Entry
+  {
+    std::unique_ptr<ResourceWrapperBase> resourceWrapper;
+    Stage stage;
+    std::list<Entry*>::iterator pendingPosition;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static constexpr size_t MaxLoadingResources = 1024;
+  static constexpr size_t ReleaseChecksPerProcess = 1024;
+
+  EntryList m_entries;
+  std::unordered_map<ResourceId, EntryList::iterator> m_entriesById;
+
+  std::list<Entry*> m_pending;
+  std::vector<Entry*> m_active;
+  size_t m_loadingCount = 0;
+  EntryList::iterator m_nextReleaseCheck = m_entries.end();
+  size_t m_releaseChecksWithoutRelease = 0;
 
 public:
+  ResourceManager() = default;
+
+  deleteCopyAndMove(ResourceManager);
+
   bool needsProcessing() const
   {
-    return std::ranges::any_of(m_resources, [](const auto& resourceWrapper) {
-      return resourceWrapper->useCount() == 1 || resourceWrapper->needsProcessing();
-    });
+    return !m_pending.empty() || !m_active.empty()
+           || m_releaseChecksWithoutRelease < m_entries.size();
   }
 
   std::vector<const ResourceWrapperBase*> resources() const
   {
-    return m_resources | std::views::transform([](const auto& resourceWrapper) {
-             return static_cast<const ResourceWrapperBase*>(resourceWrapper.get());
+    return m_entries | std::views::transform([](const auto& entry) {
+             return static_cast<const ResourceWrapperBase*>(entry.resourceWrapper.get());
            })
            | kdl::ranges::to<std::vector>();
   }
@@ -106,8 +161,33 @@ public:
   template <typename ResourceT>
   void addResource(std::shared_ptr<Resource<ResourceT>> resource)
   {
-    m_resources.push_back(
-      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
+    auto resourceWrapper =
+      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource));
+    const auto id = resourceWrapper->id();
+
+    m_entries.push_back(Entry{std::move(resourceWrapper), Stage::Idle, {}});
+    m_entriesById.emplace(id, std::prev(m_entries.end()));
+    updateStage(m_entries.back());
+  }
+
+  /**
+   * Moves the given resources to the front of the loading queue in the given order. The
+   * given resources are loaded before all other resources that are waiting to be loaded.
+   * Resources that are not waiting to be loaded are ignored.
+   */
+  void prioritize(const std::vector<ResourceId>& resourceIds)
+  {
+    for (auto it = resourceIds.rbegin(); it != resourceIds.rend(); ++it)
+    {
+      if (const auto entryIt = m_entriesById.find(*it); entryIt != m_entriesById.end())
+      {
+        auto& entry = *entryIt->second;
+        if (entry.stage == Stage::Pending)
+        {
+          m_pending.splice(m_pending.begin(), m_pending, entry.pendingPosition);
+        }
+      }
+    }
   }
 
   std::vector<ResourceId> process(
@@ -124,29 +204,135 @@ public:
 
     auto result = std::vector<ResourceId>{};
 
-    for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
+    // advance the loading, uploading and dropping resources
+    const auto active = std::exchange(m_active, {});
+    for (auto it = active.begin(); it != active.end(); ++it)
     {
-      auto& resourceWrapper = *it;
-      if (resourceWrapper->useCount() == 1 && !resourceWrapper->isDropped())
+      if (!checkTimeout())
       {
-        resourceWrapper->drop();
+        m_active.insert(m_active.end(), it, active.end());
+        return result;
       }
+      processEntry(**it, taskRunner, processContext, result);
+    }
+
+    // start loading the pending resources in order
+    while (!m_pending.empty() && m_loadingCount < MaxLoadingResources && checkTimeout())
+    {
+      processEntry(*m_pending.front(), taskRunner, processContext, result);
+    }
 
-      if (resourceWrapper->needsProcessing())
+    // find the remaining resources that were released by their owners
+    for (size_t i = 0;
+         i < std::min(ReleaseChecksPerProcess, m_entries.size()) && checkTimeout();
+         ++i)
+    {
+      if (m_nextReleaseCheck == m_entries.end())
       {
-        if (resourceWrapper->process(taskRunner, processContext))
-        {
-          result.push_back(resourceWrapper->id());
-        }
+        m_nextReleaseCheck = m_entries.begin();
       }
 
-      it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
-             ? m_resources.erase(it)
-             : std::next(it);
+      auto& entry = *m_nextReleaseCheck++;
+      if (
+        (entry.stage == Stage::Pending || entry.stage == Stage::Idle)
+        && entry.resourceWrapper->useCount() == 1)
+      {
+        m_releaseChecksWithoutRelease = 0;
+        processEntry(entry, taskRunner, processContext, result);
+      }
+      else
+      {
+        ++m_releaseChecksWithoutRelease;
+      }
     }
 
     return result;
   }
+
+private:
+  void processEntry(
+    Entry& entry,
+    TaskRunner taskRunner,
+    const ProcessContext& processContext,
+    std::vector<ResourceId>& result)
+  {
+    auto& resourceWrapper = *entry.resourceWrapper;
+    if (resourceWrapper.useCount() == 1 && !resourceWrapper.isDropped())
+    {
+      resourceWrapper.drop();
+    }
+
+    if (resourceWrapper.needsProcessing())
+    {
+      if (resourceWrapper.process(taskRunner, processContext))
+      {
+        result.push_back(resourceWrapper.id());
+      }
+    }
+
+    if (resourceWrapper.useCount() == 1 && resourceWrapper.isDropped())
+    {
+      removeEntry(entry);
+    }
+    else
+    {
+      updateStage(entry);
+    }
+  }
+
+  void updateStage(Entry& entry)
+  {
+    const auto& resourceWrapper = *entry.resourceWrapper;
+    const auto stage = resourceWrapper.isUnloaded()        ? Stage::Pending
+                       : resourceWrapper.isLoading()       ? Stage::Loading
+                       : resourceWrapper.needsProcessing() ? Stage::Active
+                                                           : Stage::Idle;
+
+    if (entry.stage == Stage::Pending && stage != Stage::Pending)
+    {
+      m_pending.erase(entry.pendingPosition);
+    }
+    else if (stage == Stage::Pending && entry.stage != Stage::Pending)
+    {
+      entry.pendingPosition = m_pending.insert(m_pending.end(), &entry);
+    }
+
+    if (entry.stage == Stage::Loading && stage != Stage::Loading)
+    {
+      --m_loadingCount;
+    }
+    else if (stage == Stage::Loading && entry.stage != Stage::Loading)
+    {
+      ++m_loadingCount;
+    }
+
+    if (stage == Stage::Loading || stage == Stage::Active)
+    {
+      m_active.push_back(&entry);
+    }
+
+    entry.stage = stage;
+  }
+
+  void removeEntry(Entry& entry)
+  {
+    if (entry.stage == Stage::Pending)
+    {
+      m_pending.erase(entry.pendingPosition);
+    }
+    else if (entry.stage == Stage::Loading)
+    {
+      --m_loadingCount;
+    }
+
+    const auto entryIt = m_entriesById.find(entry.resourceWrapper->id());
+    if (m_nextReleaseCheck == entryIt->second)
+    {
+      ++m_nextReleaseCheck;
+    }
+    m_entries.erase(entryIt->second);
+    m_entriesById.erase(entryIt);
+  }
 };
 
 } // namespace tb::mdl
@@ -157,7 +157,10 @@ protected:
     return axis / safeScale(T1(factor));
   }
 
-  deleteCopyAndMove(UVCoordSystem);
+  UVCoordSystem(const UVCoordSystem& other) = default;
+  UVCoordSystem(UVCoordSystem&& other) noexcept = default;
+  UVCoordSystem& operator=(const UVCoordSystem& other) = default;
+  UVCoordSystem& operator=(UVCoordSystem&& other) noexcept = default;
 };
 
 } // namespace tb::mdl
@@ -40,6 +40,7 @@
 
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -86,6 +87,11 @@ const WorldNode::NodeTree& WorldNode::nodeTree() const
   return *m_nodeTree;
 }
 
+const std::unordered_set<GroupNode*>& WorldNode::groupNodes() const
+{
+  return m_groupNodes;
+}
+
 LayerNode* WorldNode::defaultLayer()
 {
   contract_pre(m_defaultLayer != nullptr);
@@ -208,11 +214,11 @@ void WorldNode::enableNodeTreeUpdates()
 
 void WorldNode::rebuildNodeTree()
 {
-  auto nodes = std::vector<Node*>{};
+  auto entries = std::vector<std::pair<vm::bbox3d, Node*>>{};
   const auto addNode = [&](auto* node) {
     if (node->shouldAddToSpacialIndex())
     {
-      nodes.push_back(node);
+      entries.emplace_back(node->physicalBounds(), node);
     }
   };
 
@@ -236,11 +242,7 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
-  {
-    contract_assert(m_nodeTree->insert(node->physicalBounds(), node));
-  }
+  m_nodeTree->rebuild(std::move(entries));
 }
 
 void WorldNode::invalidateAllIssues()
@@ -381,6 +383,7 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
     [&](auto&& thisLambda, GroupNode* group) {
       group->visitChildren(thisLambda);
       updatePersistentId(group);
+      m_groupNodes.insert(group);
     },
     [&](EntityNode*) {},
     [&](BrushNode*) {},
@@ -402,6 +405,17 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
       [&](BrushNode* brush) { contract_assert(m_nodeTree->remove(brush)); },
       [&](PatchNode* patch) { contract_assert(m_nodeTree->remove(patch)); }));
   }
+
+  node->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      group->visitChildren(thisLambda);
+      m_groupNodes.erase(group);
+    },
+    [](EntityNode*) {},
+    [](BrushNode*) {},
+    [](PatchNode*) {}));
 }
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
@@ -28,10 +28,12 @@
 #include "octree.h"
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
 {
+class GroupNode;
 class IssueQuickFix;
 enum class MapFormat;
 class PickResult;
@@ -50,6 +52,8 @@ private:
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
+  std::unordered_set<GroupNode*> m_groupNodes;
+
   IdType m_nextPersistentId = 1;
 
 public:
@@ -68,6 +72,13 @@ public:
 
   const NodeTree& nodeTree() const;
 
+  /**
+   * Returns all groups in this world, including nested groups, in no particular order.
+   * Groups are not part of the node tree, so spatial queries can use this to find them
+   * without traversing the world.
+   */
+  const std::unordered_set<GroupNode*>& groupNodes() const;
+
 public: // layer management
   LayerNode* defaultLayer();
 
@@ -36,6 +36,16 @@ namespace
          || (is_valid(x) && is_valid(y) && is_valid(z));
 }
 
+uint64_t spread_bits(const uint16_t n)
+{
+  auto result = uint64_t(0);
+  for (size_t i = 0; i < 16; ++i)
+  {
+    result |= uint64_t((n >> i) & 1u) << (3 * i);
+  }
+  return result;
+}
+
 } // namespace
 
 node_address::node_address(
@@ -149,4 +159,14 @@ node_address get_container(const node_address& address1, const node_address& add
   return container;
 }
 
+uint64_t get_morton_code(const node_address& address)
+{
+  // Flipping the sign bits maps the coordinates to unsigned values without changing
+  // their order, so that the top level of the code separates negative and positive
+  // coordinates just like the quadrants of a root node.
+  return spread_bits(uint16_t(address.x ^ 0x8000))
+         | (spread_bits(uint16_t(address.y ^ 0x8000)) << 1)
+         | (spread_bits(uint16_t(address.z ^ 0x8000)) << 2);
+}
+
 } // namespace tb::detail
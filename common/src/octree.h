@@ -35,6 +35,7 @@
 #include <cmath>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -90,6 +91,13 @@ node_address get_root(const node_address& address);
 
 node_address get_container(const node_address& address1, const node_address& address2);
 
+/**
+ * Returns the Morton code of the minimum corner of the given address. Sorting addresses
+ * by their Morton codes groups them by the octree quadrants they belong to at every
+ * level of the tree.
+ */
+uint64_t get_morton_code(const node_address& address);
+
 template <typename T>
 node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
 {
@@ -195,6 +203,13 @@ public:
   };
 
 private:
+  struct entry
+  {
+    detail::node_address address;
+    uint64_t morton_code;
+    U data;
+  };
+
   static detail::node_address& get_address(node& node)
   {
     return std::visit([](auto& x) -> detail::node_address& { return x.address; }, node);
@@ -314,6 +329,67 @@ private:
     }
   }
 
+  /**
+   * Builds a node with the given address from the given entries. The entries must be
+   * contained in the given address and sorted by their Morton codes, with larger
+   * addresses preceding smaller addresses with the same code.
+   */
+  static node build_node(const detail::node_address& address, std::span<entry> entries)
+  {
+    const auto has_quadrant = [&](const auto& e) {
+      return get_quadrant(address, e.address).has_value();
+    };
+
+    // Entries that are stored in this node precede the entries stored in its children.
+    const auto i_first_child_entry = std::ranges::find_if(entries, has_quadrant);
+
+    auto data = std::vector<U>{};
+    data.reserve(size_t(std::distance(entries.begin(), i_first_child_entry)));
+    for (auto i_entry = entries.begin(); i_entry != i_first_child_entry; ++i_entry)
+    {
+      data.push_back(std::move(i_entry->data));
+    }
+
+    if (i_first_child_entry == entries.end())
+    {
+      return leaf_node{address, std::move(data)};
+    }
+
+    auto children = std::vector<node>{};
+    children.reserve(8);
+
+    // The quadrant of an entry is encoded in its Morton code. A root node is split at the
+    // origin, which corresponds to the sign bits of the coordinates.
+    const auto level = is_root(address) ? 15u : unsigned(address.size) - 1u;
+    const auto get_entry_quadrant = [&](const auto& e) {
+      return size_t((e.morton_code >> (3u * level)) & 7u);
+    };
+
+    auto i_first = i_first_child_entry;
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      const auto i_last =
+        std::partition_point(i_first, entries.end(), [&](const auto& e) {
+          return get_entry_quadrant(e) == quadrant;
+        });
+
+      if (i_first == i_last)
+      {
+        children.emplace_back(leaf_node{get_child(address, quadrant), {}});
+      }
+      else
+      {
+        const auto container =
+          get_container(i_first->address, std::prev(i_last)->address);
+        children.push_back(build_node(container, std::span{i_first, i_last}));
+      }
+
+      i_first = i_last;
+    }
+
+    return inner_node{address, std::move(data), std::move(children)};
+  }
+
   void remove_from_node(node& node, const detail::node_address& address, const U& data)
   {
     std::visit(
@@ -458,6 +534,67 @@ public:
     return true;
   }
 
+  /**
+   * Replaces the contents of this tree with the given bounds and data.
+   *
+   * This is much faster than clearing the tree and inserting the entries one by one: the
+   * entries are sorted by the Morton codes of their addresses, and then the tree is built
+   * in one pass from the sorted entries. If the same data occurs more than once, only
+   * its first occurrence is inserted.
+   *
+   * @param entries the bounds and data to insert
+   */
+  void rebuild(std::vector<std::pair<vm::bbox<T, 3>, U>> entries)
+  {
+    clear();
+
+    auto sorted_entries = std::vector<entry>{};
+    sorted_entries.reserve(entries.size());
+    m_node_address_for_data.reserve(entries.size());
+
+    auto bounds_of_all_entries = std::optional<vm::bbox<T, 3>>{};
+    for (auto& [bounds, data] : entries)
+    {
+      contract_pre(!vm::is_nan(bounds.min) && !vm::is_nan(bounds.max));
+
+      const auto address = detail::get_container(bounds, m_min_size);
+      if (m_node_address_for_data.emplace(data, address).second)
+      {
+        sorted_entries.push_back(
+          entry{address, detail::get_morton_code(address), std::move(data)});
+        bounds_of_all_entries =
+          bounds_of_all_entries ? vm::merge(*bounds_of_all_entries, bounds) : bounds;
+      }
+    }
+
+    if (!bounds_of_all_entries)
+    {
+      return;
+    }
+
+    const auto container = detail::get_container(*bounds_of_all_entries, m_min_size);
+    const auto root_address = is_root(container) ? container : get_root(container);
+
+    // Entries with root addresses are stored in the root node regardless of their size.
+    const auto i_first_non_root_entry = std::stable_partition(
+      sorted_entries.begin(), sorted_entries.end(), [](const auto& e) {
+        return is_root(e.address);
+      });
+
+    for (auto i_entry = sorted_entries.begin(); i_entry != i_first_non_root_entry;
+         ++i_entry)
+    {
+      m_node_address_for_data.insert_or_assign(i_entry->data, root_address);
+    }
+
+    std::stable_sort(
+      i_first_non_root_entry, sorted_entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.morton_code != rhs.morton_code ? lhs.morton_code < rhs.morton_code
+                                                  : lhs.address.size > rhs.address.size;
+      });
+
+    m_root = build_node(root_address, sorted_entries);
+  }
 
   /**
    * Removes the node with the given data from this tree.
@@ -31,6 +31,7 @@
 #include "render/RenderContext.h"
 
 #include "kd/contracts.h"
+#include "kd/task_manager.h"
 
 #include <cstring>
 #include <vector>
@@ -188,20 +189,14 @@ void BrushRenderer::invalidate()
   contract_post(m_opaqueFaces->empty());
 }
 
-void BrushRenderer::invalidateMaterials(
-  const std::vector<const mdl::Material*>& materials)
+void BrushRenderer::invalidateMaterials(const std::vector<mdl::BrushNode*>& brushNodes)
 {
-  const auto materialSet =
-    std::unordered_set<const mdl::Material*>{materials.begin(), materials.end()};
-  for (auto* brush : m_allBrushes)
+  for (const auto* brushNode : brushNodes)
   {
-    for (const auto& face : brush->brush().faces())
+    if (m_allBrushes.contains(brushNode))
     {
-      if (materialSet.count(face.material()) > 0)
-      {
-        brush->brushRendererBrushCache().invalidateVertexCache();
-        invalidateBrush(brush);
-      }
+      brushNode->brushRendererBrushCache().invalidateVertexCache();
+      invalidateBrush(brushNode);
     }
   }
 }
@@ -382,12 +377,49 @@ void BrushRenderer::validate()
 {
   contract_pre(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
-  {
-    validateBrush(*brushNode);
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  // evaluate filter. only evaluate the filter once per brush.
+  auto brushesToRender =
+    std::vector<std::tuple<const mdl::BrushNode*, Filter::RenderSettings>>{};
+  brushesToRender.reserve(m_invalidBrushes.size());
+  for (const auto* brushNode : m_invalidBrushes)
+  {
+    const auto settings = wrapper.markFaces(*brushNode);
+    const auto [facePolicy, edgePolicy] = settings;
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToRender.emplace_back(brushNode, settings);
+    }
   }
   m_invalidBrushes.clear();
 
+  // build the vertex caches, this only touches the given brush
+  const auto validateVertexCache = [&](const size_t i) {
+    const auto* brushNode = std::get<0>(brushesToRender[i]);
+    brushNode->brushRendererBrushCache().validateVertexCache(*brushNode);
+  };
+
+  if (m_taskManager)
+  {
+    m_taskManager->run_range(0, brushesToRender.size(), 64, validateVertexCache);
+  }
+  else
+  {
+    for (size_t i = 0; i < brushesToRender.size(); ++i)
+    {
+      validateVertexCache(i);
+    }
+  }
+
+  // copy the cached vertices and indices into the arrays
+  for (const auto& [brushNode, settings] : brushesToRender)
+  {
+    validateBrush(*brushNode, settings);
+  }
+
   contract_assert(valid());
 
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
@@ -511,25 +543,16 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
+void BrushRenderer::validateBrush(
+  const mdl::BrushNode& brushNode, const Filter::RenderSettings& settings)
 {
   contract_pre(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  contract_pre(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
   contract_pre(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
 
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
   const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
-  {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
-  }
+  contract_pre(
+    facePolicy != Filter::FaceRenderPolicy::RenderNone
+    || edgePolicy != Filter::EdgeRenderPolicy::RenderNone);
 
   BrushInfo& info = m_brushInfo[&brushNode];
 
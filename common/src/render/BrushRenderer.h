@@ -32,6 +32,11 @@
 #include <unordered_set>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb
 {
 namespace mdl
@@ -120,6 +125,7 @@ public:
 
 private:
   std::unique_ptr<Filter> m_filter;
+  kdl::task_manager* m_taskManager = nullptr;
 
   struct BrushInfo
   {
@@ -178,6 +184,18 @@ public:
     clear();
   }
 
+  /**
+   * Creates a brush renderer that uses the given task manager to build the vertex caches
+   * of invalid brushes in parallel.
+   */
+  template <typename FilterT>
+  BrushRenderer(FilterT filter, kdl::task_manager& taskManager)
+    : m_filter{std::make_unique<FilterT>(std::move(filter))}
+    , m_taskManager{&taskManager}
+  {
+    clear();
+  }
+
   BrushRenderer();
 
   /**
@@ -200,7 +218,12 @@ public:
    * lingering Material* pointers.
    */
   void invalidate();
-  void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
+
+  /**
+   * Invalidates the given brushes, which use materials that have changed. Brushes that
+   * were not added to this renderer are ignored.
+   */
+  void invalidateMaterials(const std::vector<mdl::BrushNode*>& brushNodes);
   void invalidateBrush(const mdl::BrushNode* brush);
   void invalidateMaterial(const mdl::Material& material);
   bool valid() const;
@@ -284,6 +307,13 @@ private:
 
 public:
   /**
+   * Uploads all invalid brushes to the vertex and index arrays.
+   *
+   * This happens in two phases: First, the vertex caches of all brushes that pass the
+   * filter are built. If this renderer has a task manager, this is done in parallel.
+   * Afterwards, the cached vertices and indices are copied into the arrays on the calling
+   * thread.
+   *
    * Only exposed for benchmarking.
    */
   void validate();
@@ -291,7 +321,8 @@ public:
 private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
-  void validateBrush(const mdl::BrushNode& brushNode);
+  void validateBrush(
+    const mdl::BrushNode& brushNode, const Filter::RenderSettings& settings);
 
 public:
   /**
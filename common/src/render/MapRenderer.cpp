@@ -31,6 +31,7 @@
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
 #include "mdl/Map.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/MaterialManager.h"
 #include "mdl/Node.h"
 #include "mdl/NodeQueries.h"
@@ -165,6 +166,7 @@ std::unique_ptr<ObjectRenderer> createDefaultRenderer(mdl::Map& map)
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
+    map.taskManager(),
     UnselectedBrushRendererFilter{map.editorContext()});
 }
 
@@ -174,6 +176,7 @@ std::unique_ptr<ObjectRenderer> createSelectionRenderer(mdl::Map& map)
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
+    map.taskManager(),
     SelectedBrushRendererFilter{map.editorContext()});
 }
 
@@ -183,6 +186,7 @@ std::unique_ptr<ObjectRenderer> createLockRenderer(mdl::Map& map)
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
+    map.taskManager(),
     LockedBrushRendererFilter{map.editorContext()});
 }
 
@@ -817,10 +821,11 @@ void MapRenderer::resourcesWereProcessed(const std::vector<mdl::ResourceId>& res
 {
   const auto& materialManager = m_map.materialManager();
   const auto materials = materialManager.findMaterialsByTextureResourceId(resourceIds);
+  const auto brushNodes = m_map.materialIndex().findBrushNodes(materials);
 
-  m_defaultRenderer->invalidateMaterials(materials);
-  m_selectionRenderer->invalidateMaterials(materials);
-  m_lockedRenderer->invalidateMaterials(materials);
+  m_defaultRenderer->invalidateMaterials(brushNodes);
+  m_selectionRenderer->invalidateMaterials(brushNodes);
+  m_lockedRenderer->invalidateMaterials(brushNodes);
 
   const auto& entityModelManager = m_map.entityModelManager();
   const auto entityModels =
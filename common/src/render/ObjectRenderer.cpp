@@ -48,10 +48,9 @@ void ObjectRenderer::removeNode(mdl::Node* node)
     [&](mdl::PatchNode* patch) { m_patchRenderer.removePatch(patch); }));
 }
 
-void ObjectRenderer::invalidateMaterials(
-  const std::vector<const mdl::Material*>& materials)
+void ObjectRenderer::invalidateMaterials(const std::vector<mdl::BrushNode*>& brushNodes)
 {
-  m_brushRenderer.invalidateMaterials(materials);
+  m_brushRenderer.invalidateMaterials(brushNodes);
   m_patchRenderer.invalidate();
 }
 
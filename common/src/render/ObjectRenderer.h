@@ -28,6 +28,11 @@
 
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb
 {
 class Logger;
@@ -63,10 +68,11 @@ public:
     Logger& logger,
     mdl::EntityModelManager& entityModelManager,
     const mdl::EditorContext& editorContext,
+    kdl::task_manager& taskManager,
     const BrushFilterT& brushFilter)
     : m_groupRenderer{editorContext}
     , m_entityRenderer{logger, entityModelManager, editorContext}
-    , m_brushRenderer{brushFilter}
+    , m_brushRenderer{brushFilter, taskManager}
     , m_patchRenderer{editorContext}
   {
   }
@@ -74,7 +80,7 @@ public:
 public: // object management
   void addNode(mdl::Node* node);
   void removeNode(mdl::Node* node);
-  void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
+  void invalidateMaterials(const std::vector<mdl::BrushNode*>& brushNodes);
   void invalidateEntityModels(const std::vector<const mdl::EntityModel*>& entityModels);
   void invalidateNode(mdl::Node* node);
   void invalidate();
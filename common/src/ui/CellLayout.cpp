@@ -139,6 +139,14 @@ void LayoutCell::updateLayout(
   doLayout(maxUpScale, minWidth, maxWidth, minHeight, maxHeight);
 }
 
+void LayoutCell::translateY(const float deltaY)
+{
+  m_y += deltaY;
+  m_cellBounds.y += deltaY;
+  m_itemBounds.y += deltaY;
+  m_titleBounds.y += deltaY;
+}
+
 void LayoutCell::doLayout(
   const float maxUpScale,
   const float minWidth,
@@ -332,6 +340,15 @@ void LayoutRow::addItem(
   m_cells.push_back(std::move(cell));
 }
 
+void LayoutRow::translateY(const float deltaY)
+{
+  m_bounds.y += deltaY;
+  for (auto& cell : m_cells)
+  {
+    cell.translateY(deltaY);
+  }
+}
+
 void LayoutRow::readjustItems()
 {
   for (auto& cell : m_cells)
@@ -441,6 +458,11 @@ LayoutBounds LayoutGroup::bounds() const
     m_contentBounds.bottom() - m_titleBounds.top()};
 }
 
+const std::vector<LayoutItem>& LayoutGroup::items() const
+{
+  return m_items;
+}
+
 const std::vector<LayoutRow>& LayoutGroup::rows() const
 {
   return m_rows;
@@ -502,6 +524,71 @@ void LayoutGroup::addItem(
   const float titleWidth,
   const float titleHeight)
 {
+  m_items.push_back(LayoutItem{
+    std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight});
+  layoutItem(m_items.back());
+}
+
+void LayoutGroup::insertItem(const size_t index, LayoutItem item)
+{
+  contract_pre(index <= m_items.size());
+
+  m_items.insert(m_items.begin() + std::ptrdiff_t(index), std::move(item));
+  invalidateFrom(index);
+}
+
+void LayoutGroup::updateItem(
+  const size_t index, std::any item, const float itemWidth, const float itemHeight)
+{
+  contract_pre(index < m_items.size());
+
+  auto& layoutItem = m_items[index];
+  layoutItem.item = std::move(item);
+  layoutItem.itemWidth = itemWidth;
+  layoutItem.itemHeight = itemHeight;
+  invalidateFrom(index);
+}
+
+void LayoutGroup::removeItem(const size_t index)
+{
+  contract_pre(index < m_items.size());
+
+  m_items.erase(m_items.begin() + std::ptrdiff_t(index));
+  invalidateFrom(index);
+}
+
+void LayoutGroup::translateY(const float deltaY)
+{
+  m_titleBounds.y += deltaY;
+  m_contentBounds.y += deltaY;
+  for (auto& row : m_rows)
+  {
+    row.translateY(deltaY);
+  }
+}
+
+void LayoutGroup::validate()
+{
+  if (m_firstInvalidItemIndex)
+  {
+    layoutItemsFrom(*m_firstInvalidItemIndex);
+    m_firstInvalidItemIndex = std::nullopt;
+  }
+}
+
+void LayoutGroup::invalidateFrom(const size_t index)
+{
+  m_firstInvalidItemIndex =
+    m_firstInvalidItemIndex ? std::min(*m_firstInvalidItemIndex, index) : index;
+}
+
+void LayoutGroup::layoutItem(const LayoutItem& item)
+{
+  const auto itemWidth = item.itemWidth;
+  const auto itemHeight = item.itemHeight;
+  const auto titleWidth = item.titleWidth;
+  const auto titleHeight = item.titleHeight;
+
   if (m_rows.empty())
   {
     const auto y = m_contentBounds.top();
@@ -550,7 +637,7 @@ void LayoutGroup::addItem(
     m_rows.back().canAddItem(itemWidth, itemHeight, titleWidth, titleHeight));
 
   m_rows.back().addItem(
-    std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight);
+    item.item, item.title, itemWidth, itemHeight, titleWidth, titleHeight);
 
   const auto newRowHeight = m_rows.back().bounds().height;
   m_contentBounds = LayoutBounds{
@@ -560,6 +647,32 @@ void LayoutGroup::addItem(
     m_contentBounds.height + (newRowHeight - oldRowHeight)};
 }
 
+void LayoutGroup::layoutItemsFrom(const size_t index)
+{
+  // Rows are filled one after another, so the rows before the one containing the given
+  // item are not affected and can be kept.
+  auto firstItemIndex = size_t(0);
+  auto rowIndex = size_t(0);
+  while (rowIndex < m_rows.size()
+         && firstItemIndex + m_rows[rowIndex].cells().size() <= index)
+  {
+    firstItemIndex += m_rows[rowIndex].cells().size();
+    ++rowIndex;
+  }
+
+  m_rows.erase(m_rows.begin() + std::ptrdiff_t(rowIndex), m_rows.end());
+  m_contentBounds = LayoutBounds{
+    m_contentBounds.left(),
+    m_contentBounds.top(),
+    m_contentBounds.width,
+    m_rows.empty() ? 0.0f : m_rows.back().bounds().bottom() - m_contentBounds.top()};
+
+  for (size_t i = firstItemIndex; i < m_items.size(); ++i)
+  {
+    layoutItem(m_items[i]);
+  }
+}
+
 CellLayout::CellLayout(const size_t maxCellsPerRow)
   : m_maxCellsPerRow{maxCellsPerRow}
 {
@@ -703,10 +816,7 @@ float CellLayout::width() const
 
 float CellLayout::height()
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
   return m_height;
 }
 
@@ -718,10 +828,7 @@ LayoutBounds CellLayout::titleBoundsForVisibleRect(
 
 float CellLayout::rowPosition(const float y, const int offset)
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
 
   auto groupIndex = m_groups.size();
   for (size_t i = 0; i < m_groups.size(); ++i)
@@ -795,20 +902,14 @@ void CellLayout::setWidth(const float width)
 
 const std::vector<LayoutGroup>& CellLayout::groups()
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
 
   return m_groups;
 }
 
 const LayoutCell* CellLayout::cellAt(const float x, const float y)
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
 
   for (size_t i = 0; i < m_groups.size(); ++i)
   {
@@ -833,10 +934,7 @@ const LayoutCell* CellLayout::cellAt(const float x, const float y)
 
 void CellLayout::addGroup(std::string title, const float titleHeight)
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
 
   auto y = 0.0f;
   if (!m_groups.empty())
@@ -871,10 +969,7 @@ void CellLayout::addItem(
   const float titleWidth,
   const float titleHeight)
 {
-  if (!m_valid)
-  {
-    validate();
-  }
+  validate();
 
   if (m_groups.empty())
   {
@@ -906,6 +1001,46 @@ void CellLayout::addItem(
   m_height += (newGroupHeight - oldGroupHeight);
 }
 
+void CellLayout::insertItem(
+  const size_t groupIndex,
+  const size_t itemIndex,
+  std::any item,
+  std::string title,
+  const float itemWidth,
+  const float itemHeight,
+  const float titleWidth,
+  const float titleHeight)
+{
+  contract_pre(groupIndex < m_groups.size());
+
+  m_groups[groupIndex].insertItem(
+    itemIndex,
+    LayoutItem{
+      std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight});
+  m_groupsValid = false;
+}
+
+void CellLayout::updateItem(
+  const size_t groupIndex,
+  const size_t itemIndex,
+  std::any item,
+  const float itemWidth,
+  const float itemHeight)
+{
+  contract_pre(groupIndex < m_groups.size());
+
+  m_groups[groupIndex].updateItem(itemIndex, std::move(item), itemWidth, itemHeight);
+  m_groupsValid = false;
+}
+
+void CellLayout::removeItem(const size_t groupIndex, const size_t itemIndex)
+{
+  contract_pre(groupIndex < m_groups.size());
+
+  m_groups[groupIndex].removeItem(itemIndex);
+  m_groupsValid = false;
+}
+
 void CellLayout::clear()
 {
   m_groups.clear();
@@ -913,6 +1048,18 @@ void CellLayout::clear()
 }
 
 void CellLayout::validate()
+{
+  if (!m_valid)
+  {
+    layoutGroups();
+  }
+  else if (!m_groupsValid)
+  {
+    updateGroups();
+  }
+}
+
+void CellLayout::layoutGroups()
 {
   if (m_width <= 0.0f)
   {
@@ -921,6 +1068,7 @@ void CellLayout::validate()
 
   m_height = 2.0f * m_outerMargin;
   m_valid = true;
+  m_groupsValid = true;
   if (!m_groups.empty())
   {
     auto copy = m_groups;
@@ -929,26 +1077,37 @@ void CellLayout::validate()
     for (auto& group : copy)
     {
       addGroup(group.title(), group.titleBounds().height);
-      for (const auto& row : group.rows())
+      for (const auto& item : group.items())
       {
-        for (const auto& cell : row.cells())
-        {
-          const auto& itemBounds = cell.itemBounds();
-          const auto& titleBounds = cell.titleBounds();
-          const auto scale = cell.scale();
-          const auto itemWidth = itemBounds.width / scale;
-          const auto itemHeight = itemBounds.height / scale;
-          addItem(
-            cell.item(),
-            cell.title(),
-            itemWidth,
-            itemHeight,
-            titleBounds.width,
-            titleBounds.height);
-        }
+        addItem(
+          item.item,
+          item.title,
+          item.itemWidth,
+          item.itemHeight,
+          item.titleWidth,
+          item.titleHeight);
       }
     }
   }
 }
 
+void CellLayout::updateGroups()
+{
+  auto deltaY = 0.0f;
+  for (auto& group : m_groups)
+  {
+    if (deltaY != 0.0f)
+    {
+      group.translateY(deltaY);
+    }
+
+    const auto oldGroupHeight = group.bounds().height;
+    group.validate();
+    deltaY += group.bounds().height - oldGroupHeight;
+  }
+
+  m_height += deltaY;
+  m_groupsValid = true;
+}
+
 } // namespace tb::ui
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <any>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,20 @@ struct LayoutBounds
   bool intersectsY(float rangeY, float rangeHeight) const;
 };
 
+/**
+ * The information needed to lay out an item. The cells of a layout group are created from
+ * its items, so the group can be laid out again after some of its items have changed.
+ */
+struct LayoutItem
+{
+  std::any item;
+  std::string title;
+  float itemWidth;
+  float itemHeight;
+  float titleWidth;
+  float titleHeight;
+};
+
 class LayoutCell
 {
 private:
@@ -102,6 +117,7 @@ public:
 
   void updateLayout(
     float maxUpScale, float minWidth, float maxWidth, float minHeight, float maxHeight);
+  void translateY(float deltaY);
 
 private:
   void doLayout(
@@ -155,6 +171,8 @@ public:
     float titleWidth,
     float titleHeight);
 
+  void translateY(float deltaY);
+
 private:
   void readjustItems();
 };
@@ -175,7 +193,9 @@ private:
   LayoutBounds m_titleBounds;
   LayoutBounds m_contentBounds;
 
+  std::vector<LayoutItem> m_items;
   std::vector<LayoutRow> m_rows;
+  std::optional<size_t> m_firstInvalidItemIndex;
 
 public:
   LayoutGroup(
@@ -215,6 +235,7 @@ public:
   const LayoutBounds& contentBounds() const;
   LayoutBounds bounds() const;
 
+  const std::vector<LayoutItem>& items() const;
   const std::vector<LayoutRow>& rows() const;
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
@@ -229,6 +250,18 @@ public:
     float itemHeight,
     float titleWidth,
     float titleHeight);
+
+  void insertItem(size_t index, LayoutItem item);
+  void updateItem(size_t index, std::any item, float itemWidth, float itemHeight);
+  void removeItem(size_t index);
+
+  void translateY(float deltaY);
+  void validate();
+
+private:
+  void invalidateFrom(size_t index);
+  void layoutItem(const LayoutItem& item);
+  void layoutItemsFrom(size_t index);
 };
 
 class CellLayout
@@ -249,6 +282,7 @@ private:
 
   std::vector<LayoutGroup> m_groups;
   bool m_valid = false;
+  bool m_groupsValid = true;
   float m_height = 0.0f;
 
 public:
@@ -303,10 +337,35 @@ public:
     float titleWidth,
     float titleHeight);
 
+  /**
+   * The following functions change a single item of the group with the given index. The
+   * changes are applied lazily: When the layout is accessed next, each changed group is
+   * laid out again starting with the row that contains its first changed item, and the
+   * groups after it are moved up or down if its height has changed.
+   */
+  void insertItem(
+    size_t groupIndex,
+    size_t itemIndex,
+    std::any item,
+    std::string title,
+    float itemWidth,
+    float itemHeight,
+    float titleWidth,
+    float titleHeight);
+  void updateItem(
+    size_t groupIndex,
+    size_t itemIndex,
+    std::any item,
+    float itemWidth,
+    float itemHeight);
+  void removeItem(size_t groupIndex, size_t itemIndex);
+
   void clear();
 
 private:
   void validate();
+  void layoutGroups();
+  void updateGroups();
 };
 
 } // namespace tb::ui
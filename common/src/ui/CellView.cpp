@@ -79,6 +79,7 @@ void CellView::reloadLayout()
   updateScrollBar();
 
   m_valid = true;
+  m_itemsValid = true;
 }
 
 void CellView::validate()
@@ -87,6 +88,13 @@ void CellView::validate()
   {
     reloadLayout();
   }
+  else if (!m_itemsValid)
+  {
+    doUpdateItems(m_layout);
+    updateScrollBar();
+
+    m_itemsValid = true;
+  }
 }
 
 CellView::CellView(GLContextManager& contextManager, QScrollBar* scrollBar)
@@ -113,11 +121,17 @@ void CellView::invalidate()
   m_valid = false;
 }
 
+void CellView::invalidateItems()
+{
+  m_itemsValid = false;
+}
+
 void CellView::clear()
 {
   m_layout.clear();
   doClear();
   m_valid = true;
+  m_itemsValid = true;
 }
 
 void CellView::resizeEvent(QResizeEvent* event)
@@ -536,6 +550,12 @@ void CellView::renderTitleStrings(float y, float height)
   }
 }
 
+void CellView::doUpdateItems(Layout& layout)
+{
+  layout.clear();
+  doReloadLayout(layout);
+}
+
 void CellView::doClear() {}
 void CellView::doLeftClick(Layout&, float, float) {}
 void CellView::doContextMenu(Layout&, float, float, QContextMenuEvent*) {}
@@ -47,6 +47,7 @@ private:
   bool m_layoutInitialized = false;
 
   bool m_valid = false;
+  bool m_itemsValid = true;
 
   QScrollBar* m_scrollBar = nullptr;
   QPoint m_lastMousePos;
@@ -60,6 +61,14 @@ private:
 public:
   explicit CellView(GLContextManager& contextManager, QScrollBar* scrollBar = nullptr);
   void invalidate();
+
+  /**
+   * Requests that the items of the layout are updated before the view is rendered next
+   * time. Unlike invalidate, this does not reload the entire layout; instead, the
+   * subclass updates only the items that changed, see doUpdateItems.
+   */
+  void invalidateItems();
+
   void clear();
   void resizeEvent(QResizeEvent* event) override;
 
@@ -120,6 +129,7 @@ private:
 
   virtual void doInitLayout(Layout& layout) = 0;
   virtual void doReloadLayout(Layout& layout) = 0;
+  virtual void doUpdateItems(Layout& layout);
   virtual void doClear();
   virtual void doRender(Layout& layout, float y, float height) = 0;
   virtual void doLeftClick(Layout& layout, float x, float y);
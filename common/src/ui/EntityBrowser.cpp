@@ -147,8 +147,6 @@ void EntityBrowser::connectObservers()
     this, &EntityBrowser::entityDefinitionsDidChange);
   m_notifierConnection +=
     m_map.nodesDidChangeNotifier.connect(this, &EntityBrowser::nodesDidChange);
-  m_notifierConnection += m_map.resourcesWereProcessedNotifier.connect(
-    this, &EntityBrowser::resourcesWereProcessed);
 
   auto& prefs = PreferenceManager::instance();
   m_notifierConnection +=
@@ -193,9 +191,4 @@ void EntityBrowser::preferenceDidChange(const std::filesystem::path& path)
   }
 }
 
-void EntityBrowser::resourcesWereProcessed(const std::vector<mdl::ResourceId>&)
-{
-  reload();
-}
-
 } // namespace tb::ui
@@ -37,7 +37,6 @@ namespace mdl
 {
 class Map;
 class Node;
-class ResourceId;
 } // namespace mdl
 
 namespace ui
@@ -77,7 +76,6 @@ private:
   void nodesDidChange(const std::vector<mdl::Node*>& nodes);
   void entityDefinitionsDidChange();
   void preferenceDidChange(const std::filesystem::path& path);
-  void resourcesWereProcessed(const std::vector<mdl::ResourceId>& resources);
 };
 
 } // namespace ui
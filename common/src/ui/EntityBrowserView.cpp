@@ -45,6 +45,7 @@
 #include "kd/contracts.h"
 #include "kd/string_compare.h"
 #include "kd/string_utils.h"
+#include "kd/vector_utils.h"
 
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
@@ -53,6 +54,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::ui
@@ -143,6 +145,8 @@ void EntityBrowserView::doReloadLayout(Layout& layout)
   const auto& entityDefinitionManager = m_map.entityDefinitionManager();
   const auto font = render::FontDescriptor{fontPath, static_cast<size_t>(fontSize)};
 
+  m_processedResourceIds.clear();
+
   if (m_group)
   {
     for (const auto& group : entityDefinitionManager.groups())
@@ -165,6 +169,47 @@ void EntityBrowserView::doReloadLayout(Layout& layout)
   }
 }
 
+namespace
+{
+
+vm::vec3f rotatedBoundsSize(const EntityCellData& cellData)
+{
+  return cellData.bounds.transform(cellData.transform).size();
+}
+
+} // namespace
+
+void EntityBrowserView::doUpdateItems(Layout& layout)
+{
+  const auto& entityModelManager = m_map.entityModelManager();
+  const auto processedModels =
+    entityModelManager.findEntityModelsByTextureResourceId(m_processedResourceIds);
+  m_processedResourceIds.clear();
+
+  const auto models = std::unordered_set<const mdl::EntityModel*>{
+    processedModels.begin(), processedModels.end()};
+  if (models.empty())
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < layout.groups().size(); ++i)
+  {
+    const auto& items = layout.groups()[i].items();
+    for (size_t j = 0; j < items.size(); ++j)
+    {
+      const auto& cellData = std::any_cast<const EntityCellData&>(items[j].item);
+      if (models.contains(cellData.model))
+      {
+        auto newCellData =
+          createCellData(cellData.entityDefinition, cellData.fontDescriptor);
+        const auto size = rotatedBoundsSize(newCellData);
+        layout.updateItem(i, j, std::move(newCellData), size.y(), size.z());
+      }
+    }
+  }
+}
+
 bool EntityBrowserView::dndEnabled()
 {
   return true;
@@ -177,9 +222,12 @@ QString EntityBrowserView::dndData(const Cell& cell)
   return prefix + name;
 }
 
-void EntityBrowserView::resourcesWereProcessed(const std::vector<mdl::ResourceId>&)
+void EntityBrowserView::resourcesWereProcessed(
+  const std::vector<mdl::ResourceId>& resourceIds)
 {
-  invalidate();
+  m_processedResourceIds =
+    kdl::vec_concat(std::move(m_processedResourceIds), resourceIds);
+  invalidateItems();
   update();
 }
 
@@ -216,74 +264,82 @@ void EntityBrowserView::addEntityToLayout(
     (!m_hideUnused || definition.usageCount() > 0)
     && matchesFilterText(definition, m_filterText))
   {
-    contract_assert(definition.pointEntityDefinition != std::nullopt);
-    const auto& pointEntityDefinition = *definition.pointEntityDefinition;
-
     const auto maxCellWidth = layout.maxCellWidth();
     const auto actualFont =
       fontManager().selectFontSize(font, definition.name, maxCellWidth, 5);
     const auto actualSize = fontManager().font(actualFont).measure(definition.name);
-    const auto spec =
-      mdl::safeGetModelSpecification(m_map.logger(), definition.name, [&]() {
-        return pointEntityDefinition.modelDefinition.defaultModelSpecification();
-      });
-
-    const auto modelScale = vm::vec3f{mdl::safeGetModelScale(
-      pointEntityDefinition.modelDefinition,
-      el::NullVariableStore{},
-      m_defaultScaleModelExpression)};
-
-    auto* modelRenderer = static_cast<render::MaterialRenderer*>(nullptr);
-    auto bounds = vm::bbox3f{};
-    auto transform = vm::mat4x4f{};
-    auto modelOrientation = mdl::Orientation::Oriented;
-
-    const auto& entityModelManager = m_map.entityModelManager();
-    const auto* model = entityModelManager.model(spec.path);
-    const auto* modelData = model ? model->data() : nullptr;
-    const auto* modelFrame = modelData ? modelData->frame(spec.frameIndex) : nullptr;
-    if (modelFrame)
-    {
-      modelRenderer = entityModelManager.renderer(spec);
-      modelOrientation = modelData->orientation();
-
-      bounds = modelFrame->bounds();
-
-      const auto scalingMatrix = vm::scaling_matrix(modelScale);
-      const auto center = bounds.center();
-      const auto scaledCenter = scalingMatrix * center;
-      transform = vm::translation_matrix(scaledCenter) * vm::rotation_matrix(m_rotation)
-                  * scalingMatrix * vm::translation_matrix(-center);
-    }
-    else
-    {
-      bounds = vm::bbox3f{pointEntityDefinition.bounds};
-
-      const auto center = bounds.center();
-      transform = vm::translation_matrix(-center) * vm::rotation_matrix(m_rotation)
-                  * vm::translation_matrix(center);
-    }
 
-    const auto rotatedBounds = bounds.transform(transform);
-    const auto rotatedBoundsSize = rotatedBounds.size();
+    auto cellData = createCellData(definition, actualFont);
+    const auto size = rotatedBoundsSize(cellData);
 
     layout.addItem(
-      EntityCellData{
-        definition,
-        modelRenderer,
-        modelOrientation,
-        actualFont,
-        bounds,
-        transform,
-        modelScale},
+      std::move(cellData),
       definition.name,
-      rotatedBoundsSize.y(),
-      rotatedBoundsSize.z(),
+      size.y(),
+      size.z(),
       actualSize.x(),
       static_cast<float>(font.size()) + 2.0f);
   }
 }
 
+EntityCellData EntityBrowserView::createCellData(
+  const mdl::EntityDefinition& definition, const render::FontDescriptor& font) const
+{
+  contract_assert(definition.pointEntityDefinition != std::nullopt);
+  const auto& pointEntityDefinition = *definition.pointEntityDefinition;
+
+  const auto spec =
+    mdl::safeGetModelSpecification(m_map.logger(), definition.name, [&]() {
+      return pointEntityDefinition.modelDefinition.defaultModelSpecification();
+    });
+
+  const auto modelScale = vm::vec3f{mdl::safeGetModelScale(
+    pointEntityDefinition.modelDefinition,
+    el::NullVariableStore{},
+    m_defaultScaleModelExpression)};
+
+  auto* modelRenderer = static_cast<render::MaterialRenderer*>(nullptr);
+  auto bounds = vm::bbox3f{};
+  auto transform = vm::mat4x4f{};
+  auto modelOrientation = mdl::Orientation::Oriented;
+
+  const auto& entityModelManager = m_map.entityModelManager();
+  const auto* model = entityModelManager.model(spec.path);
+  const auto* modelData = model ? model->data() : nullptr;
+  const auto* modelFrame = modelData ? modelData->frame(spec.frameIndex) : nullptr;
+  if (modelFrame)
+  {
+    modelRenderer = entityModelManager.renderer(spec);
+    modelOrientation = modelData->orientation();
+
+    bounds = modelFrame->bounds();
+
+    const auto scalingMatrix = vm::scaling_matrix(modelScale);
+    const auto center = bounds.center();
+    const auto scaledCenter = scalingMatrix * center;
+    transform = vm::translation_matrix(scaledCenter) * vm::rotation_matrix(m_rotation)
+                * scalingMatrix * vm::translation_matrix(-center);
+  }
+  else
+  {
+    bounds = vm::bbox3f{pointEntityDefinition.bounds};
+
+    const auto center = bounds.center();
+    transform = vm::translation_matrix(-center) * vm::rotation_matrix(m_rotation)
+                * vm::translation_matrix(center);
+  }
+
+  return EntityCellData{
+    definition,
+    model,
+    modelRenderer,
+    modelOrientation,
+    font,
+    bounds,
+    transform,
+    modelScale};
+}
+
 void EntityBrowserView::doClear() {}
 
 void EntityBrowserView::doRender(Layout& layout, const float y, const float height)
@@ -21,6 +21,7 @@
 
 #include "NotifierConnection.h"
 #include "el/Expression.h"
+#include "mdl/ResourceId.h"
 #include "render/FontDescriptor.h"
 #include "render/GLVertexType.h"
 #include "ui/CellView.h"
@@ -38,8 +39,8 @@ class Logger;
 
 namespace mdl
 {
+class EntityModel;
 class Map;
-class ResourceId;
 
 enum class EntityDefinitionSortOrder;
 enum class Orientation;
@@ -63,6 +64,7 @@ struct EntityCellData
 {
   using EntityRenderer = render::MaterialRenderer;
   const mdl::EntityDefinition& entityDefinition;
+  const mdl::EntityModel* model;
   EntityRenderer* modelRenderer;
   mdl::Orientation modelOrientation;
   render::FontDescriptor fontDescriptor;
@@ -93,6 +95,12 @@ private:
   mdl::EntityDefinitionSortOrder m_sortOrder;
   std::string m_filterText;
 
+  /**
+   * Resources that were processed since the layout was last updated. Only the cells
+   * showing the models that own these resources are updated.
+   */
+  std::vector<mdl::ResourceId> m_processedResourceIds;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -112,6 +120,7 @@ public:
 private:
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
+  void doUpdateItems(Layout& layout) override;
 
   bool dndEnabled() override;
   QString dndData(const Cell& cell) override;
@@ -126,6 +135,8 @@ private:
     Layout& layout,
     const mdl::EntityDefinition& definition,
     const render::FontDescriptor& font);
+  EntityCellData createCellData(
+    const mdl::EntityDefinition& definition, const render::FontDescriptor& font) const;
 
   void doClear() override;
   void doRender(Layout& layout, float y, float height) override;
@@ -76,6 +76,8 @@ QWidget* IssueBrowser::createTabBarPage(QWidget* parent)
 void IssueBrowser::connectObservers()
 {
   auto& map = m_document.map();
+  m_notifierConnection +=
+    map.mapWillBeClearedNotifier.connect(this, &IssueBrowser::mapWillBeCleared);
   m_notifierConnection +=
     map.mapWasCreatedNotifier.connect(this, &IssueBrowser::mapWasCreated);
   m_notifierConnection +=
@@ -92,6 +94,13 @@ void IssueBrowser::connectObservers()
     map.brushFacesDidChangeNotifier.connect(this, &IssueBrowser::brushFacesDidChange);
 }
 
+void IssueBrowser::mapWillBeCleared(mdl::Map&)
+{
+  // cancel any validation in progress, it refers to the nodes that are about to be
+  // deleted
+  m_view->reload();
+}
+
 void IssueBrowser::mapWasCreated(mdl::Map&)
 {
   reload();
@@ -67,6 +67,7 @@ public:
 
 private:
   void connectObservers();
+  void mapWillBeCleared(mdl::Map& map);
   void mapWasCreated(mdl::Map& map);
   void mapWasLoaded(mdl::Map& map);
   void mapWasSaved(mdl::Map& map);
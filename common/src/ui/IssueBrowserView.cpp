@@ -24,31 +24,36 @@
 #include <QItemSelectionModel>
 #include <QMenu>
 #include <QTableView>
+#include <QTimer>
 
-#include "mdl/BrushNode.h"
-#include "mdl/EntityNode.h"
-#include "mdl/GroupNode.h"
+#include "mdl/IncrementalValidation.h"
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
-#include "mdl/LayerNode.h"
 #include "mdl/Map.h"
 #include "mdl/Map_Selection.h"
-#include "mdl/PatchNode.h"
 #include "mdl/Transaction.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
 #include "ui/QtUtils.h"
 
-#include "kd/overload.h"
 #include "kd/vector_set.h"
 #include "kd/vector_utils.h"
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 namespace tb::ui
 {
+namespace
+{
+
+/** The maximum number of nodes to validate between two UI updates. */
+constexpr auto ValidationBatchSize = size_t(4096);
+
+} // namespace
 
 IssueBrowserView::IssueBrowserView(MapDocument& document, QWidget* parent)
   : QWidget{parent}
@@ -58,6 +63,8 @@ IssueBrowserView::IssueBrowserView(MapDocument& document, QWidget* parent)
   bindEvents();
 }
 
+IssueBrowserView::~IssueBrowserView() = default;
+
 void IssueBrowserView::createGui()
 {
   m_tableModel = new IssueBrowserModel{this};
@@ -129,50 +136,40 @@ void IssueBrowserView::updateSelection()
   selectNodes(map, nodes);
 }
 
-void IssueBrowserView::updateIssues()
+void IssueBrowserView::startValidation()
 {
-  const auto& map = m_document.map();
+  auto& map = m_document.map();
   if (auto* worldNode = map.world())
   {
-    const auto validators = worldNode->registeredValidators();
+    m_validation =
+      std::make_unique<mdl::IncrementalValidation>(*worldNode, map.taskManager());
+    validateNextBatch(++m_validationId);
+  }
+}
 
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    worldNode->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
-    });
-    m_tableModel->setIssues(std::move(issues));
+void IssueBrowserView::validateNextBatch(const size_t validationId)
+{
+  // the validation was cancelled or restarted since this batch was scheduled
+  if (validationId != m_validationId || !m_validation)
+  {
+    return;
+  }
+
+  auto issues = m_validation->validateNext(ValidationBatchSize);
+  std::erase_if(issues, [&](const auto* issue) {
+    return !m_showHiddenIssues
+           && (issue->hidden() || (issue->type() & m_hiddenIssueTypes) != 0);
+  });
+  m_tableModel->addIssues(issues);
+
+  if (m_validation->done())
+  {
+    m_validation.reset();
+  }
+  else
+  {
+    QTimer::singleShot(
+      0, this, [this, validationId]() { validateNextBatch(validationId); });
   }
 }
 
@@ -326,6 +323,8 @@ void IssueBrowserView::hideIssues()
 void IssueBrowserView::invalidate()
 {
   m_valid = false;
+  m_validation.reset();
+  ++m_validationId;
   m_tableModel->setIssues({});
 
   QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
@@ -335,7 +334,7 @@ void IssueBrowserView::validate()
 {
   if (!m_valid)
   {
-    updateIssues();
+    startValidation();
     m_valid = true;
   }
 }
@@ -354,6 +353,45 @@ void IssueBrowserModel::setIssues(std::vector<const mdl::Issue*> issues)
   endResetModel();
 }
 
+void IssueBrowserModel::addIssues(const std::vector<const mdl::Issue*>& issues)
+{
+  // keep the issues sorted by descending sequence ID
+  const auto compare = [](const auto* lhs, const auto* rhs) {
+    return lhs->seqId() > rhs->seqId();
+  };
+
+  if (issues.empty())
+  {
+    return;
+  }
+
+  const auto sortedIssues = kdl::vec_sort(issues, compare);
+  const auto first = std::ranges::upper_bound(m_issues, sortedIssues.front(), compare);
+  const auto last = std::ranges::upper_bound(m_issues, sortedIssues.back(), compare);
+
+  if (first == last)
+  {
+    // the new issues end up in a single block of rows, which is the usual case because
+    // issues found later have greater sequence IDs
+    const auto row = static_cast<int>(std::distance(m_issues.begin(), first));
+    const auto count = static_cast<int>(sortedIssues.size());
+
+    beginInsertRows(QModelIndex{}, row, row + count - 1);
+    m_issues.insert(first, sortedIssues.begin(), sortedIssues.end());
+    endInsertRows();
+  }
+  else
+  {
+    auto mergedIssues = std::vector<const mdl::Issue*>{};
+    mergedIssues.reserve(m_issues.size() + sortedIssues.size());
+    std::ranges::merge(m_issues, sortedIssues, std::back_inserter(mergedIssues), compare);
+
+    beginResetModel();
+    m_issues = std::move(mergedIssues);
+    endResetModel();
+  }
+}
+
 const std::vector<const mdl::Issue*>& IssueBrowserModel::issues()
 {
   return m_issues;
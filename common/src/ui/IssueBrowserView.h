@@ -24,6 +24,7 @@
 
 #include "mdl/IssueType.h"
 
+#include <memory>
 #include <vector>
 
 class QWidget;
@@ -33,6 +34,7 @@ namespace tb
 {
 namespace mdl
 {
+class IncrementalValidation;
 class Issue;
 class IssueQuickFix;
 } // namespace mdl
@@ -52,12 +54,15 @@ private:
   bool m_showHiddenIssues = false;
 
   bool m_valid = false;
+  std::unique_ptr<mdl::IncrementalValidation> m_validation;
+  size_t m_validationId = 0;
 
   QTableView* m_tableView = nullptr;
   IssueBrowserModel* m_tableModel = nullptr;
 
 public:
   explicit IssueBrowserView(MapDocument& document, QWidget* parent = nullptr);
+  ~IssueBrowserView() override;
 
 private:
   void createGui();
@@ -70,7 +75,8 @@ public:
   void deselectAll();
 
 private:
-  void updateIssues();
+  void startValidation();
+  void validateNextBatch(size_t validationId);
 
   std::vector<const mdl::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
   std::vector<const mdl::IssueQuickFix*> collectQuickFixes(
@@ -98,6 +104,7 @@ public slots:
 /**
  * Trivial QAbstractTableModel subclass, when the issues list changes,
  * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Issues that are found while validation is in progress are inserted in order.
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
@@ -109,6 +116,7 @@ public:
   explicit IssueBrowserModel(QObject* parent);
 
   void setIssues(std::vector<const mdl::Issue*> issues);
+  void addIssues(const std::vector<const mdl::Issue*>& issues);
   const std::vector<const mdl::Issue*>& issues();
 
 public: // QAbstractTableModel overrides
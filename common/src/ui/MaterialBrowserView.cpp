@@ -52,6 +52,7 @@
 
 #include <ranges>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::ui
@@ -131,9 +132,13 @@ void MaterialBrowserView::revealMaterial(const mdl::Material* material)
   });
 }
 
-void MaterialBrowserView::resourcesWereProcessed(const std::vector<mdl::ResourceId>&)
+void MaterialBrowserView::resourcesWereProcessed(
+  const std::vector<mdl::ResourceId>& resourceIds)
 {
-  reloadMaterials();
+  m_processedResourceIds =
+    kdl::vec_concat(std::move(m_processedResourceIds), resourceIds);
+  invalidateItems();
+  update();
 }
 
 void MaterialBrowserView::reloadMaterials()
@@ -163,6 +168,9 @@ void MaterialBrowserView::doReloadLayout(Layout& layout)
 
   const auto font = render::FontDescriptor{fontPath, size_t(fontSize)};
 
+  m_processedResourceIds.clear();
+  m_prioritizedArea = std::nullopt;
+
   if (m_group)
   {
     for (const auto* collection : getCollections())
@@ -177,6 +185,28 @@ void MaterialBrowserView::doReloadLayout(Layout& layout)
   }
 }
 
+void MaterialBrowserView::doUpdateItems(Layout& layout)
+{
+  const auto resourceIds = std::unordered_set<mdl::ResourceId>{
+    m_processedResourceIds.begin(), m_processedResourceIds.end()};
+  m_processedResourceIds.clear();
+  m_prioritizedArea = std::nullopt;
+
+  for (size_t i = 0; i < layout.groups().size(); ++i)
+  {
+    const auto& items = layout.groups()[i].items();
+    for (size_t j = 0; j < items.size(); ++j)
+    {
+      const auto* material = std::any_cast<const mdl::Material*>(items[j].item);
+      if (resourceIds.contains(material->textureResource().id()))
+      {
+        const auto cellSize = materialCellSize(*material);
+        layout.updateItem(i, j, material, cellSize.x(), cellSize.y());
+      }
+    }
+  }
+}
+
 void MaterialBrowserView::addMaterialsToLayout(
   Layout& layout,
   const std::vector<const mdl::Material*>& materials,
@@ -196,20 +226,25 @@ void MaterialBrowserView::addMaterialToLayout(
   const auto materialName = std::filesystem::path{material.name()}.filename().string();
   const auto titleHeight = fontManager().font(font).measure(materialName).y();
 
-  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
-  const auto* texture = material.texture();
-  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
-  const auto scaledTextureSize = vm::round(scaleFactor * textureSize);
+  const auto cellSize = materialCellSize(material);
 
   layout.addItem(
     &material,
     materialName,
-    scaledTextureSize.x(),
-    scaledTextureSize.y(),
+    cellSize.x(),
+    cellSize.y(),
     maxCellWidth,
     titleHeight + 4.0f);
 }
 
+vm::vec2f MaterialBrowserView::materialCellSize(const mdl::Material& material) const
+{
+  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
+  const auto* texture = material.texture();
+  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
+  return vm::round(scaleFactor * textureSize);
+}
+
 std::vector<const mdl::MaterialCollection*> MaterialBrowserView::getCollections() const
 {
   const auto enabledMaterialCollections = mdl::enabledMaterialCollections(m_map);
@@ -301,6 +336,13 @@ void MaterialBrowserView::doRender(Layout& layout, const float y, const float he
     vm::view_matrix(vm::vec3f{0, 0, -1}, vm::vec3f{0, 1, 0})
       * vm::translation_matrix(vm::vec3f{0.0f, 0.0f, 0.1f})};
 
+  // the visible materials only change when the view is scrolled or the layout changes
+  if (const auto area = vm::vec2f{y, height}; m_prioritizedArea != area)
+  {
+    prioritizeVisibleMaterials(layout, y, height);
+    m_prioritizedArea = area;
+  }
+
   renderBounds(layout, y, height);
   renderMaterials(layout, y, height);
 }
@@ -315,6 +357,38 @@ const Color& MaterialBrowserView::getBackgroundColor()
   return pref(Preferences::BrowserBackgroundColor);
 }
 
+void MaterialBrowserView::prioritizeVisibleMaterials(
+  Layout& layout, const float y, const float height)
+{
+  auto resourceIds = std::vector<mdl::ResourceId>{};
+
+  for (const auto& group : layout.groups())
+  {
+    if (group.intersectsY(y, height))
+    {
+      for (const auto& row : group.rows())
+      {
+        if (row.intersectsY(y, height))
+        {
+          for (const auto& cell : row.cells())
+          {
+            const auto& material = cellData(cell);
+            if (!material.texture())
+            {
+              resourceIds.push_back(material.textureResource().id());
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (!resourceIds.empty())
+  {
+    m_map.prioritizeResources(resourceIds);
+  }
+}
+
 void MaterialBrowserView::renderBounds(Layout& layout, const float y, const float height)
 {
   using BoundsVertex = render::GLVertexTypes::P2C4::Vertex;
@@ -20,9 +20,13 @@
 #pragma once
 
 #include "NotifierConnection.h"
+#include "mdl/ResourceId.h"
 #include "render/FontDescriptor.h"
 #include "ui/CellView.h"
 
+#include "vm/vec.h"
+
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -35,7 +39,6 @@ namespace mdl
 class Map;
 class Material;
 class MaterialCollection;
-class ResourceId;
 } // namespace mdl
 
 namespace ui
@@ -62,6 +65,19 @@ private:
 
   const mdl::Material* m_selectedMaterial = nullptr;
 
+  /**
+   * Resources that were processed since the layout was last updated. Processing a texture
+   * resource changes the size of its materials' cells, but not the set of materials or
+   * their order, so only the affected cells need to be updated.
+   */
+  std::vector<mdl::ResourceId> m_processedResourceIds;
+
+  /**
+   * The vertical position and height of the visible area when the visible materials were
+   * last prioritized. Unset if the layout changed since then.
+   */
+  std::optional<vm::vec2f> m_prioritizedArea;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -86,6 +102,7 @@ private:
 
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
+  void doUpdateItems(Layout& layout) override;
 
   void addMaterialsToLayout(
     Layout& layout,
@@ -93,6 +110,7 @@ private:
     const render::FontDescriptor& font);
   void addMaterialToLayout(
     Layout& layout, const mdl::Material& material, const render::FontDescriptor& font);
+  vm::vec2f materialCellSize(const mdl::Material& material) const;
 
   std::vector<const mdl::MaterialCollection*> getCollections() const;
   std::vector<const mdl::Material*> getMaterials(
@@ -109,6 +127,7 @@ private:
   bool shouldRenderFocusIndicator() const override;
   const Color& getBackgroundColor() override;
 
+  void prioritizeVisibleMaterials(Layout& layout, float y, float height);
   void renderBounds(Layout& layout, float y, float height);
   const Color& materialColor(const mdl::Material& material) const;
   void renderMaterials(Layout& layout, float y, float height);
@@ -176,6 +176,11 @@ QWidget* ViewPreferencePane::createViewPreferences()
                                      "28", "32", "36", "40", "48", "56", "64", "72"});
   m_rendererFontSizeCombo->setValidator(new QIntValidator{1, 96});
 
+  m_useMapCache = new QCheckBox{};
+  m_useMapCache->setToolTip(
+    "Stores parsed maps in a .tbcache file next to the map file to speed up loading "
+    "maps that haven't changed.");
+
   auto* layout = new FormWithSectionsLayout{};
   layout->setContentsMargins(
     LayoutConstants::DialogOuterMargin,
@@ -204,6 +209,9 @@ QWidget* ViewPreferencePane::createViewPreferences()
   layout->addSection("Fonts");
   layout->addRow("Renderer Font Size", m_rendererFontSizeCombo);
 
+  layout->addSection("Map Files");
+  layout->addRow("Use map cache", m_useMapCache);
+
   viewBox->setMinimumWidth(400);
   viewBox->setLayout(layout);
 
@@ -264,6 +272,11 @@ void ViewPreferencePane::bindEvents()
     &QComboBox::currentTextChanged,
     this,
     &ViewPreferencePane::rendererFontSizeChanged);
+  connect(
+    m_useMapCache,
+    &QCheckBox::checkStateChanged,
+    this,
+    &ViewPreferencePane::useMapCacheChanged);
 }
 
 bool ViewPreferencePane::canResetToDefaults()
@@ -286,6 +299,7 @@ void ViewPreferencePane::doResetToDefaults()
   prefs.resetToDefault(Preferences::Theme);
   prefs.resetToDefault(Preferences::MaterialBrowserIconSize);
   prefs.resetToDefault(Preferences::RendererFontSize);
+  prefs.resetToDefault(Preferences::UseMapCache);
 }
 
 void ViewPreferencePane::updateControls()
@@ -338,6 +352,8 @@ void ViewPreferencePane::updateControls()
 
   m_rendererFontSizeCombo->setCurrentText(
     QString::asprintf("%i", pref(Preferences::RendererFontSize)));
+
+  m_useMapCache->setChecked(pref(Preferences::UseMapCache));
 }
 
 bool ViewPreferencePane::validate()
@@ -466,4 +482,11 @@ void ViewPreferencePane::rendererFontSizeChanged(const QString& str)
   }
 }
 
+void ViewPreferencePane::useMapCacheChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::UseMapCache, value);
+}
+
 } // namespace tb::ui
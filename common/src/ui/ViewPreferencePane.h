@@ -45,6 +45,7 @@ private:
   QComboBox* m_themeCombo = nullptr;
   QComboBox* m_materialBrowserIconSizeCombo = nullptr;
   QComboBox* m_rendererFontSizeCombo = nullptr;
+  QCheckBox* m_useMapCache = nullptr;
 
 public:
   explicit ViewPreferencePane(QWidget* parent = nullptr);
@@ -74,6 +75,7 @@ private slots:
   void themeChanged(int index);
   void materialBrowserIconSizeChanged(int index);
   void rendererFontSizeChanged(const QString& text);
+  void useMapCacheChanged(int state);
 };
 
 } // namespace tb::ui
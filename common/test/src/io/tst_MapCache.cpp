@@ -0,0 +1,353 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestParserStatus.h"
+#include "io/MapCache.h"
+#include "io/NodeWriter.h"
+#include "io/WorldReader.h"
+#include "mdl/BrushNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::io
+{
+namespace
+{
+
+const auto worldBounds = vm::bbox3d{8192.0};
+
+std::string writeCache(
+  const std::string& data,
+  const mdl::MapFormat mapFormat,
+  const MapCacheKey& key,
+  kdl::task_manager& taskManager)
+{
+  auto mapCacheWriter = MapCacheWriter{};
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, mapFormat, {}};
+  REQUIRE(reader.read(worldBounds, status, taskManager, &mapCacheWriter));
+  REQUIRE(mapCacheWriter.complete());
+
+  auto stream = std::ostringstream{};
+  mapCacheWriter.write(stream, key);
+  return stream.str();
+}
+
+std::string writeWorld(const mdl::WorldNode& world, kdl::task_manager& taskManager)
+{
+  auto stream = std::stringstream{};
+  auto writer = NodeWriter{world, stream};
+  writer.writeMap(taskManager);
+  return stream.str();
+}
+
+std::vector<size_t> lineNumbers(const mdl::Node& node)
+{
+  auto result = std::vector<size_t>{node.lineNumber()};
+  for (const auto* child : node.children())
+  {
+    const auto childLineNumbers = lineNumbers(*child);
+    result.insert(result.end(), childLineNumbers.begin(), childLineNumbers.end());
+  }
+  return result;
+}
+
+std::vector<mdl::BrushGeometry::Topology> brushTopologies(const mdl::Node& node)
+{
+  auto result = std::vector<mdl::BrushGeometry::Topology>{};
+  if (const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(&node))
+  {
+    result.push_back(brushNode->brush().topology());
+  }
+  for (const auto* child : node.children())
+  {
+    auto childTopologies = brushTopologies(*child);
+    result.insert(
+      result.end(),
+      std::make_move_iterator(childTopologies.begin()),
+      std::make_move_iterator(childTopologies.end()));
+  }
+  return result;
+}
+
+std::string makeLargeMap(const size_t brushCount)
+{
+  auto str = std::string{"{\n\"classname\" \"worldspawn\"\n"};
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    const auto x = double(i % 256) * 16.0;
+    const auto y = double(i / 256 % 256) * 16.0;
+    const auto z = double(i / 65536) * 16.0;
+    str += fmt::format(
+      R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {6} {9} {8} ) ( {10} {7} {8} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {10} {7} {8} ) ( {6} {7} {11} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {6} {7} {11} ) ( {6} {9} {8} ) tex 0 0 0 1 1
+}}
+)",
+      x,
+      y,
+      z,
+      x + 1.0,
+      y + 1.0,
+      z + 1.0,
+      x + 8.0,
+      y + 8.0,
+      z + 8.0,
+      y + 9.0,
+      x + 9.0,
+      z + 9.0);
+  }
+  str += "}\n";
+  return str;
+}
+
+} // namespace
+
+TEST_CASE("MapCache")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto key = MapCacheKey{1234, 5678, 9012};
+
+  SECTION("mapCachePath")
+  {
+    CHECK(
+      mapCachePath("/some/path/map.map")
+      == std::filesystem::path{"/some/path/map.map.tbcache"});
+  }
+
+  SECTION("makeMapCacheKey")
+  {
+    const auto modificationTime = std::filesystem::file_time_type{};
+    CHECK(
+      makeMapCacheKey("some contents", modificationTime)
+      == makeMapCacheKey("some contents", modificationTime));
+    CHECK(
+      makeMapCacheKey("some contents", modificationTime)
+      != makeMapCacheKey("other contents", modificationTime));
+    CHECK(
+      makeMapCacheKey("some contents", modificationTime)
+      != makeMapCacheKey(
+        "some contents", modificationTime + std::chrono::seconds{1}));
+
+    // the content hash is stored in the cache, so it must not change between runs
+    CHECK(
+      makeMapCacheKey("some contents", modificationTime).contentHash
+      == 0xfcce7fd833afaab5);
+  }
+
+  SECTION("Restores the parsed map")
+  {
+    using T = std::tuple<mdl::MapFormat, std::string>;
+
+    // clang-format off
+    const auto
+    [mapFormat,               data] = GENERATE(values<T>({
+    {mdl::MapFormat::Quake2,  R"(
+{
+"classname" "worldspawn"
+"message" "a \"quoted\" message"
+{
+( 0 0 0 ) ( 0 1 0 ) ( 0 0 1 ) e1u1/floor 1 2 3 0.5 0.25 1 2 3.5
+( 0 0 0 ) ( 0 0 1 ) ( 1 0 0 ) e1u1/floor 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) e1u1/floor 0 0 0 1 1
+( 8 8 8 ) ( 8 9 8 ) ( 9 8 8 ) e1u1/floor 0 0 0 1 1
+( 8 8 8 ) ( 9 8 8 ) ( 8 8 9 ) e1u1/floor 0 0 0 1 1
+( 8 8 8 ) ( 8 8 9 ) ( 8 9 8 ) e1u1/floor 0 0 0 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "My Layer"
+"_tb_id" "1"
+"_tb_layer_sort_index" "0"
+"_tb_layer_locked" "1"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "My Group"
+"_tb_id" "2"
+"_tb_layer" "1"
+"_tb_linked_group_id" "my_link_id"
+}
+{
+"classname" "light"
+"origin" "1 2 3"
+"_tb_group" "2"
+}
+{
+"classname" "func_door"
+"_tb_layer" "1"
+{
+( 0 0 0 ) ( 0 1 0 ) ( 0 0 1 ) e1u1/door 0 0 45 1 1
+( 0 0 0 ) ( 0 0 1 ) ( 1 0 0 ) e1u1/door 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) e1u1/door 0 0 0 1 1
+( 8 8 8 ) ( 8 9 8 ) ( 9 8 8 ) e1u1/door 0 0 0 1 1
+( 8 8 8 ) ( 9 8 8 ) ( 8 8 9 ) e1u1/door 0 0 0 1 1
+( 8 8 8 ) ( 8 8 9 ) ( 8 9 8 ) e1u1/door 0 0 0 1 1
+}
+}
+)"},
+    {mdl::MapFormat::Valve,   R"(
+{
+"classname" "worldspawn"
+"mapversion" "220"
+{
+( 208 190 80 ) ( 208 -62 80 ) ( 208 190 -176 ) basic [ -0.625 1 0 34 ] [ 0 0 -1 0 ] 32.6509 1 1
+( 224 200 80 ) ( 208 190 80 ) ( 224 200 -176 ) basic [ -1 0 0 32 ] [ 0 0 -1 0 ] 35.6251 1 1
+( 224 200 -176 ) ( 208 190 -176 ) ( 224 -52 -176 ) basic [ -1 0 0 32 ] [ 0.625 -1 0 -4 ] 35.6251 1 1
+( 224 -52 80 ) ( 208 -62 80 ) ( 224 200 80 ) basic [ 1 0 0 -32 ] [ 0.625 -1 0 -4 ] 324.375 1 1
+( 224 -52 -176 ) ( 208 -62 -176 ) ( 224 -52 80 ) basic [ 1 0 0 -23.7303 ] [ 0 0 -1 0 ] 35.6251 1 1
+( 224 -52 80 ) ( 224 200 80 ) ( 224 -52 -176 ) basic [ -0.625 1 0 44 ] [ 0 0 -1 0 ] 32.6509 1 1
+}
+}
+)"},
+    {mdl::MapFormat::Daikatana, R"(
+{
+"classname" "worldspawn"
+{
+( -712 1280 -448 ) ( -904 1280 -448 ) ( -904 992 -448 ) rtz/c_mf_v3cw 56 -32 0 1 1 0 0 0 5 6 7
+( -904 992 -416 ) ( -904 1280 -416 ) ( -712 1280 -416 ) rtz/b_rc_v16w 32 32 0 1 1 1 2 3 8 9 10
+( -832 968 -416 ) ( -832 1256 -416 ) ( -832 1256 -448 ) rtz/c_mf_v3cww 16 96 0 1 1
+( -920 1088 -448 ) ( -920 1088 -416 ) ( -680 1088 -416 ) rtz/c_mf_v3c 56 96 0 1 1 0 0 0
+( -968 1152 -448 ) ( -920 1152 -448 ) ( -944 1152 -416 ) rtz/c_mf_v3c 56 96 0 1 1 0 0 0
+( -896 1056 -416 ) ( -896 1056 -448 ) ( -896 1344 -448 ) rtz/c_mf_v3c 16 96 0 1 1 0 0 0
+}
+}
+)"},
+    {mdl::MapFormat::Quake3,  R"(
+{
+"classname" "worldspawn"
+{
+patchDef2
+{
+common/caulk
+( 5 3 0 0 0 )
+(
+( (-64 -64 4 0   0 ) (-64 0 4 0   -0.25 ) (-64 64 4 0   -0.5 ) )
+( (  0 -64 4 0.2 0 ) (  0 0 4 0.2 -0.25 ) (  0 64 4 0.2 -0.5 ) )
+( ( 64 -64 4 0.4 0 ) ( 64 0 4 0.4 -0.25 ) ( 64 64 4 0.4 -0.5 ) )
+( (128 -64 4 0.6 0 ) (128 0 4 0.6 -0.25 ) (128 64 4 0.6 -0.5 ) )
+( (192 -64 4 0.8 0 ) (192 0 4 0.8 -0.25 ) (192 64 4 0.8 -0.5 ) )
+)
+}
+}
+}
+)"},
+    }));
+    // clang-format on
+
+    CAPTURE(mapFormat);
+
+    auto status = TestParserStatus{};
+    auto reader = WorldReader{data, mapFormat, {}};
+    auto expectedWorld = reader.read(worldBounds, status, taskManager);
+    REQUIRE(expectedWorld);
+
+    const auto cache = writeCache(data, mapFormat, key, taskManager);
+    auto mapCache = readMapCache(cache, key, taskManager);
+    REQUIRE(mapCache);
+    CHECK(mapCache.value().mapFormat == mapFormat);
+
+    const auto actualWorld = WorldReader::fromObjectInfos(
+      mapCache.value().mapFormat,
+      std::move(mapCache.value().objectInfos),
+      worldBounds,
+      {},
+      status,
+      taskManager);
+
+    CHECK(actualWorld->mapFormat() == mapFormat);
+    CHECK(lineNumbers(*actualWorld) == lineNumbers(*expectedWorld.value()));
+    CHECK(brushTopologies(*actualWorld) == brushTopologies(*expectedWorld.value()));
+    CHECK(
+      writeWorld(*actualWorld, taskManager)
+      == writeWorld(*expectedWorld.value(), taskManager));
+  }
+
+  SECTION("Rejects invalid caches")
+  {
+    const auto data = makeLargeMap(10);
+    const auto cache = writeCache(data, mdl::MapFormat::Standard, key, taskManager);
+    REQUIRE(readMapCache(cache, key, taskManager));
+
+    SECTION("Different key")
+    {
+      CHECK_FALSE(readMapCache(cache, MapCacheKey{1234, 5678, 9013}, taskManager));
+      CHECK_FALSE(readMapCache(cache, MapCacheKey{1234, 5679, 9012}, taskManager));
+      CHECK_FALSE(readMapCache(cache, MapCacheKey{1235, 5678, 9012}, taskManager));
+    }
+
+    SECTION("Truncated data")
+    {
+      CHECK_FALSE(readMapCache(
+        std::string_view{cache}.substr(0, cache.size() - 1), key, taskManager));
+      CHECK_FALSE(readMapCache(std::string_view{cache}.substr(0, 20), key, taskManager));
+      CHECK_FALSE(readMapCache("", key, taskManager));
+    }
+
+    SECTION("Not a map cache")
+    {
+      CHECK_FALSE(readMapCache(data, key, taskManager));
+    }
+  }
+
+  SECTION("Doesn't record maps with invalid brushes")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+}
+)";
+
+    auto mapCacheWriter = MapCacheWriter{};
+    auto status = TestParserStatus{};
+    auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    REQUIRE(reader.read(worldBounds, status, taskManager, &mapCacheWriter));
+    CHECK_FALSE(mapCacheWriter.complete());
+  }
+}
+
+} // namespace tb::io
@@ -0,0 +1,194 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/MapChunks.h"
+
+#include <string>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::io
+{
+
+TEST_CASE("splitMapIntoChunks")
+{
+  SECTION("Returns a single chunk for small input")
+  {
+    const auto str = std::string{R"(
+{
+"classname" "worldspawn"
+}
+)"};
+
+    CHECK(splitMapIntoChunks(str, 1024) == std::vector<MapChunk>{{str, {1, 1}, false}});
+  }
+
+  SECTION("Splits between entities")
+  {
+    const auto part1 = std::string{R"({
+"classname" "worldspawn"
+}
+)"};
+    const auto part2 = std::string{R"({
+"classname" "info_player_start"
+}
+)"};
+    const auto part3 = std::string{R"({
+"classname" "light"
+}
+)"};
+    const auto str = part1 + part2 + part3;
+
+    CHECK(
+      splitMapIntoChunks(str, 10)
+      == std::vector<MapChunk>{
+        {std::string_view{str}.substr(0, part1.size()), {1, 1}, false},
+        {std::string_view{str}.substr(part1.size(), part2.size()), {4, 1}, false},
+        {std::string_view{str}.substr(part1.size() + part2.size()), {7, 1}, false},
+      });
+  }
+
+  SECTION("Splits between brushes of an entity")
+  {
+    const auto part1 = std::string{R"({
+"classname" "worldspawn"
+)"};
+    const auto part2 = std::string{R"({
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+}
+)"};
+    const auto part3 = std::string{R"({
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+}
+}
+)"};
+    const auto str = part1 + part2 + part3;
+
+    CHECK(
+      splitMapIntoChunks(str, 20)
+      == std::vector<MapChunk>{
+        {std::string_view{str}.substr(0, part1.size()), {1, 1}, false},
+        {std::string_view{str}.substr(part1.size(), part2.size()), {3, 1}, true},
+        {std::string_view{str}.substr(part1.size() + part2.size()), {6, 1}, true},
+      });
+  }
+
+  SECTION("Does not split inside of patches")
+  {
+    const auto part1 = std::string{R"({
+"classname" "worldspawn"
+)"};
+    const auto part2 = std::string{R"({
+patchDef2
+{
+common/caulk
+( 3 3 0 0 0 )
+(
+( ( 0 0 0 0 0 ) ( 0 1 0 0 0 ) ( 0 2 0 0 0 ) )
+( ( 1 0 0 0 0 ) ( 1 1 0 0 0 ) ( 1 2 0 0 0 ) )
+( ( 2 0 0 0 0 ) ( 2 1 0 0 0 ) ( 2 2 0 0 0 ) )
+)
+}
+}
+}
+)"};
+    const auto str = part1 + part2;
+
+    CHECK(
+      splitMapIntoChunks(str, 10)
+      == std::vector<MapChunk>{
+        {std::string_view{str}.substr(0, part1.size()), {1, 1}, false},
+        {std::string_view{str}.substr(part1.size()), {3, 1}, true},
+      });
+  }
+
+  SECTION("Ignores braces in comments and quoted strings")
+  {
+    const auto part1 = std::string{R"({
+// {
+"classname" "worldspawn"
+"message" "{ \" {"
+}
+)"};
+    const auto part2 = std::string{R"({
+; {
+"classname" "light"
+}
+)"};
+    const auto str = part1 + part2;
+
+    CHECK(
+      splitMapIntoChunks(str, 10)
+      == std::vector<MapChunk>{
+        {std::string_view{str}.substr(0, part1.size()), {1, 1}, false},
+        {std::string_view{str}.substr(part1.size()), {6, 1}, false},
+      });
+  }
+
+  SECTION("Tracks locations across CRLF line endings")
+  {
+    const auto part1 = std::string{"{\r\n\"classname\" \"worldspawn\"\r\n}\r\n"};
+    const auto part2 = std::string{"{\r\n\"classname\" \"light\"\r\n}\r\n"};
+    const auto str = part1 + part2;
+
+    CHECK(
+      splitMapIntoChunks(str, 10)
+      == std::vector<MapChunk>{
+        {std::string_view{str}.substr(0, part1.size()), {1, 1}, false},
+        {std::string_view{str}.substr(part1.size()), {4, 1}, false},
+      });
+  }
+
+  SECTION("Returns a single chunk for malformed input")
+  {
+    using namespace std::string_literals;
+
+    const auto str = GENERATE(
+      R"({
+"classname" "worldspawn"
+}
+{
+"classname" "light"
+)"s,
+      R"({
+"classname" "worldspawn"
+}
+}
+{
+"classname" "light"
+}
+)"s,
+      R"({
+"classname" "worldspawn"
+}
+{
+"classname" "light
+}
+)"s);
+
+    CAPTURE(str);
+
+    CHECK(splitMapIntoChunks(str, 10) == std::vector<MapChunk>{{str, {1, 1}, false}});
+  }
+}
+
+} // namespace tb::io
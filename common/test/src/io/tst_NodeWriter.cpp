@@ -39,6 +39,7 @@
 #include <fmt/format.h>
 
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "catch/CatchConfig.h"
@@ -302,6 +303,127 @@ TEST_CASE("NodeWriter")
     CHECK(actual == expected);
   }
 
+  SECTION("writeWorldspawnWithManyBrushesInDefaultLayer")
+  {
+    // more brushes than the serializer precomputes at once
+    const auto brushCount = size_t(10000);
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+    auto brushNodes = std::vector<mdl::BrushNode*>{};
+    for (size_t i = 0; i < brushCount; ++i)
+    {
+      auto* brushNode = new mdl::BrushNode{
+        builder.createCube(64.0, fmt::format("material{}", i)) | kdl::value()};
+      map.defaultLayer()->addChild(brushNode);
+      brushNodes.push_back(brushNode);
+    }
+
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.writeMap(taskManager);
+
+    auto expected = std::string{R"(// entity 0
+{
+"classname" "worldspawn"
+)"};
+    for (size_t i = 0; i < brushCount; ++i)
+    {
+      expected += fmt::format(
+        R"(// brush {0}
+{{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) material{0} 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) material{0} 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) material{0} 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) material{0} 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) material{0} 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) material{0} 0 0 0 1 1
+}}
+)",
+        i);
+    }
+    expected += "}\n";
+
+    CHECK(str.str() == expected);
+
+    // each brush takes 9 lines, starting at the line after its comment
+    CHECK(brushNodes.front()->lineNumber() == 5);
+    CHECK(brushNodes.back()->lineNumber() == 5 + (brushCount - 1) * 9);
+  }
+
+  SECTION("writeManySmallBrushEntities")
+  {
+    // more brushes than the serializer precomputes at once, spread over many entities
+    const auto entityCount = size_t(3000);
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+    auto entityNodes = std::vector<mdl::EntityNode*>{};
+    for (size_t i = 0; i < entityCount; ++i)
+    {
+      auto* entityNode =
+        new mdl::EntityNode{mdl::Entity{{{"classname", fmt::format("func_{}", i)}}}};
+      entityNode->addChildren({
+        new mdl::BrushNode{builder.createCube(64.0, "a") | kdl::value()},
+        new mdl::BrushNode{builder.createCube(64.0, "b") | kdl::value()},
+      });
+      map.defaultLayer()->addChild(entityNode);
+      entityNodes.push_back(entityNode);
+    }
+
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.writeMap(taskManager);
+
+    auto expected = std::string{R"(// entity 0
+{
+"classname" "worldspawn"
+}
+)"};
+    for (size_t i = 0; i < entityCount; ++i)
+    {
+      expected += fmt::format(
+        R"(// entity {0}
+{{
+"classname" "func_{1}"
+// brush 0
+{{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) a 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) a 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) a 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) a 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) a 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) a 0 0 0 1 1
+}}
+// brush 1
+{{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) b 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) b 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) b 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) b 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) b 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) b 0 0 0 1 1
+}}
+}}
+)",
+        i + 1,
+        i);
+    }
+
+    CHECK(str.str() == expected);
+
+    // the worldspawn takes 4 lines and each entity takes 22 lines, starting at the line
+    // after its comment
+    CHECK(entityNodes.front()->lineNumber() == 6);
+    CHECK(entityNodes.front()->containsLine(26));
+    CHECK_FALSE(entityNodes.front()->containsLine(27));
+    CHECK(entityNodes.back()->lineNumber() == 6 + (entityCount - 1) * 22);
+  }
+
   SECTION("writeWorldspawnWithBrushInCustomLayer")
   {
     const auto worldBounds = vm::bbox3d{8192.0};
@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/NumberFormat.h"
+
+#include <fmt/format.h>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::io
+{
+namespace
+{
+
+template <typename T>
+std::string format(const T value)
+{
+  auto buffer = std::string{};
+  appendNumber(buffer, value);
+  return buffer;
+}
+
+} // namespace
+
+TEST_CASE("appendNumber")
+{
+  SECTION("Appends to the buffer")
+  {
+    auto buffer = std::string{"( "};
+    appendNumber(buffer, 32.0);
+    buffer.append(" ");
+    appendNumber(buffer, -0.5f);
+    buffer.append(" ");
+    appendNumber(buffer, 7);
+    CHECK(buffer == "( 32 -0.5 7");
+  }
+
+  SECTION("int")
+  {
+    const auto value = GENERATE(
+      0,
+      1,
+      -1,
+      1234567,
+      std::numeric_limits<int>::max(),
+      std::numeric_limits<int>::min());
+
+    CAPTURE(value);
+    CHECK(format(value) == fmt::format("{}", value));
+  }
+
+  SECTION("double")
+  {
+    const auto value = GENERATE(
+      0.0,
+      -0.0,
+      1.0,
+      -32.0,
+      8192.0,
+      0.5,
+      0.1,
+      1.0 / 3.0,
+      -1234.5678,
+      0.0001,
+      0.00001,
+      123.456e-10,
+      1e15,
+      1e16,
+      9999999999999998.0,
+      1.5e20,
+      123456789012345680000.0,
+      std::numeric_limits<double>::min(),
+      std::numeric_limits<double>::denorm_min(),
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN());
+
+    CAPTURE(value);
+    CHECK(format(value) == fmt::format("{}", value));
+  }
+
+  SECTION("float")
+  {
+    const auto value = GENERATE(
+      0.0f,
+      -0.0f,
+      1.0f,
+      -32.0f,
+      0.5f,
+      0.1f,
+      1.0f / 3.0f,
+      0.0001f,
+      0.00001f,
+      1234567.0f,
+      1e7f,
+      12345678.0f,
+      1e20f,
+      std::numeric_limits<float>::min(),
+      std::numeric_limits<float>::denorm_min(),
+      std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::quiet_NaN());
+
+    CAPTURE(value);
+    CHECK(format(value) == fmt::format("{}", value));
+  }
+
+  SECTION("Random values")
+  {
+    auto rng = std::mt19937_64{};
+    auto coords = std::uniform_real_distribution<double>{-8192.0, 8192.0};
+
+    for (size_t i = 0; i < 100000; ++i)
+    {
+      const auto d = std::bit_cast<double>(rng());
+      const auto f = std::bit_cast<float>(static_cast<std::uint32_t>(rng()));
+      const auto c = coords(rng);
+
+      if (std::isfinite(d))
+      {
+        REQUIRE(format(d) == fmt::format("{}", d));
+      }
+      if (std::isfinite(f))
+      {
+        REQUIRE(format(f) == fmt::format("{}", f));
+      }
+      REQUIRE(format(c) == fmt::format("{}", c));
+      REQUIRE(format(std::round(c)) == fmt::format("{}", std::round(c)));
+      REQUIRE(format(static_cast<float>(c)) == fmt::format("{}", static_cast<float>(c)));
+    }
+  }
+}
+
+} // namespace tb::io
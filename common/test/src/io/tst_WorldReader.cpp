@@ -40,19 +40,110 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <string>
+#include <variant>
 
 #include "catch/CatchConfig.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 namespace tb::io
 {
 using namespace Catch::Matchers;
 
+namespace
+{
+
+/**
+ * Appends a cuboid brush in standard format to the given string. Every brush spans 8
+ * lines.
+ */
+void appendBrush(std::string& str, const size_t i)
+{
+  const auto x = double(i % 256) * 16.0;
+  const auto y = double(i / 256 % 256) * 16.0;
+  const auto z = double(i / 65536) * 16.0;
+
+  str += fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {7} {2} ) ( {0} {1} {8} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {1} {8} ) ( {6} {1} {2} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {6} {1} {2} ) ( {0} {7} {2} ) tex 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {10} {5} ) ( {9} {4} {5} ) tex 0 0 0 1 1
+( {3} {4} {5} ) ( {9} {4} {5} ) ( {3} {4} {11} ) tex 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {4} {11} ) ( {3} {10} {5} ) tex 0 0 0 1 1
+}}
+)",
+    x,
+    y,
+    z,
+    x + 8.0,
+    y + 8.0,
+    z + 8.0,
+    x + 1.0,
+    y + 1.0,
+    z + 1.0,
+    x + 9.0,
+    y + 9.0,
+    z + 9.0);
+}
+
+/**
+ * Creates a map with a worldspawn entity containing the given number of brushes, followed
+ * by the given number of brush entities with the given number of brushes each.
+ */
+std::string makeLargeMap(
+  const size_t worldBrushCount,
+  const size_t entityCount,
+  const size_t entityBrushCount)
+{
+  auto str = std::string{};
+  auto brushIndex = size_t(0);
+
+  str += "{\n\"classname\" \"worldspawn\"\n";
+  for (size_t i = 0; i < worldBrushCount; ++i)
+  {
+    appendBrush(str, brushIndex++);
+  }
+  str += "}\n";
+
+  for (size_t i = 0; i < entityCount; ++i)
+  {
+    str += "{\n\"classname\" \"func_detail\"\n";
+    for (size_t j = 0; j < entityBrushCount; ++j)
+    {
+      appendBrush(str, brushIndex++);
+    }
+    str += "}\n";
+  }
+
+  return str;
+}
+
+/**
+ * Replaces the first face line of the brush with the given index in the given map.
+ */
+void replaceFirstFace(std::string& str, const size_t brushIndex, const std::string& face)
+{
+  auto brush = std::string{};
+  appendBrush(brush, brushIndex);
+
+  const auto brushBegin = str.find(brush);
+  REQUIRE(brushBegin != std::string::npos);
+
+  const auto faceBegin = str.find('\n', brushBegin) + 1;
+  const auto faceEnd = str.find('\n', faceBegin);
+  str.replace(faceBegin, faceEnd - faceBegin, face);
+}
+
+} // namespace
+
 TEST_CASE("WorldReader")
 {
   using namespace std::string_literals;
@@ -1938,6 +2029,148 @@ common/caulk
   }
 }
 
+TEST_CASE("WorldReader (Parallel parsing)")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  // large enough to be split into several chunks, including chunks that start inside of
+  // worldspawn and inside of a brush entity
+  const auto worldBrushCount = size_t(2000);
+  const auto entityCount = size_t(20);
+  const auto entityBrushCount = size_t(200);
+  const auto data = makeLargeMap(worldBrushCount, entityCount, entityBrushCount);
+
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  auto worldResult = reader.read(worldBounds, status, taskManager);
+  REQUIRE(worldResult);
+
+  const auto& world = worldResult.value();
+  REQUIRE(world->childCount() == 1u);
+
+  auto* defaultLayer = world->children().front();
+  REQUIRE(defaultLayer->childCount() == worldBrushCount + entityCount);
+
+  const auto& children = defaultLayer->children();
+  for (size_t i = 0; i < worldBrushCount; ++i)
+  {
+    const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(children[i]);
+    REQUIRE(brushNode != nullptr);
+    CHECK(brushNode->lineNumber() == 3 + i * 8);
+  }
+
+  for (size_t i = 0; i < entityCount; ++i)
+  {
+    const auto* entityNode =
+      dynamic_cast<const mdl::EntityNode*>(children[worldBrushCount + i]);
+    REQUIRE(entityNode != nullptr);
+    CHECK(entityNode->entity().classname() == "func_detail");
+    CHECK(entityNode->childCount() == entityBrushCount);
+
+    const auto entityLine = 4 + worldBrushCount * 8 + i * (3 + entityBrushCount * 8);
+    CHECK(entityNode->lineNumber() == entityLine);
+    CHECK(
+      entityNode->children().back()->lineNumber()
+      == entityLine + 2 + (entityBrushCount - 1) * 8);
+  }
+
+  const auto& progress = status.progressValues();
+  CHECK(progress.size() > 1);
+  CHECK(std::ranges::is_sorted(progress));
+  CHECK(progress.back() == 1.0);
+}
+
+TEST_CASE("WorldReader (Parallel parsing error locations)")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  const auto worldBrushCount = size_t(2000);
+  const auto entityCount = size_t(20);
+  const auto entityBrushCount = size_t(200);
+  auto data = makeLargeMap(worldBrushCount, entityCount, entityBrushCount);
+
+  // invalid faces in a worldspawn brush and in a brush of a brush entity, both far
+  // away from the first chunk
+  const auto worldBrushIndex = size_t(1500);
+  const auto entityIndex = size_t(15);
+  const auto entityBrushIndex = size_t(100);
+  replaceFirstFace(data, worldBrushIndex, "( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) tex 0 0 0 1 1");
+  replaceFirstFace(
+    data,
+    worldBrushCount + entityIndex * entityBrushCount + entityBrushIndex,
+    "( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) tex 0 0 0 1 1");
+
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  auto worldResult = reader.read(worldBounds, status, taskManager);
+  REQUIRE(worldResult);
+  CHECK(status.progressValues().size() > 1);
+
+  // invalid faces are reported at the line where their brush begins, as in serial
+  // parsing
+  const auto worldBrushLine = 3 + worldBrushIndex * 8;
+  const auto entityBrushLine = 4 + worldBrushCount * 8
+                               + entityIndex * (3 + entityBrushCount * 8) + 2
+                               + entityBrushIndex * 8;
+
+  const auto& errors = status.messages(LogLevel::Error);
+  REQUIRE(errors.size() >= 2);
+  CHECK_THAT(errors[0], ContainsSubstring("Skipping face"));
+  CHECK_THAT(errors[0], ContainsSubstring(fmt::format("line: {},", worldBrushLine)));
+  CHECK_THAT(errors[1], ContainsSubstring("Skipping face"));
+  CHECK_THAT(errors[1], ContainsSubstring(fmt::format("line: {},", entityBrushLine)));
+}
+
+TEST_CASE("WorldReader (Parallel parsing falls back to serial parsing)")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  const auto worldBrushCount = size_t(2000);
+  auto data = makeLargeMap(worldBrushCount, 20, 200);
+
+  // a syntax error makes the chunk fail to parse
+  const auto brushIndex = size_t(1500);
+  replaceFirstFace(data, brushIndex, "( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 tex 0 0 0 1 1");
+
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  const auto worldResult = reader.read(worldBounds, status, taskManager);
+  REQUIRE(worldResult.is_error());
+
+  // the error is returned by the serial parser, and nothing that the parallel parser
+  // found before it failed is reported
+  const auto faceLine = 3 + brushIndex * 8 + 1;
+  CHECK_THAT(
+    std::get<Error>(worldResult.error()).msg,
+    ContainsSubstring(fmt::format("At line {},", faceLine)));
+  CHECK(status.countStatus(LogLevel::Error) == 0);
+}
+
+TEST_CASE("WorldReader (Benchmark)", "[.][benchmark]")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  const auto data = makeLargeMap(500000, 500, 1000);
+
+  const auto start = std::chrono::steady_clock::now();
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  auto worldResult = reader.read(worldBounds, status, taskManager);
+  const auto end = std::chrono::steady_clock::now();
+  REQUIRE(worldResult);
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  WARN(fmt::format(
+    "Read {} MB containing 1000000 brushes in {:.2f}s ({:.2f} MB/s)",
+    data.size() / 1024 / 1024,
+    seconds,
+    double(data.size()) / 1024.0 / 1024.0 / seconds));
+}
+
 TEST_CASE("WorldReader (Regression)", "[regression]")
 {
   auto taskManager = kdl::task_manager{};
@@ -341,6 +341,39 @@ TEST_CASE("Brush")
           })
           .is_error());
     }
+
+    SECTION("With topology")
+    {
+      const auto worldBounds = vm::bbox3d{4096.0};
+
+      const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+      const auto original =
+        brushBuilder.createCube(64.0, "left", "right", "front", "back", "top", "bottom")
+        | kdl::value();
+
+      const auto brush =
+        Brush::createFromTopology(worldBounds, original.faces(), original.topology())
+        | kdl::value();
+      CHECK(brush == original);
+      CHECK(brush.bounds() == original.bounds());
+      CHECK(brush.topology() == original.topology());
+      CHECK(brush.vertexPositions() == original.vertexPositions());
+
+      for (size_t i = 0; i < brush.faceCount(); ++i)
+      {
+        CHECK(brush.face(i).vertexPositions() == original.face(i).vertexPositions());
+      }
+
+      auto tooFewFaces = original.faces();
+      tooFewFaces.pop_back();
+      CHECK(Brush::createFromTopology(worldBounds, tooFewFaces, original.topology())
+              .is_error());
+
+      const auto smallWorldBounds = vm::bbox3d{16.0};
+      CHECK(
+        Brush::createFromTopology(smallWorldBounds, original.faces(), original.topology())
+          .is_error());
+    }
   }
 
   SECTION("cloneFaceAttributesFrom")
@@ -2467,6 +2500,38 @@ TEST_CASE("Brush")
         | kdl::value();
       CHECK(fragments.empty());
     }
+
+    SECTION("Subtract disjoint and overlapping brushes")
+    {
+      const auto worldBounds = vm::bbox3d{4096.0};
+
+      auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+      const auto minuend =
+        builder.createCuboid(vm::bbox3d{{-8, -8, -8}, {8, 8, 8}}, "material")
+        | kdl::value();
+      const auto overlapping =
+        builder.createCuboid(vm::bbox3d{{0, -16, -16}, {16, 16, 16}}, "material")
+        | kdl::value();
+      const auto disjoint =
+        builder.createCuboid(vm::bbox3d{{124, 124, -4}, {132, 132, +4}}, "material")
+        | kdl::value();
+
+      const auto expected =
+        minuend.subtract(MapFormat::Standard, worldBounds, "material", overlapping)
+        | kdl::fold | kdl::value();
+      REQUIRE(expected.size() == 1u);
+
+      const auto fragments = minuend.subtract(
+                               MapFormat::Standard,
+                               worldBounds,
+                               "material",
+                               {&disjoint, &overlapping, &disjoint})
+                             | kdl::fold | kdl::value();
+      REQUIRE(fragments.size() == 1u);
+      CHECK_THAT(
+        fragments.front().vertexPositions(),
+        UnorderedEquals(expected.front().vertexPositions()));
+    }
   }
 }
 
@@ -37,13 +37,18 @@
 #include "kd/result.h"
 
 #include "vm/approx.h"
+#include "vm/mat_ext.h"
+#include "vm/ray.h"
 
+#include <cmath>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "catch/CatchConfig.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -289,6 +294,24 @@ TEST_CASE("BrushNode")
     auto hits2 = PickResult{};
     brush.pick(editorContext, vm::ray3d({8, -8, 8}, {0, -1, 0}), hits2);
     CHECK(hits2.empty());
+
+    // a ray that runs along the edge between the left and the front face
+    auto hits3 = PickResult{};
+    brush.pick(editorContext, vm::ray3d({0, 0, 24}, {0, 0, -1}), hits3);
+    CHECK(hits3.size() == 1u);
+    CHECK(hits3.all().front().distance() == vm::approx(8.0));
+
+    // a ray that passes through the edge between the left and the top face
+    auto hits4 = PickResult{};
+    brush.pick(
+      editorContext, vm::ray3d({-8, 8, 24}, vm::normalize(vm::vec3d{1, 0, -1})), hits4);
+    CHECK(hits4.size() == 1u);
+    CHECK(hits4.all().front().distance() == vm::approx(std::sqrt(128.0)));
+
+    // a ray that passes just above the top face
+    auto hits5 = PickResult{};
+    brush.pick(editorContext, vm::ray3d({-8, 8, 16.01}, {1, 0, 0}), hits5);
+    CHECK(hits5.empty());
   }
 
   SECTION("clone")
@@ -860,4 +883,63 @@ TEST_CASE("BrushNode (Regression)", "[regression]")
   }
 }
 
+TEST_CASE("BrushNode (Benchmark)", "[.][benchmark]")
+{
+  const auto brushCount = size_t(1000);
+  const auto rayCount = size_t(1000);
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto editorContext = EditorContext{};
+
+  auto rng = std::mt19937{42};
+  auto coordDist = std::uniform_real_distribution<double>{-1024.0, 1024.0};
+  auto sizeDist = std::uniform_real_distribution<double>{8.0, 128.0};
+  auto angleDist = std::uniform_real_distribution<double>{0.0, 360.0};
+
+  const auto brushBuilder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brushNodes = std::vector<std::unique_ptr<BrushNode>>{};
+  brushNodes.reserve(brushCount);
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    const auto size = vm::vec3d{sizeDist(rng), sizeDist(rng), sizeDist(rng)};
+    const auto bounds = vm::bbox3d{-size, size};
+    auto brush = (i % 2 == 0 ? brushBuilder.createCuboid(bounds, "material")
+                             : brushBuilder.createCylinder(
+                                 bounds, EdgeAlignedCircle{8}, vm::axis::z, "material"))
+                 | kdl::value();
+
+    const auto transform =
+      vm::translation_matrix(vm::vec3d{coordDist(rng), coordDist(rng), coordDist(rng)})
+      * vm::rotation_matrix(
+        vm::to_radians(angleDist(rng)),
+        vm::to_radians(angleDist(rng)),
+        vm::to_radians(angleDist(rng)));
+    REQUIRE(brush.transform(worldBounds, transform, false));
+
+    brushNodes.push_back(std::make_unique<BrushNode>(std::move(brush)));
+  }
+
+  auto rays = std::vector<vm::ray3d>{};
+  rays.reserve(rayCount);
+  for (size_t i = 0; i < rayCount; ++i)
+  {
+    const auto origin = vm::vec3d{coordDist(rng), coordDist(rng), coordDist(rng)};
+    const auto target = vm::vec3d{coordDist(rng), coordDist(rng), coordDist(rng)};
+    rays.emplace_back(origin, vm::normalize(target - origin));
+  }
+
+  BENCHMARK("Random rays")
+  {
+    auto pickResult = PickResult{};
+    for (const auto& ray : rays)
+    {
+      for (const auto& brushNode : brushNodes)
+      {
+        brushNode->pick(editorContext, ray, pickResult);
+      }
+    }
+    return pickResult.size();
+  };
+}
+
 } // namespace tb::mdl
@@ -210,6 +210,24 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty(EntityPropertyKeys::Spawnflags, "1");
     CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.addOrUpdateProperty("target", "some_target");
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.renameProperty(EntityPropertyKeys::Spawnflags, "some_key");
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+    entity.renameProperty("some_key", EntityPropertyKeys::Spawnflags);
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.removeProperty(EntityPropertyKeys::Spawnflags);
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+    entity.setProperties({{EntityPropertyKeys::Spawnflags, "2"}});
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+
+    entity.unsetEntityDefinitionAndModel();
+    CHECK(entity.modelSpecification() == ModelSpecification{});
   }
 
   SECTION("decalSpecification")
@@ -235,6 +253,15 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty("texture", "decal1");
     CHECK(entity.decalSpecification() == DecalSpecification{"decal1"});
+
+    entity.addOrUpdateProperty("target", "some_target");
+    CHECK(entity.decalSpecification() == DecalSpecification{"decal1"});
+
+    entity.addOrUpdateProperty("texture", "decal2");
+    CHECK(entity.decalSpecification() == DecalSpecification{"decal2"});
+
+    entity.removeProperty("texture");
+    CHECK(entity.decalSpecification() == DecalSpecification{""});
   }
 
   SECTION("unsetEntityDefinitionAndModel")
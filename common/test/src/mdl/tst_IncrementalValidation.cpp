@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EmptyGroupValidator.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/IncrementalValidation.h"
+#include "mdl/Issue.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldBoundsValidator.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/mat_ext.h"
+
+#include <memory>
+#include <vector>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+namespace
+{
+
+std::vector<const Issue*> collectIssues(WorldNode& worldNode)
+{
+  const auto validators = worldNode.registeredValidators();
+
+  auto result = std::vector<const Issue*>{};
+  const auto collect = [&](auto* node) {
+    for (const auto* issue : node->issues(validators))
+    {
+      result.push_back(issue);
+    }
+  };
+
+  collect(&worldNode);
+  worldNode.accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) {
+      collect(layer);
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, GroupNode* group) {
+      collect(group);
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      collect(entity);
+      entity->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brush) { collect(brush); },
+    [&](PatchNode* patch) { collect(patch); }));
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("IncrementalValidation")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Quake3};
+  worldNode.registerValidator(std::make_unique<EmptyGroupValidator>());
+  worldNode.registerValidator(std::make_unique<MissingClassnameValidator>());
+  worldNode.registerValidator(
+    std::make_unique<WorldBoundsValidator>(vm::bbox3d{1024.0}));
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    // issues: empty group
+    worldNode.defaultLayer()->addChild(new GroupNode{Group{"group"}});
+
+    // issues: missing classname
+    worldNode.defaultLayer()->addChild(new EntityNode{Entity{}});
+
+    // issues: out of world bounds for every other brush
+    auto* brushNode =
+      new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+    if (i % 2 == 0)
+    {
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3d{2048, 0, 0}), worldBounds);
+    }
+    worldNode.defaultLayer()->addChild(brushNode);
+  }
+
+  auto taskManager = kdl::task_manager{4};
+  auto validation = IncrementalValidation{worldNode, taskManager};
+
+  // world, default layer and 300 objects
+  CHECK(validation.nodeCount() == 302);
+  CHECK(validation.validatedNodeCount() == 0);
+  CHECK_FALSE(validation.done());
+
+  auto issues = std::vector<const Issue*>{};
+  while (!validation.done())
+  {
+    const auto validatedNodeCount = validation.validatedNodeCount();
+    for (const auto* issue : validation.validateNext(32))
+    {
+      issues.push_back(issue);
+    }
+    CHECK(validation.validatedNodeCount() - validatedNodeCount <= 32);
+  }
+
+  CHECK(validation.validatedNodeCount() == 302);
+  CHECK(issues.size() == 250);
+
+  // validated nodes keep their issues
+  CHECK_THAT(issues, Equals(collectIssues(worldNode)));
+
+  SECTION("Validating again returns the same issues")
+  {
+    auto revalidation = IncrementalValidation{worldNode, taskManager};
+    CHECK_THAT(revalidation.validateNext(1000), Equals(issues));
+    CHECK(revalidation.done());
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapFixture.h"
+#include "TestFactory.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Map.h"
+#include "mdl/Map_Brushes.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/MaterialIndex.h"
+#include "mdl/ModelUtils.h"
+#include "mdl/SelectionChange.h"
+#include "mdl/UpdateBrushFaceAttributes.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/ranges/to.h"
+
+#include <ranges>
+#include <vector>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("Map_MaterialIndex")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.map();
+
+  fixture.create();
+
+  const auto& index = map.materialIndex();
+
+  auto* brushNode = createBrushNode(map, "material1");
+  auto* groupNode = new GroupNode{Group{"group"}};
+  groupNode->addChild(brushNode);
+
+  SECTION("adding nodes updates the index")
+  {
+    addNodes(map, {{parentForNodes(map), {groupNode}}});
+
+    CHECK(index.findBrushNodes("material1") == std::vector<BrushNode*>{brushNode});
+  }
+
+  SECTION("removing nodes updates the index")
+  {
+    addNodes(map, {{parentForNodes(map), {groupNode}}});
+    REQUIRE(index.findBrushNodes("material1") == std::vector<BrushNode*>{brushNode});
+
+    removeNodes(map, {groupNode});
+
+    CHECK(index.findBrushNodes("material1").empty());
+  }
+
+  SECTION("changing face attributes updates the index")
+  {
+    addNodes(map, {{parentForNodes(map), {groupNode}}});
+    selectBrushFaces(map, {{brushNode, 0}});
+
+    setBrushFaceAttributes(map, {.materialName = "material2"});
+
+    CHECK(
+      index.findBrushFaces("material2") == std::vector<BrushFaceHandle>{{brushNode, 0}});
+    CHECK(index.findBrushFaces("material1").size() == brushNode->brush().faceCount() - 1);
+
+    map.undoCommand();
+
+    CHECK(index.findBrushFaces("material2").empty());
+    CHECK(index.findBrushFaces("material1").size() == brushNode->brush().faceCount());
+  }
+
+  SECTION("faces with a material are selected in traversal order")
+  {
+    auto nodes = std::vector<Node*>{groupNode};
+    for (size_t i = 0; i < 20; ++i)
+    {
+      nodes.push_back(createBrushNode(map, "material1"));
+    }
+    addNodes(map, {{parentForNodes(map), nodes}});
+
+    auto selectedBrushFaces = std::vector<BrushFaceHandle>{};
+    auto connection = map.selectionDidChangeNotifier.connect(
+      [&](const auto& change) { selectedBrushFaces = change.selectedBrushFaces; });
+
+    selectBrushFacesWithMaterial(map, "material1");
+
+    // the faces of the brush in the closed group are not selectable
+    const auto expectedBrushFaces =
+      collectSelectableBrushFaces(std::vector<Node*>{map.world()}, map.editorContext())
+      | std::views::filter([](const auto& h) {
+          return h.face().attributes().materialName() == "material1";
+        })
+      | kdl::ranges::to<std::vector>();
+    REQUIRE(expectedBrushFaces.size() == 20 * brushNode->brush().faceCount());
+
+    CHECK(selectedBrushFaces == expectedBrushFaces);
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Material.h"
+#include "mdl/MaterialIndex.h"
+#include "mdl/Texture.h"
+
+#include "kd/result.h"
+
+#include <vector>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+namespace
+{
+
+std::vector<BrushFaceHandle> toHandles(
+  std::vector<BrushFaceHandle> result, BrushNode& brushNode, std::vector<size_t> indices)
+{
+  for (const auto i : indices)
+  {
+    result.emplace_back(&brushNode, i);
+  }
+  return result;
+}
+
+std::vector<BrushFaceHandle> toHandles(BrushNode& brushNode, std::vector<size_t> indices)
+{
+  return toHandles({}, brushNode, std::move(indices));
+}
+
+} // namespace
+
+TEST_CASE("MaterialIndex")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder.createCube(64.0, "material1") | kdl::value();
+  for (size_t i = 0; i < 2; ++i)
+  {
+    auto attributes = brush.face(i).attributes();
+    attributes.setMaterialName("Material2");
+    brush.face(i).setAttributes(attributes);
+  }
+
+  auto brushNode1 = BrushNode{std::move(brush)};
+  auto brushNode2 = BrushNode{builder.createCube(64.0, "material2") | kdl::value()};
+  auto entityNode = EntityNode{Entity{}};
+
+  auto i = MaterialIndex{};
+  i.addNode(brushNode1);
+  i.addNode(brushNode2);
+  i.addNode(entityNode);
+
+  SECTION("findBrushFaces")
+  {
+    CHECK_THAT(
+      i.findBrushFaces("material1"),
+      UnorderedEquals(toHandles(brushNode1, {2, 3, 4, 5})));
+    CHECK_THAT(
+      i.findBrushFaces("material2"),
+      UnorderedEquals(toHandles(
+        toHandles(brushNode1, {0, 1}), brushNode2, {0, 1, 2, 3, 4, 5})));
+    CHECK_THAT(
+      i.findBrushFaces("MATERIAL1"),
+      UnorderedEquals(toHandles(brushNode1, {2, 3, 4, 5})));
+    CHECK(i.findBrushFaces("material3").empty());
+  }
+
+  SECTION("findBrushNodes")
+  {
+    CHECK(i.findBrushNodes("material1") == std::vector<BrushNode*>{&brushNode1});
+    CHECK_THAT(
+      i.findBrushNodes("material2"),
+      UnorderedEquals(std::vector<BrushNode*>{&brushNode1, &brushNode2}));
+    CHECK(i.findBrushNodes("material3").empty());
+  }
+
+  SECTION("findBrushNodes with materials")
+  {
+    const auto material1 = Material{"material1", createTextureResource(Texture{64, 64})};
+    const auto material2 = Material{"MATERIAL2", createTextureResource(Texture{64, 64})};
+    const auto material3 = Material{"material3", createTextureResource(Texture{64, 64})};
+
+    CHECK(i.findBrushNodes({&material1}) == std::vector<BrushNode*>{&brushNode1});
+    CHECK_THAT(
+      i.findBrushNodes({&material1, &material2}),
+      UnorderedEquals(std::vector<BrushNode*>{&brushNode1, &brushNode2}));
+    CHECK(i.findBrushNodes({&material3}).empty());
+  }
+
+  SECTION("removeNode")
+  {
+    i.removeNode(brushNode1);
+
+    CHECK(i.findBrushFaces("material1").empty());
+    CHECK_THAT(
+      i.findBrushFaces("material2"),
+      UnorderedEquals(toHandles(brushNode2, {0, 1, 2, 3, 4, 5})));
+
+    i.removeNode(brushNode2);
+    CHECK(i.findBrushFaces("material2").empty());
+  }
+
+  SECTION("clear")
+  {
+    i.clear();
+
+    CHECK(i.findBrushNodes("material1").empty());
+    CHECK(i.findBrushNodes("material2").empty());
+  }
+}
+
+} // namespace tb::mdl
@@ -38,12 +38,14 @@
 #include "mdl/WorldNode.h"
 
 #include "kd/result.h"
+#include "kd/task_manager.h"
 
 #include "vm/bbox.h"
 #include "vm/mat_ext.h"
 
 #include "catch/CatchConfig.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
@@ -331,6 +333,131 @@ TEST_CASE("ModelUtils.collectContainedNodes")
     Equals(std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectMatchingNodes with spatial index")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto brushBuilder = BrushBuilder{mapFormat, worldBounds};
+  const auto createBrushNode = [&](const double size, const vm::vec3d& center) {
+    auto* brushNode =
+      new BrushNode{brushBuilder.createCube(size, "material") | kdl::value()};
+    transformNode(*brushNode, vm::translation_matrix(center), worldBounds);
+    return brushNode;
+  };
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto* brushNode = createBrushNode(64.0, {0, 0, 0});
+  auto* farBrushNode = createBrushNode(64.0, {1024, 0, 0});
+
+  // the group's bounds contain the origin, but none of its children do
+  auto* groupNode = new GroupNode{Group{"group"}};
+  groupNode->addChild(createBrushNode(32.0, {-256, 0, 0}));
+  groupNode->addChild(createBrushNode(32.0, {256, 0, 0}));
+
+  worldNode.defaultLayer()->addChildren({brushNode, farBrushNode, groupNode});
+
+  auto touchesOrigin =
+    BrushNode{brushBuilder.createCube(24.0, "material") | kdl::value()};
+  auto containsOrigin =
+    BrushNode{brushBuilder.createCube(128.0, "material") | kdl::value()};
+  auto containsAll =
+    BrushNode{brushBuilder.createCube(4096.0, "material") | kdl::value()};
+
+  auto taskManager = kdl::task_manager{4};
+
+  CHECK_THAT(
+    collectTouchingNodes(worldNode, {&touchesOrigin}, taskManager),
+    UnorderedEquals(std::vector<Node*>{brushNode, groupNode}));
+  CHECK_THAT(
+    collectContainedNodes(worldNode, {&containsOrigin}, taskManager),
+    UnorderedEquals(std::vector<Node*>{brushNode}));
+  CHECK_THAT(
+    collectContainedNodes(worldNode, {&containsOrigin, &containsAll}, taskManager),
+    UnorderedEquals(std::vector<Node*>{brushNode, farBrushNode, groupNode}));
+
+  for (auto* queryNode : {&touchesOrigin, &containsOrigin, &containsAll})
+  {
+    CHECK_THAT(
+      collectTouchingNodes(worldNode, {queryNode}, taskManager),
+      UnorderedEquals(collectTouchingNodes({&worldNode}, {queryNode})));
+    CHECK_THAT(
+      collectContainedNodes(worldNode, {queryNode}, taskManager),
+      UnorderedEquals(collectContainedNodes({&worldNode}, {queryNode})));
+  }
+
+  SECTION("Many nodes")
+  {
+    for (int x = -16; x < 16; ++x)
+    {
+      for (int y = -16; y < 16; ++y)
+      {
+        worldNode.defaultLayer()->addChild(
+          createBrushNode(16.0, vm::vec3d{double(x), double(y), 2.0} * 24.0));
+      }
+    }
+
+    auto touchesMany =
+      BrushNode{brushBuilder.createCube(300.0, "material") | kdl::value()};
+
+    for (auto* queryNode : {&touchesMany, &containsOrigin, &containsAll})
+    {
+      CHECK_THAT(
+        collectTouchingNodes(worldNode, {queryNode}, taskManager),
+        UnorderedEquals(collectTouchingNodes({&worldNode}, {queryNode})));
+      CHECK_THAT(
+        collectContainedNodes(worldNode, {queryNode}, taskManager),
+        UnorderedEquals(collectContainedNodes({&worldNode}, {queryNode})));
+    }
+  }
+
+  SECTION("Nested groups and entities")
+  {
+    auto* outerGroupNode = new GroupNode{Group{"outer"}};
+    auto* innerGroupNode = new GroupNode{Group{"inner"}};
+    auto* innerBrushNode = createBrushNode(16.0, {8, 8, 8});
+    auto* outerBrushNode = createBrushNode(16.0, {-8, -8, -8});
+    innerGroupNode->addChild(innerBrushNode);
+    outerGroupNode->addChildren({innerGroupNode, outerBrushNode});
+
+    auto* pointEntityNode = new EntityNode{Entity{}};
+    auto* brushEntityNode = new EntityNode{Entity{}};
+    auto* entityBrushNode = createBrushNode(16.0, {0, 8, 0});
+    brushEntityNode->addChild(entityBrushNode);
+
+    worldNode.defaultLayer()->addChildren(
+      {outerGroupNode, pointEntityNode, brushEntityNode});
+
+    CHECK_THAT(
+      collectTouchingNodes(worldNode, {&touchesOrigin}, taskManager),
+      UnorderedEquals(std::vector<Node*>{
+        brushNode, groupNode, outerGroupNode, pointEntityNode, entityBrushNode}));
+
+    outerGroupNode->open();
+
+    CHECK_THAT(
+      collectTouchingNodes(worldNode, {&touchesOrigin}, taskManager),
+      UnorderedEquals(std::vector<Node*>{
+        brushNode,
+        groupNode,
+        innerGroupNode,
+        outerBrushNode,
+        pointEntityNode,
+        entityBrushNode}));
+
+    for (auto* queryNode : {&touchesOrigin, &containsOrigin, &containsAll})
+    {
+      CHECK_THAT(
+        collectTouchingNodes(worldNode, {queryNode}, taskManager),
+        UnorderedEquals(collectTouchingNodes({&worldNode}, {queryNode})));
+      CHECK_THAT(
+        collectContainedNodes(worldNode, {queryNode}, taskManager),
+        UnorderedEquals(collectContainedNodes({&worldNode}, {queryNode})));
+    }
+  }
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -636,4 +763,54 @@ TEST_CASE("ModelUtils.filterNodes")
   }
 }
 
+TEST_CASE("ModelUtils (Benchmark)", "[.][benchmark]")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto brushBuilder = BrushBuilder{mapFormat, worldBounds};
+  const auto createBrushNode = [&](const double size, const vm::vec3d& center) {
+    auto* brushNode =
+      new BrushNode{brushBuilder.createCube(size, "material") | kdl::value()};
+    transformNode(*brushNode, vm::translation_matrix(center), worldBounds);
+    return brushNode;
+  };
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  for (int x = -50; x < 50; ++x)
+  {
+    for (int y = -50; y < 50; ++y)
+    {
+      for (int z = 0; z < 4; ++z)
+      {
+        worldNode.defaultLayer()->addChild(
+          createBrushNode(16.0, vm::vec3d{double(x), double(y), double(z)} * 32.0));
+      }
+    }
+  }
+
+  auto queryNode = BrushNode{brushBuilder.createCube(256.0, "material") | kdl::value()};
+  auto taskManager = kdl::task_manager{};
+
+  BENCHMARK("Touching nodes by traversal")
+  {
+    return collectTouchingNodes({&worldNode}, {&queryNode}).size();
+  };
+
+  BENCHMARK("Touching nodes by node tree")
+  {
+    return collectTouchingNodes(worldNode, {&queryNode}, taskManager).size();
+  };
+
+  BENCHMARK("Contained nodes by traversal")
+  {
+    return collectContainedNodes({&worldNode}, {&queryNode}).size();
+  };
+
+  BENCHMARK("Contained nodes by node tree")
+  {
+    return collectContainedNodes(worldNode, {&queryNode}, taskManager).size();
+  };
+}
+
 } // namespace tb::mdl
@@ -210,6 +210,49 @@ TEST_CASE("NodeIndex")
     i.clear();
 
     CHECK_THAT(i.findNodes("some_key"), UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(i.findNodes("*some_key*"), UnorderedEquals(std::vector<Node*>{}));
+  }
+
+  SECTION("Patterns starting with a wildcard")
+  {
+    auto entityNode1 = EntityNode{Entity{{
+      {"some_key", "a_value"},
+      {"some_other_key", "another_value"},
+    }}};
+    auto entityNode2 = EntityNode{Entity{{
+      {"some_yet_other_key", "yet_another_value"},
+    }}};
+    auto groupNode = GroupNode{Group{"some_group"}};
+
+    i.addNode(entityNode1);
+    i.addNode(entityNode2);
+    i.addNode(groupNode);
+
+    CHECK_THAT(
+      i.findNodes("*other*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(
+      i.findNodes("*other_value"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(i.findNodes("*_group"), UnorderedEquals(std::vector<Node*>{&groupNode}));
+    CHECK_THAT(i.findNodes("?_value"), UnorderedEquals(std::vector<Node*>{&entityNode1}));
+    CHECK_THAT(
+      i.findNodes("*yet*key"), UnorderedEquals(std::vector<Node*>{&entityNode2}));
+    CHECK_THAT(i.findNodes("*_ke"), UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodes("*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &groupNode}));
+
+    i.removeNode(entityNode2);
+
+    CHECK_THAT(i.findNodes("*other*"), UnorderedEquals(std::vector<Node*>{&entityNode1}));
+
+    auto otherGroupNode = GroupNode{Group{"other_group"}};
+    i.addNode(otherGroupNode);
+
+    CHECK_THAT(
+      i.findNodes("*other*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &otherGroupNode}));
   }
 }
 
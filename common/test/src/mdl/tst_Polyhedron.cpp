@@ -22,15 +22,20 @@
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
+#include "vm/constants.h"
+#include "vm/plane.h"
+#include "vm/plane_io.h" // IWYU pragma: keep
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <set>
 
 #include "catch/CatchConfig.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
@@ -416,6 +421,59 @@ TEST_CASE("Polyhedron")
     CHECK(rhs.bounds() == original.bounds());
   }
 
+  SECTION("topology")
+  {
+    const auto original = Polyhedron3d{
+      {0, 0, 8}, {8, 0, 0}, {-8, 0, 0}, {0, 8, 0}, {0, -8, 0}, {2, 2, -6}};
+    REQUIRE(original.polyhedron());
+
+    const auto topology = original.topology();
+    CHECK(topology.vertexPositions == original.vertexPositions());
+    CHECK(topology.facePlanes.size() == original.faceCount());
+    CHECK(topology.edgeHalfEdges.size() == 2 * original.edgeCount());
+
+    SECTION("restores the polyhedron")
+    {
+      const auto restored = Polyhedron3d::fromTopology(topology);
+      REQUIRE(restored);
+      CHECK(*restored == original);
+      CHECK(restored->bounds() == original.bounds());
+      CHECK(restored->topology() == topology);
+    }
+
+    SECTION("rejects inconsistent topologies")
+    {
+      auto invalid = topology;
+
+      SECTION("vertex index out of range")
+      {
+        invalid.halfEdgeOrigins.front() = invalid.vertexPositions.size();
+      }
+
+      SECTION("half edge used twice")
+      {
+        invalid.edgeHalfEdges[1] = invalid.edgeHalfEdges[0];
+      }
+
+      SECTION("half edges not opposite")
+      {
+        std::swap(invalid.edgeHalfEdges[1], invalid.edgeHalfEdges[3]);
+      }
+
+      SECTION("face size mismatch")
+      {
+        invalid.faceSizes.front() += 1;
+      }
+
+      SECTION("missing face")
+      {
+        invalid.facePlanes.pop_back();
+      }
+
+      CHECK(Polyhedron3d::fromTopology(invalid) == std::nullopt);
+    }
+  }
+
   SECTION("clipCubeWithHorizontalPlane")
   {
     const auto p1 = vm::vec3d{-64, -64, -64};
@@ -549,6 +607,74 @@ TEST_CASE("Polyhedron")
     CHECK(p.clip({vm::vec3d{0, 0, -64}, vm::vec3d{0, 0, 1}}).empty());
   }
 
+  SECTION("clip classifies vertices like vm::plane::point_status")
+  {
+    // a prism with more vertices than are classified in one block
+    auto points = std::vector<vm::vec3d>{};
+    for (size_t i = 0; i < 20; ++i)
+    {
+      const auto angle = 2.0 * vm::Cd::pi() * double(i) / 20.0;
+      const auto x = std::round(64.0 * std::cos(angle));
+      const auto y = std::round(64.0 * std::sin(angle));
+      points.emplace_back(x, y, -32.0);
+      points.emplace_back(x, y, +32.0);
+    }
+    const auto original = Polyhedron3d{points};
+    REQUIRE(original.vertexCount() > 16u);
+
+    const auto epsilon = vm::constants<double>::point_status_epsilon();
+    const auto normals = std::vector<vm::vec3d>{
+      {0, 0, 1},
+      {0, 0, -1},
+      {1, 0, 0},
+      vm::normalize(vm::vec3d{1, 1, 0}),
+      vm::normalize(vm::vec3d{1, 2, 3}),
+    };
+    const auto offsets = std::vector<double>{
+      -80.0, -64.0, -32.0, -epsilon / 2.0, 0.0, epsilon / 2.0, 31.0, 32.0, 64.0, 80.0};
+
+    for (const auto& normal : normals)
+    {
+      for (const auto offset : offsets)
+      {
+        for (const auto& vertexPosition : original.vertexPositions())
+        {
+          // also use planes that contain a vertex or miss it by less than epsilon
+          for (const auto distance :
+               {offset, vm::dot(vertexPosition, normal) + offset / 64.0})
+          {
+            const auto plane = vm::plane3d{distance, normal};
+            CAPTURE(plane);
+
+            const auto hasVertex = [&](const auto status) {
+              return std::ranges::any_of(
+                original.vertexPositions(), [&](const auto& position) {
+                  return plane.point_status(position, epsilon) == status;
+                });
+            };
+            const auto anyAbove = hasVertex(vm::plane_status::above);
+            const auto anyBelow = hasVertex(vm::plane_status::below);
+
+            auto p = original;
+            const auto result = p.clip(plane);
+            if (!anyAbove)
+            {
+              CHECK(result.unchanged());
+            }
+            else if (!anyBelow)
+            {
+              CHECK(result.empty());
+            }
+            else
+            {
+              CHECK(result.success());
+            }
+          }
+        }
+      }
+    }
+  }
+
   SECTION("clipCubeWithSlantedPlane")
   {
     auto p = Polyhedron3d{vm::bbox3d{64.0}};
@@ -1998,4 +2124,49 @@ TEST_CASE("Polyhedron (Regression)", "[regression]")
   }
 }
 
+TEST_CASE("Polyhedron (Benchmark)", "[.][benchmark]")
+{
+  const auto brushCount = size_t(10000);
+  const auto bounds = vm::bbox3d{{-32.0, -32.0, -32.0}, {32.0, 32.0, 32.0}};
+  const auto points = std::vector<vm::vec3d>{
+    {-32.0, -32.0, -32.0},
+    {-32.0, 32.0, -32.0},
+    {32.0, -32.0, -32.0},
+    {32.0, 32.0, -32.0},
+    {-16.0, -16.0, 32.0},
+    {-16.0, 16.0, 32.0},
+    {16.0, -16.0, 32.0},
+    {16.0, 16.0, 32.0},
+  };
+
+  BENCHMARK("Build")
+  {
+    auto polyhedra = std::vector<Polyhedron3d>{};
+    polyhedra.reserve(brushCount);
+    for (size_t i = 0; i < brushCount; ++i)
+    {
+      polyhedra.emplace_back(points);
+    }
+    return polyhedra;
+  };
+
+  const auto original = std::vector<Polyhedron3d>(brushCount, Polyhedron3d{bounds});
+
+  BENCHMARK("Copy")
+  {
+    return original;
+  };
+
+  BENCHMARK("Clip")
+  {
+    auto polyhedra = original;
+    for (auto& polyhedron : polyhedra)
+    {
+      polyhedron.clip(vm::plane3d{0.0, vm::normalize(vm::vec3d{1.0, 1.0, 1.0})});
+      polyhedron.clip(vm::plane3d{8.0, vm::normalize(vm::vec3d{-1.0, 1.0, 0.0})});
+    }
+    return polyhedra;
+  };
+}
+
 } // namespace tb::mdl
@@ -25,10 +25,12 @@
 #include "kd/ranges/to.h"
 #include "kd/reflection_impl.h"
 
+#include <algorithm>
 #include <ranges>
 
 #include "catch/CatchConfig.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
@@ -132,18 +134,22 @@ TEST_CASE("ResourceManager")
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
     CHECK(!resourceManager.needsProcessing());
 
+    // released resources are only found when processing checks them
     resource1.reset();
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
-    CHECK(resourceManager.needsProcessing());
+    CHECK(resourceManager.resources().size() == 2);
 
     resourceManager.process(taskRunner, processContext);
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
+    CHECK(resourceManager.resources().size() == 1);
+
+    // the remaining resource is checked again
+    resourceManager.process(taskRunner, processContext);
     CHECK(!resourceManager.needsProcessing());
 
     resource2.reset();
-    CHECK(resourceManager.needsProcessing());
-
     resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.resources().empty());
     CHECK(!resourceManager.needsProcessing());
   }
 
@@ -292,7 +298,176 @@ TEST_CASE("ResourceManager")
       CHECK(resourceManager.resources().empty());
       CHECK(mockDropCalls[1] == glContextAvailable);
     }
+
+    SECTION("released resources are not loaded")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      resource1.reset();
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource2->id()});
+      CHECK(resourceManager.resources() == std::vector{resource2});
+      CHECK(mockTaskRunner.tasks.size() == 1);
+    }
+
+    SECTION("only some resources are loaded at once")
+    {
+      auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+      for (size_t i = 0; i < 2000; ++i)
+      {
+        resources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+        resourceManager.addResource(resources.back());
+      }
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(!mockTaskRunner.tasks.empty());
+      CHECK(mockTaskRunner.tasks.size() < resources.size());
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resources[0]->state()));
+      CHECK(
+        std::holds_alternative<ResourceUnloaded<MockResource>>(resources[1999]->state()));
+
+      while (resourceManager.needsProcessing())
+      {
+        while (!mockTaskRunner.tasks.empty())
+        {
+          mockTaskRunner.resolveNextPromise();
+        }
+        resourceManager.process(taskRunner, processContext);
+      }
+
+      CHECK(std::ranges::all_of(resources, [](const auto& resource) {
+        return std::holds_alternative<ResourceReady<MockResource>>(resource->state());
+      }));
+    }
+  }
+
+  SECTION("needsProcessing after finding a released resource")
+  {
+    auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+    for (size_t i = 0; i < 3000; ++i)
+    {
+      resources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+      resourceManager.addResource(resources.back());
+    }
+
+    while (resourceManager.needsProcessing())
+    {
+      while (!mockTaskRunner.tasks.empty())
+      {
+        mockTaskRunner.resolveNextPromise();
+      }
+      resourceManager.process(taskRunner, processContext);
+    }
+
+    // every process call checks some resources for being released, once one is found,
+    // processing is needed until all resources were checked again
+    resources[2000].reset();
+    while (resourceManager.resources().size() == resources.size())
+    {
+      CHECK(!resourceManager.needsProcessing());
+      resourceManager.process(taskRunner, processContext);
+    }
+    CHECK(resourceManager.needsProcessing());
+
+    while (resourceManager.needsProcessing())
+    {
+      resourceManager.process(taskRunner, processContext);
+    }
+    CHECK(resourceManager.resources().size() == resources.size() - 1);
   }
+
+  SECTION("prioritize")
+  {
+    auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+    auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+    auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+    resourceManager.addResource(resource1);
+    resourceManager.addResource(resource2);
+    resourceManager.addResource(resource3);
+
+    SECTION("prioritized resources are loaded first")
+    {
+      resourceManager.prioritize({resource3->id(), resource2->id()});
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource3->id(), resource2->id(), resource1->id()});
+    }
+
+    SECTION("resources that are already loading are ignored")
+    {
+      resourceManager.process(taskRunner, processContext);
+      resourceManager.prioritize({resource3->id(), ResourceId{}});
+
+      mockTaskRunner.resolveNextPromise();
+      CHECK(
+        resourceManager.process(taskRunner, processContext)
+        == std::vector{resource1->id()});
+    }
+
+    SECTION("prioritized resources overtake the remaining resources")
+    {
+      // more resources than can be loading at the same time
+      auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+      for (size_t i = 0; i < 2000; ++i)
+      {
+        resources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+        resourceManager.addResource(resources.back());
+      }
+
+      resourceManager.prioritize({resources.back()->id()});
+      resourceManager.process(taskRunner, processContext);
+
+      CHECK(
+        std::holds_alternative<ResourceLoading<MockResource>>(resources.back()->state()));
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(
+        resources[resources.size() - 2]->state()));
+    }
+  }
+}
+
+TEST_CASE("ResourceManager (Benchmark)", "[.][benchmark]")
+{
+  const auto mockResourceLoader = [&]() { return Result<MockResource>{MockResource{}}; };
+
+  auto mockTaskRunner = MockTaskRunner{};
+  auto taskRunner = [&](auto task) { return mockTaskRunner.run(std::move(task)); };
+  const auto processContext = ProcessContext{false, [](auto, auto) {}};
+
+  auto resourceManager = ResourceManager{};
+  auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+  for (size_t i = 0; i < 30000; ++i)
+  {
+    resources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+    resourceManager.addResource(resources.back());
+  }
+
+  while (resourceManager.needsProcessing())
+  {
+    while (!mockTaskRunner.tasks.empty())
+    {
+      mockTaskRunner.resolveNextPromise();
+    }
+    resourceManager.process(taskRunner, processContext);
+  }
+
+  // a few resources are loading while all other resources are ready
+  for (size_t i = 0; i < 10; ++i)
+  {
+    resources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+    resourceManager.addResource(resources.back());
+  }
+  resourceManager.process(taskRunner, processContext);
+
+  BENCHMARK("Process 30k resources")
+  {
+    return resourceManager.process(taskRunner, processContext);
+  };
 }
 
 } // namespace tb::mdl
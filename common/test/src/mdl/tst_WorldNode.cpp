@@ -34,6 +34,8 @@
 
 #include "kd/result.h"
 
+#include <unordered_set>
+
 #include "catch/CatchConfig.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -326,6 +328,40 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.groupNodes")
+{
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  REQUIRE(worldNode.groupNodes().empty());
+
+  auto* layerNode = new LayerNode{Layer{"layer"}};
+  auto* outerGroupNode = new GroupNode{Group{"outer"}};
+  auto* innerGroupNode = new GroupNode{Group{"inner"}};
+  auto* groupNode = new GroupNode{Group{"group"}};
+
+  outerGroupNode->addChild(innerGroupNode);
+  layerNode->addChild(outerGroupNode);
+
+  worldNode.addChild(layerNode);
+  worldNode.defaultLayer()->addChild(groupNode);
+  CHECK(
+    worldNode.groupNodes()
+    == std::unordered_set<GroupNode*>{outerGroupNode, innerGroupNode, groupNode});
+
+  outerGroupNode->removeChild(innerGroupNode);
+  CHECK(
+    worldNode.groupNodes() == std::unordered_set<GroupNode*>{outerGroupNode, groupNode});
+
+  groupNode->addChild(innerGroupNode);
+  CHECK(
+    worldNode.groupNodes()
+    == std::unordered_set<GroupNode*>{outerGroupNode, innerGroupNode, groupNode});
+
+  worldNode.removeChild(layerNode);
+  CHECK(worldNode.groupNodes() == std::unordered_set<GroupNode*>{innerGroupNode, groupNode});
+
+  delete layerNode;
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
@@ -0,0 +1,168 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CircleShape.h"
+#include "mdl/MapFormat.h"
+#include "render/BrushRenderer.h"
+#include "render/BrushRendererBrushCache.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <memory>
+#include <vector>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::render
+{
+namespace
+{
+
+std::vector<std::unique_ptr<mdl::BrushNode>> makeBrushNodes(
+  const size_t count, const size_t sides)
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushBuilder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::unique_ptr<mdl::BrushNode>>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min =
+      vm::vec3d{double(i % 32), double((i / 32) % 32), double(i / 1024)} * 64.0;
+    auto brush = brushBuilder.createCylinder(
+                   vm::bbox3d{min, min + vm::vec3d{48, 48, 48}},
+                   mdl::EdgeAlignedCircle{sides},
+                   vm::axis::z,
+                   "material")
+                 | kdl::value();
+    result.push_back(std::make_unique<mdl::BrushNode>(std::move(brush)));
+  }
+  return result;
+}
+
+void invalidateVertexCaches(const std::vector<std::unique_ptr<mdl::BrushNode>>& nodes)
+{
+  for (const auto& node : nodes)
+  {
+    node->brushRendererBrushCache().invalidateVertexCache();
+  }
+}
+
+} // namespace
+
+TEST_CASE("BrushRenderer")
+{
+  SECTION("validate")
+  {
+    auto serialNodes = makeBrushNodes(256, 8);
+    auto parallelNodes = makeBrushNodes(256, 8);
+
+    auto taskManager = kdl::task_manager{4};
+    auto serialRenderer = BrushRenderer{};
+    auto parallelRenderer = BrushRenderer{BrushRenderer::NoFilter{}, taskManager};
+
+    for (size_t i = 0; i < serialNodes.size(); ++i)
+    {
+      serialRenderer.addBrush(serialNodes[i].get());
+      parallelRenderer.addBrush(parallelNodes[i].get());
+    }
+
+    CHECK_FALSE(serialRenderer.valid());
+    CHECK_FALSE(parallelRenderer.valid());
+
+    serialRenderer.validate();
+    parallelRenderer.validate();
+
+    CHECK(serialRenderer.valid());
+    CHECK(parallelRenderer.valid());
+
+    for (size_t i = 0; i < serialNodes.size(); ++i)
+    {
+      const auto& serialCache = serialNodes[i]->brushRendererBrushCache();
+      const auto& parallelCache = parallelNodes[i]->brushRendererBrushCache();
+
+      const auto& serialVertices = serialCache.cachedVertices();
+      const auto& parallelVertices = parallelCache.cachedVertices();
+      REQUIRE(parallelVertices.size() == serialVertices.size());
+      for (size_t j = 0; j < serialVertices.size(); ++j)
+      {
+        CHECK(
+          getVertexComponent<0>(parallelVertices[j])
+          == getVertexComponent<0>(serialVertices[j]));
+      }
+
+      CHECK(
+        parallelCache.cachedFacesSortedByMaterial().size()
+        == serialCache.cachedFacesSortedByMaterial().size());
+      CHECK(parallelCache.cachedEdges().size() == serialCache.cachedEdges().size());
+    }
+
+    SECTION("revalidating after invalidation")
+    {
+      invalidateVertexCaches(parallelNodes);
+      parallelRenderer.invalidate();
+      CHECK_FALSE(parallelRenderer.valid());
+
+      parallelRenderer.validate();
+      CHECK(parallelRenderer.valid());
+      CHECK(
+        parallelNodes.front()->brushRendererBrushCache().cachedVertices().size()
+        == serialNodes.front()->brushRendererBrushCache().cachedVertices().size());
+    }
+  }
+}
+
+TEST_CASE("BrushRenderer (Benchmark)", "[.][benchmark]")
+{
+  const auto nodes = makeBrushNodes(16384, 16);
+
+  auto taskManager = kdl::task_manager{};
+  auto serialRenderer = BrushRenderer{};
+  auto parallelRenderer = BrushRenderer{BrushRenderer::NoFilter{}, taskManager};
+
+  for (const auto& node : nodes)
+  {
+    serialRenderer.addBrush(node.get());
+    parallelRenderer.addBrush(node.get());
+  }
+
+  BENCHMARK("Validate serially")
+  {
+    invalidateVertexCaches(nodes);
+    serialRenderer.invalidate();
+    serialRenderer.validate();
+  };
+
+  BENCHMARK("Validate in parallel")
+  {
+    invalidateVertexCaches(nodes);
+    parallelRenderer.invalidate();
+    parallelRenderer.validate();
+  };
+}
+
+} // namespace tb::render
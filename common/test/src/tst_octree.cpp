@@ -21,6 +21,9 @@
 
 #include "catch/CatchConfig.h"
 
+#include <random>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb
@@ -227,6 +230,20 @@ TEST_CASE("node_address")
     CHECK(
       get_container({{-42, -42, -42}, {2, 2, 2}}, 32.0) == node_address{-2, -2, -2, 2});
   }
+
+  SECTION("get_morton_code")
+  {
+    CHECK(get_morton_code({0, 0, 0, 0}) == 0b111ull << 45);
+    CHECK(get_morton_code({1, 0, 0, 0}) == (0b111ull << 45 | 0b001ull));
+    CHECK(get_morton_code({0, 1, 0, 0}) == (0b111ull << 45 | 0b010ull));
+    CHECK(get_morton_code({0, 0, 1, 0}) == (0b111ull << 45 | 0b100ull));
+    CHECK(get_morton_code({2, 0, 6, 1}) == (0b111ull << 45 | 0b100'101'000ull));
+    CHECK(get_morton_code({-1, -1, -1, 0}) == (1ull << 45) - 1);
+
+    // negative coordinates precede positive coordinates
+    CHECK(get_morton_code({-1, 0, 0, 0}) < get_morton_code({0, 0, 0, 0}));
+    CHECK(get_morton_code({0, 0, -1, 0}) < get_morton_code({-2, -2, 0, 1}));
+  }
 }
 } // namespace detail
 
@@ -235,6 +252,35 @@ using node = tree::node;
 using leaf_node = tree::leaf_node;
 using inner_node = tree::inner_node;
 
+namespace
+{
+
+std::vector<std::pair<vm::bbox3d, int>> makeRandomEntries(
+  const size_t count, const double worldSize, const double maxSize)
+{
+  auto rng = std::mt19937_64{};
+  auto coords = std::uniform_real_distribution<double>{-worldSize, worldSize};
+  auto sizes = std::uniform_real_distribution<double>{1.0, maxSize};
+
+  auto entries = std::vector<std::pair<vm::bbox3d, int>>{};
+  entries.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3d{coords(rng), coords(rng), coords(rng)};
+    const auto size = vm::vec3d{sizes(rng), sizes(rng), sizes(rng)};
+    entries.emplace_back(vm::bbox3d{min, min + size}, int(i));
+  }
+  return entries;
+}
+
+std::vector<int> sorted(std::vector<int> v)
+{
+  std::ranges::sort(v);
+  return v;
+}
+
+} // namespace
+
 TEST_CASE("octree.insert")
 {
   auto tree = octree<double, int>{32.0};
@@ -417,6 +463,137 @@ TEST_CASE("octree.insert")
   }
 }
 
+TEST_CASE("octree.rebuild")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("with no entries")
+  {
+    REQUIRE(tree.insert({{-2, 0, 0}, {5, 3, 6}}, 1));
+
+    tree.rebuild({});
+    CHECK(tree == octree<double, int>{32.0});
+  }
+
+  SECTION("with entries in root node")
+  {
+    tree.rebuild({
+      {{{-2, 0, 0}, {5, 3, 6}}, 1},
+      {{{-33, -32, -32}, {32, 32, 32}}, 2},
+      {{{-32, -32, -32}, {32, 32, 32}}, 3},
+    });
+    CHECK(tree == octree<double, int>{32.0, leaf_node{{-2, -2, -2, 2}, {1, 2, 3}}});
+  }
+
+  SECTION("with entries in quadrants")
+  {
+    tree.rebuild({
+      {{{31, 31, 31}, {34, 34, 34}}, 3},
+      {{{2, 2, 2}, {3, 3, 3}}, 1},
+      {{{33, 33, 33}, {34, 34, 34}}, 4},
+      {{{3, 3, 3}, {4, 4, 4}}, 2},
+      {{{-2, 0, 0}, {5, 3, 6}}, 5},
+    });
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {5},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{inner_node{
+              {0, 0, 0, 1},
+              {3},
+              kdl::vec_from(
+                node{leaf_node{{0, 0, 0, 0}, {1, 2}}},
+                node{leaf_node{{1, 0, 0, 0}, {}}},
+                node{leaf_node{{0, 1, 0, 0}, {}}},
+                node{leaf_node{{1, 1, 0, 0}, {}}},
+                node{leaf_node{{0, 0, 1, 0}, {}}},
+                node{leaf_node{{1, 0, 1, 0}, {}}},
+                node{leaf_node{{0, 1, 1, 0}, {}}},
+                node{leaf_node{{1, 1, 1, 0}, {4}}})}})}});
+
+    CHECK(tree.contains(1));
+    CHECK(tree.contains(5));
+    CHECK_FALSE(tree.contains(6));
+  }
+
+  SECTION("with duplicate entries")
+  {
+    tree.rebuild({
+      {{{2, 2, 2}, {3, 3, 3}}, 1},
+      {{{33, 33, 33}, {34, 34, 34}}, 1},
+    });
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{-64, -64, -64}, {64, 64, 64}})
+      == std::vector<int>{1});
+    CHECK(tree.find_containers({2.5, 2.5, 2.5}) == std::vector<int>{1});
+  }
+
+  SECTION("with random entries")
+  {
+    const auto entries = makeRandomEntries(1000, 4096.0, 512.0);
+
+    auto expected = octree<double, int>{32.0};
+    for (const auto& [bounds, data] : entries)
+    {
+      REQUIRE(expected.insert(bounds, data));
+    }
+
+    tree.rebuild(entries);
+
+    for (const auto& [bounds, data] : entries)
+    {
+      CHECK(tree.contains(data));
+
+      const auto center = bounds.center();
+      CHECK(
+        sorted(tree.find_containers(center))
+        == sorted(expected.find_containers(center)));
+
+      const auto query = vm::bbox3d{center - vm::vec3d{64, 64, 64}, center};
+      CHECK(
+        sorted(tree.find_intersectors(query))
+        == sorted(expected.find_intersectors(query)));
+
+      const auto ray = vm::ray3d{center, vm::normalize(vm::vec3d{1, 2, 3})};
+      CHECK(
+        sorted(tree.find_intersectors(ray)) == sorted(expected.find_intersectors(ray)));
+    }
+
+    SECTION("and updating the tree afterwards")
+    {
+      for (const auto& [bounds, data] : entries)
+      {
+        if (data % 2 == 0)
+        {
+          tree.update(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, data);
+        }
+      }
+
+      const auto containers = tree.find_containers({8, 8, 8});
+      CHECK(
+        std::ranges::count_if(containers, [](const auto data) { return data % 2 == 0; })
+        == 500);
+
+      for (const auto& [bounds, data] : entries)
+      {
+        CHECK(tree.remove(data));
+      }
+      CHECK(tree.empty());
+    }
+  }
+}
+
 TEST_CASE("octree.remove")
 {
   auto tree = octree<double, int>{
@@ -719,4 +896,57 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree (Benchmark)", "[.][benchmark]")
+{
+  const auto entries = makeRandomEntries(1'000'000, 65536.0, 1024.0);
+
+  const auto buildTree = [&]() {
+    auto tree = octree<double, int>{256.0};
+    tree.rebuild(entries);
+    return tree;
+  };
+
+  BENCHMARK("Insert")
+  {
+    auto tree = octree<double, int>{256.0};
+    for (const auto& [bounds, data] : entries)
+    {
+      tree.insert(bounds, data);
+    }
+    return tree;
+  };
+
+  BENCHMARK("Rebuild")
+  {
+    return buildTree();
+  };
+
+  const auto tree = buildTree();
+
+  BENCHMARK("Find intersectors with rays")
+  {
+    auto count = size_t(0);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto& [bounds, data] = entries[i];
+      const auto ray = vm::ray3d{bounds.center(), vm::normalize(vm::vec3d{1, 2, 3})};
+      count += tree.find_intersectors(ray).size();
+    }
+    return count;
+  };
+
+  BENCHMARK("Find intersectors with boxes")
+  {
+    auto count = size_t(0);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto& [bounds, data] = entries[i];
+      const auto query = vm::bbox3d{bounds.min, bounds.min + vm::vec3d{2048, 2048, 2048}};
+      count += tree.find_intersectors(query).size();
+    }
+    return count;
+  };
+}
+
 } // namespace tb
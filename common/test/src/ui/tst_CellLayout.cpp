@@ -0,0 +1,290 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/CellLayout.h"
+
+#include <string>
+#include <vector>
+
+#include "catch/CatchConfig.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::ui
+{
+namespace
+{
+
+struct TestItem
+{
+  int id;
+  float width;
+  float height;
+};
+
+CellLayout makeLayout()
+{
+  auto layout = CellLayout{};
+  layout.setWidth(300.0f);
+  layout.setOuterMargin(5.0f);
+  layout.setGroupMargin(5.0f);
+  layout.setRowMargin(10.0f);
+  layout.setCellMargin(5.0f);
+  layout.setTitleMargin(2.0f);
+  layout.setCellWidth(32.0f, 64.0f);
+  layout.setCellHeight(32.0f, 128.0f);
+  return layout;
+}
+
+void addItems(CellLayout& layout, const std::vector<TestItem>& items)
+{
+  for (const auto& item : items)
+  {
+    layout.addItem(
+      item.id, std::to_string(item.id), item.width, item.height, 20.0f, 12.0f);
+  }
+}
+
+CellLayout makeLayout(const std::vector<std::vector<TestItem>>& groups)
+{
+  auto layout = makeLayout();
+  for (size_t i = 0; i < groups.size(); ++i)
+  {
+    layout.addGroup("group" + std::to_string(i), 14.0f);
+    addItems(layout, groups[i]);
+  }
+  return layout;
+}
+
+bool boundsEqual(const LayoutBounds& lhs, const LayoutBounds& rhs)
+{
+  return lhs.x == rhs.x && lhs.y == rhs.y && lhs.width == rhs.width
+         && lhs.height == rhs.height;
+}
+
+bool layoutsEqual(CellLayout& lhs, CellLayout& rhs)
+{
+  if (lhs.height() != rhs.height() || lhs.groups().size() != rhs.groups().size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.groups().size(); ++i)
+  {
+    const auto& lhsGroup = lhs.groups()[i];
+    const auto& rhsGroup = rhs.groups()[i];
+    if (
+      !boundsEqual(lhsGroup.titleBounds(), rhsGroup.titleBounds())
+      || !boundsEqual(lhsGroup.contentBounds(), rhsGroup.contentBounds())
+      || lhsGroup.rows().size() != rhsGroup.rows().size())
+    {
+      return false;
+    }
+
+    for (size_t j = 0; j < lhsGroup.rows().size(); ++j)
+    {
+      const auto& lhsRow = lhsGroup.rows()[j];
+      const auto& rhsRow = rhsGroup.rows()[j];
+      if (
+        !boundsEqual(lhsRow.bounds(), rhsRow.bounds())
+        || lhsRow.cells().size() != rhsRow.cells().size())
+      {
+        return false;
+      }
+
+      for (size_t k = 0; k < lhsRow.cells().size(); ++k)
+      {
+        const auto& lhsCell = lhsRow.cells()[k];
+        const auto& rhsCell = rhsRow.cells()[k];
+        if (
+          lhsCell.itemAs<int>() != rhsCell.itemAs<int>()
+          || !boundsEqual(lhsCell.cellBounds(), rhsCell.cellBounds())
+          || !boundsEqual(lhsCell.itemBounds(), rhsCell.itemBounds())
+          || !boundsEqual(lhsCell.titleBounds(), rhsCell.titleBounds()))
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("CellLayout")
+{
+  const auto group0 = std::vector<TestItem>{
+    {0, 32, 32},
+    {1, 64, 64},
+    {2, 32, 96},
+    {3, 16, 16},
+    {4, 64, 32},
+    {5, 32, 32},
+    {6, 48, 48},
+  };
+  const auto group1 = std::vector<TestItem>{
+    {10, 32, 32},
+    {11, 64, 128},
+    {12, 32, 32},
+    {13, 32, 32},
+    {14, 32, 32},
+  };
+
+  auto layout = makeLayout({group0, group1});
+  REQUIRE(layout.groups()[0].rows().size() > 1);
+
+  SECTION("addItem")
+  {
+    CHECK(layout.groups()[0].items().size() == group0.size());
+    CHECK(layout.groups()[1].items().size() == group1.size());
+  }
+
+  SECTION("updateItem")
+  {
+    SECTION("Growing an item in the last row")
+    {
+      layout.updateItem(0, 6, 6, 48.0f, 128.0f);
+
+      auto expectedGroup0 = group0;
+      expectedGroup0[6] = {6, 48, 128};
+
+      auto expected = makeLayout({expectedGroup0, group1});
+      CHECK(layoutsEqual(layout, expected));
+    }
+
+    SECTION("Growing an item in the first row")
+    {
+      layout.updateItem(0, 1, 1, 64.0f, 128.0f);
+
+      auto expectedGroup0 = group0;
+      expectedGroup0[1] = {1, 64, 128};
+
+      auto expected = makeLayout({expectedGroup0, group1});
+      CHECK(layoutsEqual(layout, expected));
+    }
+
+    SECTION("Updating items in several groups")
+    {
+      layout.updateItem(0, 5, 5, 64.0f, 64.0f);
+      layout.updateItem(0, 2, 2, 16.0f, 16.0f);
+      layout.updateItem(1, 3, 13, 64.0f, 96.0f);
+
+      auto expectedGroup0 = group0;
+      expectedGroup0[5] = {5, 64, 64};
+      expectedGroup0[2] = {2, 16, 16};
+      auto expectedGroup1 = group1;
+      expectedGroup1[3] = {13, 64, 96};
+
+      auto expected = makeLayout({expectedGroup0, expectedGroup1});
+      CHECK(layoutsEqual(layout, expected));
+    }
+
+    SECTION("Shrinking an item")
+    {
+      layout.updateItem(1, 1, 11, 32.0f, 32.0f);
+
+      auto expectedGroup1 = group1;
+      expectedGroup1[1] = {11, 32, 32};
+
+      auto expected = makeLayout({group0, expectedGroup1});
+      CHECK(layoutsEqual(layout, expected));
+    }
+  }
+
+  SECTION("insertItem")
+  {
+    layout.insertItem(0, 2, 20, "20", 64.0f, 96.0f, 20.0f, 12.0f);
+
+    auto expectedGroup0 = group0;
+    expectedGroup0.insert(expectedGroup0.begin() + 2, TestItem{20, 64, 96});
+
+    auto expected = makeLayout({expectedGroup0, group1});
+    CHECK(layoutsEqual(layout, expected));
+  }
+
+  SECTION("removeItem")
+  {
+    layout.removeItem(0, 0);
+
+    auto expectedGroup0 = group0;
+    expectedGroup0.erase(expectedGroup0.begin());
+
+    auto expected = makeLayout({expectedGroup0, group1});
+    CHECK(layoutsEqual(layout, expected));
+
+    SECTION("Removing all items of a group")
+    {
+      for (size_t i = 0; i < group1.size(); ++i)
+      {
+        layout.removeItem(1, 0);
+      }
+
+      auto expectedWithoutItems = makeLayout({expectedGroup0, {}});
+      CHECK(layoutsEqual(layout, expectedWithoutItems));
+    }
+  }
+
+  SECTION("setWidth lays out all items again")
+  {
+    layout.updateItem(0, 1, 1, 64.0f, 128.0f);
+    layout.setWidth(200.0f);
+
+    auto expectedGroup0 = group0;
+    expectedGroup0[1] = {1, 64, 128};
+
+    auto expected = makeLayout({expectedGroup0, group1});
+    expected.setWidth(200.0f);
+    CHECK(layoutsEqual(layout, expected));
+  }
+}
+
+TEST_CASE("CellLayout (Benchmark)", "[.][benchmark]")
+{
+  auto items = std::vector<TestItem>{};
+  for (int i = 0; i < 20000; ++i)
+  {
+    items.push_back({i, 64, 64});
+  }
+
+  auto layout = makeLayout({items});
+  REQUIRE(layout.height() > 0.0f);
+
+  BENCHMARK("Lay out all items")
+  {
+    layout.invalidate();
+    return layout.height();
+  };
+
+  auto size = 32.0f;
+  BENCHMARK("Update 100 items near the end")
+  {
+    size = size == 32.0f ? 64.0f : 32.0f;
+    for (size_t i = 0; i < 100; ++i)
+    {
+      const auto index = items.size() - 1 - i * 10;
+      layout.updateItem(0, index, items[index].id, size, size);
+    }
+    return layout.height();
+  };
+}
+
+} // namespace tb::ui
@@ -644,6 +644,32 @@ private:
       }
     }
 
+    /**
+     * Calls the given function for every value in this subtree, once for every time it
+     * was stored.
+     *
+     * @tparam F the type of the function
+     * @param prefix the prefix of all keys in this subtree
+     * @param f the function to call with the key and the value
+     */
+    template <typename F>
+    void for_each_value(const std::string& prefix, const F& f) const
+    {
+      const auto key = prefix + m_key;
+      for (const auto& [value, count] : m_values)
+      {
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+          f(std::string_view{key}, value);
+        }
+      }
+
+      for (const auto& child : m_children)
+      {
+        child.for_each_value(key, f);
+      }
+    }
+
   private:
     void insert_value(const V& value) { m_values[value]++; }
 
@@ -843,6 +869,19 @@ public:
   {
     m_root.get_keys("", out);
   }
+
+  /**
+   * Calls the given function with the key and the value of every value in this trie,
+   * once for every time the value was inserted under the key.
+   *
+   * @tparam F the type of the function
+   * @param f the function to call
+   */
+  template <typename F>
+  void for_each_value(const F& f) const
+  {
+    m_root.for_each_value("", f);
+  }
 };
 
 } // namespace kdl
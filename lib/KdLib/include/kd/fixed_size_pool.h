@@ -0,0 +1,356 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace kdl
+{
+
+/**
+ * A thread safe allocator for memory blocks of a fixed size.
+ *
+ * Memory is requested from the system in chunks of several blocks. Freed blocks are kept
+ * in a free list that is local to the freeing thread. Once a thread's free list grows too
+ * long, a batch of blocks is moved back to the shared free lists of their chunks where
+ * other threads can pick them up again. Thus, allocating and freeing a block usually does
+ * not require any synchronization, and blocks that are allocated on one thread and freed
+ * on another are eventually reused.
+ *
+ * A chunk is returned to the system as soon as all of its blocks are back in its shared
+ * free list, so memory is released when large numbers of blocks are freed, e.g. when a
+ * map is closed. At most two batches of blocks per thread are kept in the threads' free
+ * lists and may keep their chunks alive.
+ *
+ * Blocks that are freed after the freeing thread's free list was destroyed, e.g. by other
+ * thread local objects or during static destruction, go to the shared free lists
+ * directly.
+ *
+ * @tparam Size the size of the blocks
+ * @tparam Alignment the alignment of the blocks
+ */
+template <std::size_t Size, std::size_t Alignment>
+class fixed_size_pool
+{
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  /**
+   * Stored at the start of every chunk. Chunks are aligned to their size so that the
+   * header of a block's chunk can be found by masking the block's address.
+   */
+  struct chunk_header
+  {
+    chunk_header* previous = nullptr;
+    chunk_header* next = nullptr;
+    free_block* first = nullptr;
+    std::size_t free_count = 0;
+  };
+
+  static constexpr auto alignment = std::max(Alignment, alignof(free_block));
+  static constexpr auto block_size =
+    (std::max(Size, sizeof(free_block)) + alignment - 1) / alignment * alignment;
+  static constexpr auto blocks_per_batch = std::size_t(256);
+
+  static constexpr auto header_size =
+    (sizeof(chunk_header) + alignment - 1) / alignment * alignment;
+  static constexpr auto chunk_size =
+    std::bit_ceil(header_size + block_size * blocks_per_batch);
+  static constexpr auto blocks_per_chunk = (chunk_size - header_size) / block_size;
+
+  struct batch
+  {
+    free_block* first;
+    std::size_t count;
+  };
+
+  /**
+   * The chunks that have free blocks in their shared free lists. Fully allocated chunks
+   * are not linked, and fully free chunks are released.
+   */
+  struct shared_state
+  {
+    std::mutex mutex;
+    chunk_header* first_chunk = nullptr;
+    std::size_t chunk_count = 0;
+
+    void link(chunk_header& chunk)
+    {
+      chunk.previous = nullptr;
+      chunk.next = first_chunk;
+      if (first_chunk)
+      {
+        first_chunk->previous = &chunk;
+      }
+      first_chunk = &chunk;
+    }
+
+    void unlink(chunk_header& chunk)
+    {
+      (chunk.previous ? chunk.previous->next : first_chunk) = chunk.next;
+      if (chunk.next)
+      {
+        chunk.next->previous = chunk.previous;
+      }
+    }
+  };
+
+  struct thread_cache
+  {
+    bool& destroyed;
+    free_block* first = nullptr;
+    std::size_t count = 0;
+
+    ~thread_cache()
+    {
+      destroyed = true;
+      if (first)
+      {
+        give_back(batch{first, count});
+      }
+    }
+  };
+
+  static shared_state& shared()
+  {
+    // intentionally leaked, blocks may still be freed during static destruction
+    static auto* state = new shared_state{};
+    return *state;
+  }
+
+  /**
+   * Returns the calling thread's free list, or null if it was already destroyed.
+   */
+  static thread_cache* cache()
+  {
+    // trivially destructible, so it can still be read after the cache was destroyed
+    thread_local auto destroyed = false;
+    if (destroyed)
+    {
+      return nullptr;
+    }
+
+    thread_local auto cache = thread_cache{destroyed};
+    return &cache;
+  }
+
+  static chunk_header& chunk_of(free_block* block)
+  {
+    return *reinterpret_cast<chunk_header*>(
+      reinterpret_cast<std::uintptr_t>(block) & ~std::uintptr_t(chunk_size - 1));
+  }
+
+  /**
+   * Returns the given blocks to the free lists of their chunks and releases every chunk
+   * whose blocks are all free.
+   */
+  static void give_back(const batch& batch_)
+  {
+    auto& state = shared();
+    auto lock = std::lock_guard{state.mutex};
+
+    auto* block = batch_.first;
+    for (std::size_t i = 0; i < batch_.count; ++i)
+    {
+      auto* next = block->next;
+      auto& chunk = chunk_of(block);
+      if (chunk.free_count == 0)
+      {
+        state.link(chunk);
+      }
+
+      block->next = chunk.first;
+      chunk.first = block;
+      if (++chunk.free_count == blocks_per_chunk)
+      {
+        state.unlink(chunk);
+        chunk.~chunk_header();
+        ::operator delete(static_cast<void*>(&chunk), std::align_val_t{chunk_size});
+        --state.chunk_count;
+      }
+
+      block = next;
+    }
+  }
+
+  static batch take_batch()
+  {
+    auto& state = shared();
+    auto lock = std::lock_guard{state.mutex};
+    if (!state.first_chunk)
+    {
+      auto* memory = static_cast<std::byte*>(
+        ::operator new(chunk_size, std::align_val_t{chunk_size}));
+      auto* chunk = new (memory) chunk_header{};
+      ++state.chunk_count;
+
+      for (std::size_t i = blocks_per_chunk; i > 0; --i)
+      {
+        auto* block =
+          reinterpret_cast<free_block*>(memory + header_size + (i - 1) * block_size);
+        block->next = chunk->first;
+        chunk->first = block;
+      }
+      chunk->free_count = blocks_per_chunk;
+      state.link(*chunk);
+    }
+
+    auto& chunk = *state.first_chunk;
+    const auto count = std::min(chunk.free_count, blocks_per_batch);
+
+    auto* first = chunk.first;
+    auto* last = first;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+      last = last->next;
+    }
+
+    chunk.first = last->next;
+    chunk.free_count -= count;
+    last->next = nullptr;
+    if (chunk.free_count == 0)
+    {
+      state.unlink(chunk);
+    }
+
+    return batch{first, count};
+  }
+
+public:
+  /**
+   * Returns a block of Size bytes aligned to Alignment.
+   */
+  static void* allocate()
+  {
+    auto* cache_ = cache();
+    if (!cache_)
+    {
+      auto batch_ = take_batch();
+      auto* block = batch_.first;
+      if (batch_.count > 1)
+      {
+        give_back(batch{block->next, batch_.count - 1});
+      }
+      return block;
+    }
+
+    if (!cache_->first)
+    {
+      const auto batch_ = take_batch();
+      cache_->first = batch_.first;
+      cache_->count = batch_.count;
+    }
+
+    auto* block = cache_->first;
+    cache_->first = block->next;
+    --cache_->count;
+    return block;
+  }
+
+  /**
+   * Returns the given block to this pool. The block must have been allocated by this
+   * pool.
+   */
+  static void deallocate(void* ptr) noexcept
+  {
+    auto* block = static_cast<free_block*>(ptr);
+
+    auto* cache_ = cache();
+    if (!cache_)
+    {
+      block->next = nullptr;
+      give_back(batch{block, 1});
+      return;
+    }
+
+    block->next = cache_->first;
+    cache_->first = block;
+    ++cache_->count;
+
+    if (cache_->count >= 2 * blocks_per_batch)
+    {
+      // the most recently freed blocks stay in the cache, the rest are shared
+      auto* last = cache_->first;
+      for (std::size_t i = 1; i < blocks_per_batch; ++i)
+      {
+        last = last->next;
+      }
+
+      give_back(batch{last->next, cache_->count - blocks_per_batch});
+      last->next = nullptr;
+      cache_->count = blocks_per_batch;
+    }
+  }
+
+  /**
+   * Returns the number of chunks that are currently allocated from the system.
+   */
+  static std::size_t chunk_count()
+  {
+    auto& state = shared();
+    auto lock = std::lock_guard{state.mutex};
+    return state.chunk_count;
+  }
+};
+
+/**
+ * Base class that makes new and delete allocate instances of Derived from a
+ * fixed_size_pool. This is useful for types that are created and destroyed in large
+ * numbers, such as the nodes of linked data structures.
+ *
+ * Allocations of a different size, e.g. for subclasses of Derived, are forwarded to the
+ * global allocation functions.
+ *
+ * @tparam Derived the type that derives from this class
+ */
+template <typename Derived>
+class pool_allocated
+{
+public:
+  static void* operator new(const std::size_t size)
+  {
+    using pool = fixed_size_pool<sizeof(Derived), alignof(Derived)>;
+    return size == sizeof(Derived) ? pool::allocate() : ::operator new(size);
+  }
+
+  static void operator delete(void* ptr, const std::size_t size) noexcept
+  {
+    using pool = fixed_size_pool<sizeof(Derived), alignof(Derived)>;
+    if (size == sizeof(Derived))
+    {
+      pool::deallocate(ptr);
+    }
+    else
+    {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+} // namespace kdl
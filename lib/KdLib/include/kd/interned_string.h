@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace kdl
+{
+
+/** An immutable string that is stored in a global table of unique strings.
+ *
+ * Every distinct string value is stored only once, so an interned string is just a
+ * pointer into that table. Copying is cheap, equality is a pointer comparison, and many
+ * objects that share the same value do not each pay for a heap allocation.
+ *
+ * Strings are never removed from the table, so interning should be reserved for values
+ * drawn from a limited set, such as material names. Interning is thread safe.
+ */
+class interned_string
+{
+private:
+  const std::string* m_str;
+
+public:
+  /** Creates an interned empty string. */
+  interned_string();
+
+  interned_string(std::string_view str);
+  interned_string(const std::string& str);
+  interned_string(const char* str);
+
+  const std::string& str() const { return *m_str; }
+
+  operator const std::string&() const { return *m_str; }
+
+  bool empty() const { return m_str->empty(); }
+
+  std::size_t size() const { return m_str->size(); }
+
+  /** Returns the number of distinct strings that have been interned so far. */
+  static std::size_t interned_count();
+
+  friend bool operator==(const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs.m_str == rhs.m_str;
+  }
+
+  friend std::strong_ordering operator<=>(
+    const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs.m_str == rhs.m_str ? std::strong_ordering::equal
+                                  : *lhs.m_str <=> *rhs.m_str;
+  }
+
+  friend std::ostream& operator<<(std::ostream& lhs, const interned_string& rhs);
+};
+
+} // namespace kdl
+
+template <>
+struct std::hash<kdl::interned_string>
+{
+  std::size_t operator()(const kdl::interned_string& str) const noexcept
+  {
+    return std::hash<const std::string*>{}(&str.str());
+  }
+};
@@ -22,31 +22,129 @@
 
 #include "kd/ranges/to.h"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <ranges>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace kdl
 {
 
+/**
+ * Runs tasks on a fixed pool of worker threads.
+ *
+ * Every worker owns a queue of pending tasks. Workers take tasks from the back of their
+ * own queue and steal from the front of the other workers' queues when their own queue is
+ * empty. Threads that wait for the completion of a batch of tasks help executing the
+ * pending chunks of that batch instead of blocking, but never pick up unrelated tasks.
+ *
+ * Single tasks (run_task, run_tasks) allocate their state and a promise for every task.
+ * Batches of tasks (run_range, run_tasks_and_wait) are submitted as chunks of indices and
+ * only allocate the queue entries of their chunks.
+ */
 class task_manager
 {
 private:
-  using pending_task = std::function<void()>;
+  class task_group;
 
+  /**
+   * A queued unit of work. Calls invoke with the context and the half open index range
+   * [begin, end). If the task manager is destroyed before the task was run, discard is
+   * called with the context instead, unless it is null. Chunks of a batch refer to the
+   * group of that batch, single tasks have no group.
+   */
+  struct pending_task
+  {
+    void (*invoke)(void* context, std::size_t begin, std::size_t end);
+    void (*discard)(void* context);
+    void* context;
+    const task_group* group;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<pending_task> tasks;
+  };
+
+  /**
+   * Counts the unfinished chunks of a batch and records the first exception thrown by any
+   * of them.
+   */
+  class task_group
+  {
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::size_t m_remaining;
+    std::exception_ptr m_exception;
+
+  public:
+    explicit task_group(std::size_t chunk_count);
+
+    void finish_chunk(std::exception_ptr exception);
+    bool done();
+    void wait();
+    void rethrow_exception();
+  };
+
+  std::vector<std::unique_ptr<worker_queue>> m_queues;
   std::vector<std::thread> m_workers;
 
-  std::mutex m_pending_tasks_mutex;
-  std::condition_variable m_pending_tasks_cv;
-  std::queue<pending_task> m_pending_tasks;
-  bool m_running = true;
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle_cv;
+  std::atomic<std::size_t> m_pending_count = 0;
+  std::atomic<std::size_t> m_next_queue = 0;
+  std::atomic<bool> m_running = true;
+
+  void run_worker(std::size_t worker_index);
+
+  void push_task(const pending_task& task);
+  void push_chunks(
+    void (*invoke)(void*, std::size_t, std::size_t),
+    void* context,
+    const task_group& group,
+    std::size_t begin,
+    std::size_t end,
+    std::size_t grain);
+
+  std::optional<pending_task> pop_task();
+  std::optional<pending_task> pop_chunk(const task_group& group);
+  bool run_pending_task();
+  void wait_for(task_group& group);
+
+  std::size_t default_grain(std::size_t count) const;
 
-  std::function<void()> make_worker_func();
+  /**
+   * Sets the result of the given task as the value of the given promise, or the
+   * exception thrown by the task.
+   */
+  template <typename task_result>
+  static void set_result(
+    std::promise<task_result>& promise, std::function<task_result()>& task)
+  {
+    try
+    {
+      promise.set_value(task());
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  }
 
 public:
   explicit task_manager(
@@ -54,26 +152,42 @@ public:
 
   ~task_manager();
 
+  task_manager(const task_manager&) = delete;
+  task_manager& operator=(const task_manager&) = delete;
+
+  /**
+   * Queues the given task and returns a future for its result. If the task throws an
+   * exception, the exception is stored in the future.
+   */
   template <typename task_result>
   auto run_task(std::function<task_result()> task)
   {
     if (m_workers.empty())
     {
       auto promise = std::promise<task_result>{};
-      promise.set_value(task());
+      set_result(promise, task);
       return promise.get_future();
     }
 
-    auto promise = std::make_shared<std::promise<task_result>>();
-    auto future = promise->get_future();
-
+    struct single_task
     {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
-      m_pending_tasks.push([&, task_ = std::move(task), promise_ = std::move(promise)]() {
-        promise_->set_value(task_());
-      });
-    }
-    m_pending_tasks_cv.notify_one();
+      std::function<task_result()> task;
+      std::promise<task_result> promise;
+    };
+
+    auto* context = new single_task{std::move(task), {}};
+    auto future = context->promise.get_future();
+
+    push_task(pending_task{
+      [](void* context_, std::size_t, std::size_t) {
+        auto task_ = std::unique_ptr<single_task>{static_cast<single_task*>(context_)};
+        set_result(task_->promise, task_->task);
+      },
+      [](void* context_) { delete static_cast<single_task*>(context_); },
+      context,
+      nullptr,
+      0,
+      1});
 
     return future;
   }
@@ -87,12 +201,97 @@ public:
            | kdl::ranges::to<std::vector>();
   }
 
+  /**
+   * Calls func for every index in [begin, end) and waits until all calls have returned.
+   *
+   * The range is split into chunks of grain indices which are distributed among the
+   * workers. The calling thread helps executing pending tasks while it waits. If any call
+   * throws an exception, the first such exception is rethrown once all chunks are done.
+   */
+  template <typename func_type>
+  void run_range(
+    const std::size_t begin,
+    const std::size_t end,
+    std::size_t grain,
+    func_type&& func)
+  {
+    if (begin >= end)
+    {
+      return;
+    }
+
+    grain = std::max(grain, std::size_t(1));
+    if (m_workers.empty() || end - begin <= grain)
+    {
+      for (auto i = begin; i < end; ++i)
+      {
+        std::invoke(func, i);
+      }
+      return;
+    }
+
+    struct range_context
+    {
+      std::remove_reference_t<func_type>& func;
+      task_group group;
+    };
+
+    auto context = range_context{func, task_group{(end - begin + grain - 1) / grain}};
+    push_chunks(
+      [](void* context_, const std::size_t chunk_begin, const std::size_t chunk_end) {
+        auto& range_context_ = *static_cast<range_context*>(context_);
+        auto exception = std::exception_ptr{};
+        try
+        {
+          for (auto i = chunk_begin; i < chunk_end; ++i)
+          {
+            std::invoke(range_context_.func, i);
+          }
+        }
+        catch (...)
+        {
+          exception = std::current_exception();
+        }
+        range_context_.group.finish_chunk(std::move(exception));
+      },
+      &context,
+      context.group,
+      begin,
+      end,
+      grain);
+
+    wait_for(context.group);
+    context.group.rethrow_exception();
+  }
+
   template <std::ranges::range range>
   auto run_tasks_and_wait(range&& tasks)
   {
-    auto futures = run_tasks(std::forward<range>(tasks));
-    return futures | std::views::transform([](auto& future) { return future.get(); })
-           | kdl::ranges::to<std::vector>();
+    if constexpr (
+      std::ranges::random_access_range<range> && std::ranges::sized_range<range>)
+    {
+      using task_result = std::remove_cvref_t<
+        std::invoke_result_t<std::ranges::range_reference_t<range>>>;
+      using difference_type = std::ranges::range_difference_t<range>;
+
+      const auto count = static_cast<std::size_t>(std::ranges::size(tasks));
+      auto first = std::ranges::begin(tasks);
+
+      auto results = std::vector<std::optional<task_result>>(count);
+      run_range(0, count, default_grain(count), [&](const std::size_t i) {
+        results[i].emplace(std::invoke(first[static_cast<difference_type>(i)]));
+      });
+
+      return results | std::views::transform([](auto& result) {
+               return std::move(*result);
+             })
+             | kdl::ranges::to<std::vector>();
+    }
+    else
+    {
+      return run_tasks_and_wait(
+        std::forward<range>(tasks) | kdl::ranges::to<std::vector>());
+    }
   }
 };
 
@@ -0,0 +1,333 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "kd/string_compare.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * Maps string keys to values and finds the values whose keys match a glob pattern, like
+ * `compact_trie`, but is optimized for patterns that do not start with a literal prefix,
+ * such as `*substring*`.
+ *
+ * For every distinct key, the index records the key's trigrams, that is, every substring
+ * of three consecutive characters. A key can only match a pattern if it contains every
+ * trigram of the pattern's literal parts, so the keys to match against the pattern are
+ * found by intersecting the lists of keys that contain these trigrams.
+ *
+ * Keys whose values are all removed stay in the index until more than half of the keys
+ * are unused, at which point the index is rebuilt. This keeps adding and removing values
+ * cheap when the same keys are removed and added again, such as when a node changes.
+ *
+ * @tparam V the type of the values associated with each key
+ */
+template <typename V>
+class trigram_index
+{
+private:
+  using key_id = std::uint32_t;
+  using trigram = std::uint32_t;
+  using value_container = std::unordered_map<V, std::size_t>;
+
+  struct entry
+  {
+    const std::string* key;
+    value_container values;
+  };
+
+  static constexpr std::size_t min_unused_entries_to_rebuild = 1024u;
+
+  std::unordered_map<std::string, key_id> m_key_ids;
+  std::vector<entry> m_entries;
+  std::unordered_map<trigram, std::vector<key_id>> m_key_ids_by_trigram;
+  std::size_t m_unused_entry_count = 0u;
+
+public:
+  /**
+   * Creates a new empty index.
+   */
+  trigram_index() = default;
+
+  /**
+   * Inserts the given value under the given key.
+   *
+   * @param key the key to insert
+   * @param value the value to insert
+   */
+  void insert(const std::string_view key, const V& value)
+  {
+    const auto [it, inserted] =
+      m_key_ids.try_emplace(std::string{key}, key_id(m_entries.size()));
+    if (inserted)
+    {
+      m_entries.push_back(entry{&it->first, {}});
+      add_trigrams(it->first, it->second);
+    }
+
+    auto& values = m_entries[it->second].values;
+    if (!inserted && values.empty())
+    {
+      --m_unused_entry_count;
+    }
+    ++values[value];
+  }
+
+  /**
+   * Removes the given value using the given key.
+   *
+   * @param key the key to remove
+   * @param value the value to remove
+   * @return `true` if the given value was found under the given key, and `false`
+   * otherwise
+   */
+  bool remove(const std::string_view key, const V& value)
+  {
+    const auto key_it = m_key_ids.find(std::string{key});
+    if (key_it == m_key_ids.end())
+    {
+      return false;
+    }
+
+    auto& values = m_entries[key_it->second].values;
+    const auto value_it = values.find(value);
+    if (value_it == values.end())
+    {
+      return false;
+    }
+
+    if (--value_it->second == 0u)
+    {
+      values.erase(value_it);
+      if (values.empty())
+      {
+        ++m_unused_entry_count;
+        if (
+          m_unused_entry_count >= min_unused_entries_to_rebuild
+          && m_unused_entry_count > m_entries.size() / 2u)
+        {
+          rebuild();
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Clears this index.
+   */
+  void clear()
+  {
+    m_key_ids.clear();
+    m_entries.clear();
+    m_key_ids_by_trigram.clear();
+    m_unused_entry_count = 0u;
+  }
+
+  /**
+   * Indicates whether the given pattern contains a literal part of at least three
+   * characters. Only such patterns benefit from this index, all other patterns are
+   * matched against every key.
+   *
+   * Returns `false` if the given pattern contains an invalid escape sequence.
+   *
+   * @param pattern the pattern to check
+   */
+  static bool has_trigrams(const std::string_view pattern)
+  {
+    return !get_trigrams(pattern).empty();
+  }
+
+  /**
+   * Finds all values whose keys match the given glob pattern. See `kdl::str_matches_glob`
+   * for the definition and semantics of glob patterns and adds the values to the given
+   * output iterator. Just like `compact_trie`, a value is added once for every time it
+   * was inserted under a matching key.
+   *
+   * Unlike `compact_trie`, a pattern with an invalid escape sequence does not throw, but
+   * matches no keys.
+   *
+   * @tparam O the type of the output iterator
+   * @param pattern the pattern to match
+   * @param out the output iterator
+   */
+  template <typename O>
+  void find_matches(const std::string_view pattern, O out) const
+  {
+    const auto trigrams = get_trigrams(pattern);
+    if (trigrams.empty())
+    {
+      for (const auto& e : m_entries)
+      {
+        get_values_if_matches(e, pattern, out);
+      }
+      return;
+    }
+
+    auto key_id_lists = std::vector<const std::vector<key_id>*>{};
+    key_id_lists.reserve(trigrams.size());
+    for (const auto t : trigrams)
+    {
+      const auto it = m_key_ids_by_trigram.find(t);
+      if (it == m_key_ids_by_trigram.end())
+      {
+        return;
+      }
+      key_id_lists.push_back(&it->second);
+    }
+
+    // start with the shortest list and only keep the keys that are in every other list
+    std::ranges::sort(key_id_lists, [](const auto* lhs, const auto* rhs) {
+      return lhs->size() < rhs->size();
+    });
+
+    auto candidates = *key_id_lists.front();
+    for (auto it = std::next(key_id_lists.begin());
+         it != key_id_lists.end() && !candidates.empty();
+         ++it)
+    {
+      std::erase_if(candidates, [&](const auto id) {
+        return !std::ranges::binary_search(**it, id);
+      });
+    }
+
+    for (const auto id : candidates)
+    {
+      get_values_if_matches(m_entries[id], pattern, out);
+    }
+  }
+
+private:
+  static trigram make_trigram(const char c1, const char c2, const char c3)
+  {
+    return trigram(static_cast<unsigned char>(c1)) << 16u
+           | trigram(static_cast<unsigned char>(c2)) << 8u
+           | trigram(static_cast<unsigned char>(c3));
+  }
+
+  /**
+   * Returns the sorted trigrams of the literal parts of the given pattern, or an empty
+   * vector if the pattern contains an invalid escape sequence.
+   */
+  static std::vector<trigram> get_trigrams(const std::string_view pattern)
+  {
+    auto result = std::vector<trigram>{};
+    auto literal = std::string{};
+
+    const auto add_literal_trigrams = [&]() {
+      for (std::size_t i = 2u; i < literal.size(); ++i)
+      {
+        result.push_back(make_trigram(literal[i - 2u], literal[i - 1u], literal[i]));
+      }
+      literal.clear();
+    };
+
+    for (std::size_t i = 0u; i < pattern.size(); ++i)
+    {
+      const auto c = pattern[i];
+      if (c == '\\' && i < pattern.size() - 1u)
+      {
+        const auto n = pattern[++i];
+        if (n != '*' && n != '?' && n != '%' && n != '\\')
+        {
+          return {};
+        }
+        literal.push_back(n);
+      }
+      else if (c == '*' || c == '?' || c == '%')
+      {
+        add_literal_trigrams();
+      }
+      else
+      {
+        literal.push_back(c);
+      }
+    }
+    add_literal_trigrams();
+
+    std::ranges::sort(result);
+    const auto [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+    return result;
+  }
+
+  void add_trigrams(const std::string_view key, const key_id id)
+  {
+    for (std::size_t i = 2u; i < key.size(); ++i)
+    {
+      // ids are assigned in ascending order, so appending keeps the lists sorted
+      auto& ids = m_key_ids_by_trigram[make_trigram(key[i - 2u], key[i - 1u], key[i])];
+      if (ids.empty() || ids.back() != id)
+      {
+        ids.push_back(id);
+      }
+    }
+  }
+
+  void rebuild()
+  {
+    auto old_entries = std::move(m_entries);
+    m_entries.clear();
+    m_key_ids_by_trigram.clear();
+    m_unused_entry_count = 0u;
+
+    for (auto& e : old_entries)
+    {
+      if (e.values.empty())
+      {
+        m_key_ids.erase(m_key_ids.find(*e.key));
+      }
+      else
+      {
+        const auto id = key_id(m_entries.size());
+        m_key_ids[*e.key] = id;
+        add_trigrams(*e.key, id);
+        m_entries.push_back(std::move(e));
+      }
+    }
+  }
+
+  template <typename O>
+  static void get_values_if_matches(
+    const entry& e, const std::string_view pattern, O& out)
+  {
+    if (!e.values.empty() && cs::str_matches_glob(*e.key, pattern))
+    {
+      for (const auto& [value, count] : e.values)
+      {
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+          out++ = value;
+        }
+      }
+    }
+  }
+};
+
+} // namespace kdl
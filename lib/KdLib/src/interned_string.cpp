@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/interned_string.h"
+
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace kdl
+{
+namespace
+{
+
+struct string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(const std::string_view str) const
+  {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+class string_table
+{
+private:
+  // node based, so pointers to the stored strings remain valid when the table grows
+  std::unordered_set<std::string, string_hash, std::equal_to<>> m_strings;
+  mutable std::shared_mutex m_mutex;
+
+public:
+  const std::string* intern(const std::string_view str)
+  {
+    {
+      const auto lock = std::shared_lock{m_mutex};
+      if (const auto it = m_strings.find(str); it != m_strings.end())
+      {
+        return &*it;
+      }
+    }
+
+    const auto lock = std::unique_lock{m_mutex};
+    return &*m_strings.emplace(str).first;
+  }
+
+  std::size_t size() const
+  {
+    const auto lock = std::shared_lock{m_mutex};
+    return m_strings.size();
+  }
+};
+
+string_table& table()
+{
+  // intentionally leaked so that interned strings outlive all static objects
+  static auto* instance = new string_table{};
+  return *instance;
+}
+
+const std::string* intern_empty()
+{
+  static const auto* empty = table().intern("");
+  return empty;
+}
+
+} // namespace
+
+interned_string::interned_string()
+  : m_str{intern_empty()}
+{
+}
+
+interned_string::interned_string(const std::string_view str)
+  : m_str{str.empty() ? intern_empty() : table().intern(str)}
+{
+}
+
+interned_string::interned_string(const std::string& str)
+  : interned_string{std::string_view{str}}
+{
+}
+
+interned_string::interned_string(const char* str)
+  : interned_string{std::string_view{str}}
+{
+}
+
+std::size_t interned_string::interned_count()
+{
+  return table().size();
+}
+
+std::ostream& operator<<(std::ostream& lhs, const interned_string& rhs)
+{
+  return lhs << rhs.str();
+}
+
+} // namespace kdl
@@ -20,64 +20,289 @@
 
 #include "kd/task_manager.h"
 
+#include <algorithm>
 #include <condition_variable>
-#include <functional>
-#include <future>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <mutex>
-#include <queue>
-#include <ranges>
+#include <iterator>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace kdl
 {
+namespace
+{
+
+/** The task manager that owns the current thread, if any. */
+thread_local const task_manager* current_task_manager = nullptr;
+
+/** The index of the current thread's queue if it is a worker thread. */
+thread_local std::size_t current_worker_index = 0;
+
+} // namespace
+
+task_manager::task_group::task_group(const std::size_t chunk_count)
+  : m_remaining{chunk_count}
+{
+}
+
+void task_manager::task_group::finish_chunk(std::exception_ptr exception)
+{
+  // notify while holding the lock, the waiting thread destroys this group once it
+  // observes that all chunks are done
+  auto lock = std::lock_guard{m_mutex};
+  if (exception && !m_exception)
+  {
+    m_exception = std::move(exception);
+  }
+  if (--m_remaining == 0)
+  {
+    m_cv.notify_all();
+  }
+}
+
+bool task_manager::task_group::done()
+{
+  auto lock = std::lock_guard{m_mutex};
+  return m_remaining == 0;
+}
+
+void task_manager::task_group::wait()
+{
+  auto lock = std::unique_lock{m_mutex};
+  m_cv.wait(lock, [&] { return m_remaining == 0; });
+}
+
+void task_manager::task_group::rethrow_exception()
+{
+  if (m_exception)
+  {
+    std::rethrow_exception(m_exception);
+  }
+}
+
+void task_manager::run_worker(const std::size_t worker_index)
+{
+  current_task_manager = this;
+  current_worker_index = worker_index;
+
+  while (m_running)
+  {
+    if (!run_pending_task())
+    {
+      auto lock = std::unique_lock{m_idle_mutex};
+      m_idle_cv.wait(lock, [&] { return !m_running || m_pending_count > 0; });
+    }
+  }
+}
+
+void task_manager::push_task(const pending_task& task)
+{
+  const auto queue_index = current_task_manager == this
+                             ? current_worker_index
+                             : m_next_queue++ % m_queues.size();
+
+  // count the task before it becomes visible, otherwise a worker could take it and
+  // decrement the counter before it was incremented
+  {
+    auto lock = std::lock_guard{m_idle_mutex};
+    ++m_pending_count;
+  }
+
+  {
+    auto& queue = *m_queues[queue_index];
+    auto lock = std::lock_guard{queue.mutex};
+    queue.tasks.push_back(task);
+  }
+  m_idle_cv.notify_one();
+}
 
-std::function<void()> task_manager::make_worker_func()
+void task_manager::push_chunks(
+  void (*invoke)(void*, std::size_t, std::size_t),
+  void* context,
+  const task_group& group,
+  const std::size_t begin,
+  const std::size_t end,
+  const std::size_t grain)
 {
-  return [&] {
-    while (true)
+  const auto chunk_count = (end - begin + grain - 1) / grain;
+  const auto queue_count = std::min(chunk_count, m_queues.size());
+  const auto first_queue = current_task_manager == this
+                             ? current_worker_index
+                             : m_next_queue++ % m_queues.size();
+
+  {
+    auto lock = std::lock_guard{m_idle_mutex};
+    m_pending_count += chunk_count;
+  }
+
+  // deal out contiguous runs of chunks so that every queue is locked only once
+  for (std::size_t q = 0; q < queue_count; ++q)
+  {
+    const auto first_chunk = chunk_count * q / queue_count;
+    const auto last_chunk = chunk_count * (q + 1) / queue_count;
+
+    auto& queue = *m_queues[(first_queue + q) % m_queues.size()];
+    auto lock = std::lock_guard{queue.mutex};
+    for (auto c = first_chunk; c < last_chunk; ++c)
     {
-      auto lock = std::unique_lock{m_pending_tasks_mutex};
-      m_pending_tasks_cv.wait(
-        lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+      const auto chunk_begin = begin + c * grain;
+      const auto chunk_end = std::min(chunk_begin + grain, end);
+      queue.tasks.push_back(
+        pending_task{invoke, nullptr, context, &group, chunk_begin, chunk_end});
+    }
+  }
+  m_idle_cv.notify_all();
+}
 
-      if (!m_running)
+std::optional<task_manager::pending_task> task_manager::pop_task()
+{
+  const auto is_worker = current_task_manager == this;
+  const auto first_queue = is_worker ? current_worker_index : std::size_t(0);
+
+  for (std::size_t i = 0; i < m_queues.size(); ++i)
+  {
+    auto& queue = *m_queues[(first_queue + i) % m_queues.size()];
+    auto lock = std::lock_guard{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      // workers take their own most recent task, but steal the oldest tasks of others
+      const auto own_queue = is_worker && i == 0;
+      auto task = own_queue ? queue.tasks.back() : queue.tasks.front();
+      if (own_queue)
       {
-        break;
+        queue.tasks.pop_back();
       }
-
-      if (!m_pending_tasks.empty())
+      else
       {
-        auto task = std::move(m_pending_tasks.front());
-        m_pending_tasks.pop();
-        lock.unlock();
+        queue.tasks.pop_front();
+      }
+
+      --m_pending_count;
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<task_manager::pending_task> task_manager::pop_chunk(
+  const task_group& group)
+{
+  const auto is_worker = current_task_manager == this;
+  const auto first_queue = is_worker ? current_worker_index : std::size_t(0);
+
+  for (std::size_t i = 0; i < m_queues.size(); ++i)
+  {
+    auto& queue = *m_queues[(first_queue + i) % m_queues.size()];
+    auto lock = std::lock_guard{queue.mutex};
 
-        task();
+    // the chunks of a group are queued in order, so take the last one from our own queue
+    // and the first one from the queues of others like pop_task does
+    const auto is_chunk = [&](const auto& task) { return task.group == &group; };
+    auto it = queue.tasks.end();
+    if (is_worker && i == 0)
+    {
+      const auto rit = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), is_chunk);
+      if (rit != queue.tasks.rend())
+      {
+        it = std::prev(rit.base());
       }
     }
-  };
+    else
+    {
+      it = std::find_if(queue.tasks.begin(), queue.tasks.end(), is_chunk);
+    }
+
+    if (it != queue.tasks.end())
+    {
+      auto task = *it;
+      queue.tasks.erase(it);
+
+      --m_pending_count;
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+bool task_manager::run_pending_task()
+{
+  if (const auto task = pop_task())
+  {
+    task->invoke(task->context, task->begin, task->end);
+    return true;
+  }
+  return false;
+}
+
+void task_manager::wait_for(task_group& group)
+{
+  // Only run chunks of the given group, an unrelated task might take arbitrarily long and
+  // block the waiting thread. All chunks of the group were queued before we started
+  // waiting, and tasks never move between queues. Once no chunk of the group is pending,
+  // every chunk is running somewhere and we can block.
+  while (!group.done())
+  {
+    if (const auto chunk = pop_chunk(group))
+    {
+      chunk->invoke(chunk->context, chunk->begin, chunk->end);
+    }
+    else
+    {
+      group.wait();
+      break;
+    }
+  }
+}
+
+std::size_t task_manager::default_grain(const std::size_t count) const
+{
+  // aim for several chunks per worker so that stealing can balance uneven tasks
+  const auto worker_count = std::max(m_workers.size(), std::size_t(1));
+  return std::max(count / (worker_count * 8), std::size_t(1));
 }
 
 task_manager::task_manager(const std::size_t max_concurrent_tasks)
 {
-  for (size_t i = 0; i < max_concurrent_tasks; ++i)
+  for (std::size_t i = 0; i < max_concurrent_tasks; ++i)
+  {
+    m_queues.push_back(std::make_unique<worker_queue>());
+  }
+
+  for (std::size_t i = 0; i < max_concurrent_tasks; ++i)
   {
-    m_workers.emplace_back(make_worker_func());
+    m_workers.emplace_back([&, i] { run_worker(i); });
   }
 }
 
 task_manager::~task_manager()
 {
   {
-    auto lock = std::lock_guard{m_pending_tasks_mutex};
+    auto lock = std::lock_guard{m_idle_mutex};
     m_running = false;
   }
 
-  m_pending_tasks_cv.notify_all();
+  m_idle_cv.notify_all();
   for (auto& worker : m_workers)
   {
     worker.join();
   }
+
+  for (auto& queue : m_queues)
+  {
+    for (const auto& task : queue->tasks)
+    {
+      if (task.discard)
+      {
+        task.discard(task.context);
+      }
+    }
+  }
 }
 
 } // namespace kdl
@@ -214,4 +214,25 @@ TEST_CASE("compact_trie_test.get_keys")
     UnorderedEquals(std::vector<std::string>{"key", "key2", "key22", "key22bs", "k1"}));
 }
 
+TEST_CASE("compact_trie_test.for_each_value")
+{
+  test_index index;
+  index.insert("key", "value");
+  index.insert("key2", "value");
+  index.insert("key2", "value");
+  index.insert("key22", "value2");
+  index.insert("k1", "value3");
+  index.remove("k1", "value3");
+
+  std::vector<std::string> entries;
+  index.for_each_value([&](const std::string_view key, const std::string& value) {
+    entries.push_back(std::string{key} + "=" + value);
+  });
+
+  CHECK_THAT(
+    entries,
+    UnorderedEquals(std::vector<std::string>{
+      "key=value", "key2=value", "key2=value", "key22=value2"}));
+}
+
 } // namespace kdl
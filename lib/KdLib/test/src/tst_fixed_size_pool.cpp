@@ -0,0 +1,166 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/fixed_size_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace kdl
+{
+namespace
+{
+
+struct pooled : public pool_allocated<pooled>
+{
+  double value;
+
+  explicit pooled(const double value_)
+    : value{value_}
+  {
+  }
+};
+
+template <typename Pool>
+struct block_holder
+{
+  void* block = nullptr;
+
+  ~block_holder()
+  {
+    if (block)
+    {
+      Pool::deallocate(block);
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE("fixed_size_pool")
+{
+  using pool = fixed_size_pool<24, 8>;
+
+  SECTION("allocate returns distinct aligned blocks")
+  {
+    auto blocks = std::vector<void*>{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    CHECK(std::set<void*>{blocks.begin(), blocks.end()}.size() == blocks.size());
+    CHECK(std::ranges::all_of(blocks, [](const auto* block) {
+      return reinterpret_cast<std::uintptr_t>(block) % 8 == 0;
+    }));
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("deallocated blocks are reused")
+  {
+    auto* block = pool::allocate();
+    pool::deallocate(block);
+
+    CHECK(pool::allocate() == block);
+    pool::deallocate(block);
+  }
+
+  SECTION("blocks can be freed on another thread")
+  {
+    auto blocks = std::vector<void*>{};
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    const auto chunk_count = pool::chunk_count();
+    auto thread = std::thread{[&] {
+      for (auto* block : blocks)
+      {
+        pool::deallocate(block);
+      }
+    }};
+    thread.join();
+
+    // the freeing thread has returned its blocks to the pool when it exited, which
+    // released the chunks whose blocks are all free now
+    CHECK(pool::chunk_count() < chunk_count);
+  }
+
+  SECTION("chunks are released when all of their blocks are free")
+  {
+    const auto initial_chunk_count = pool::chunk_count();
+
+    auto blocks = std::vector<void*>{};
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+    CHECK(pool::chunk_count() > initial_chunk_count + 10);
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+
+    // the calling thread's free list may still keep a few chunks alive
+    CHECK(pool::chunk_count() <= initial_chunk_count + 3);
+  }
+
+  SECTION("blocks can be freed after the thread's free list was destroyed")
+  {
+    const auto chunk_count = pool::chunk_count();
+
+    auto thread = std::thread{[&] {
+      // thread local objects are destroyed in reverse order of their construction, so
+      // the holder frees its block after the pool's free list for this thread is gone
+      thread_local auto holder = block_holder<pool>{};
+      holder.block = pool::allocate();
+    }};
+    thread.join();
+
+    // the block was returned to its chunk, so no chunk was leaked
+    CHECK(pool::chunk_count() <= chunk_count);
+  }
+}
+
+TEST_CASE("pool_allocated")
+{
+  auto* p1 = new pooled{1.0};
+  auto* p2 = new pooled{2.0};
+
+  CHECK(p1 != p2);
+  CHECK(p1->value == 1.0);
+  CHECK(p2->value == 2.0);
+
+  delete p1;
+  delete p2;
+}
+
+} // namespace kdl
@@ -0,0 +1,115 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/interned_string.h"
+#include "kd/task_manager.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace kdl
+{
+
+using namespace std::string_literals;
+
+TEST_CASE("interned_string")
+{
+  SECTION("default constructor")
+  {
+    CHECK(interned_string{}.empty());
+    CHECK(interned_string{}.str() == "");
+    CHECK(interned_string{} == interned_string{""});
+  }
+
+  SECTION("equal strings share storage")
+  {
+    const auto a = interned_string{"interned_string_test"};
+    const auto b = interned_string{"interned_string_test"s};
+    const auto c = interned_string{std::string_view{"interned_string_test"}};
+
+    CHECK(a == b);
+    CHECK(a == c);
+    CHECK(&a.str() == &b.str());
+    CHECK(&a.str() == &c.str());
+    CHECK(a.str() == "interned_string_test");
+    CHECK(a.size() == 20);
+  }
+
+  SECTION("interning an existing string does not grow the table")
+  {
+    const auto a = interned_string{"interned_string_existing"};
+    const auto count = interned_string::interned_count();
+    const auto b = interned_string{"interned_string_existing"};
+
+    CHECK(interned_string::interned_count() == count);
+    CHECK(a == b);
+  }
+
+  SECTION("comparison")
+  {
+    const auto a = interned_string{"a"};
+    const auto b = interned_string{"b"};
+
+    CHECK(a != b);
+    CHECK(a < b);
+    CHECK(b > a);
+    CHECK((a <=> interned_string{"a"}) == std::strong_ordering::equal);
+  }
+
+  SECTION("hash")
+  {
+    CHECK(
+      std::hash<interned_string>{}(interned_string{"hash"})
+      == std::hash<interned_string>{}(interned_string{"hash"s}));
+  }
+
+  SECTION("operator<<")
+  {
+    auto str = std::stringstream{};
+    str << interned_string{"asdf"};
+    CHECK(str.str() == "asdf");
+  }
+
+  SECTION("concurrent interning")
+  {
+    auto taskManager = task_manager{4};
+
+    auto tasks = std::vector<std::function<const std::string*()>>{};
+    for (size_t i = 0; i < 256; ++i)
+    {
+      tasks.emplace_back([i]() {
+        return &interned_string{"concurrent" + std::to_string(i % 8)}.str();
+      });
+    }
+
+    auto results = taskManager.run_tasks_and_wait(tasks);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      CHECK(results[i] == &interned_string{"concurrent" + std::to_string(i % 8)}.str());
+    }
+  }
+}
+
+} // namespace kdl
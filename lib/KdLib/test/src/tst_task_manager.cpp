@@ -22,9 +22,16 @@
 #include "kd/ranges/to.h"
 #include "kd/task_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 #include <tuple>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
@@ -83,6 +90,15 @@ TEST_CASE("task_manager")
     CHECK(future3.get() == 15);
   }
 
+  SECTION("run_task stores exceptions in the future")
+  {
+    auto future = tm.run_task(std::function{[]() -> int {
+      throw std::runtime_error{"error"};
+    }});
+
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
   SECTION("run_tasks")
   {
     auto [task1, task_ran1] = make_task(4);
@@ -125,6 +141,91 @@ TEST_CASE("task_manager")
     CHECK(task_ran2);
     CHECK(task_ran3);
   }
+
+  SECTION("run_tasks_and_wait with a view")
+  {
+    CHECK(
+      tm.run_tasks_and_wait(std::views::iota(0, 100) | std::views::transform([](int i) {
+                              return std::function{[i] { return i * 2; }};
+                            }))
+      == (std::views::iota(0, 100) | std::views::transform([](int i) { return i * 2; })
+          | kdl::ranges::to<std::vector>()));
+  }
+
+  SECTION("run_range")
+  {
+    const auto grain = GENERATE(0u, 1u, 7u, 1000u);
+    CAPTURE(grain);
+
+    auto counts = std::vector<std::atomic<int>>(1000);
+    tm.run_range(0, counts.size(), grain, [&](const std::size_t i) { ++counts[i]; });
+
+    CHECK(std::ranges::all_of(counts, [](const auto& count) { return count == 1; }));
+  }
+
+  SECTION("run_range with empty range")
+  {
+    auto count = std::atomic<int>{0};
+    tm.run_range(5, 5, 1, [&](const std::size_t) { ++count; });
+
+    CHECK(count == 0);
+  }
+
+  SECTION("nested run_range")
+  {
+    auto count = std::atomic<int>{0};
+    tm.run_range(0, 16, 1, [&](const std::size_t) {
+      tm.run_range(0, 100, 3, [&](const std::size_t) { ++count; });
+    });
+
+    CHECK(count == 1600);
+  }
+
+  SECTION("run_range rethrows exceptions")
+  {
+    CHECK_THROWS_AS(
+      tm.run_range(
+        0,
+        100,
+        1,
+        [](const std::size_t i) {
+          if (i == 50)
+          {
+            throw std::runtime_error{"error"};
+          }
+        }),
+      std::runtime_error);
+  }
+}
+
+TEST_CASE("task_manager waiting threads only run chunks of their batch")
+{
+  auto tm = task_manager{1};
+
+  // keep the only worker busy so that the unrelated task stays queued
+  auto worker_started = std::promise<void>{};
+  auto release_worker = std::promise<void>{};
+  auto worker_released = release_worker.get_future().share();
+  auto blocking_future = tm.run_task(std::function{[&, worker_released] {
+    worker_started.set_value();
+    worker_released.wait();
+    return 0;
+  }});
+  worker_started.get_future().wait();
+
+  auto unrelated_future =
+    tm.run_task(std::function{[] { return std::this_thread::get_id(); }});
+
+  auto chunk_threads = std::vector<std::thread::id>(2);
+  tm.run_range(0, chunk_threads.size(), 1, [&](const std::size_t i) {
+    chunk_threads[i] = std::this_thread::get_id();
+  });
+
+  release_worker.set_value();
+  CHECK(blocking_future.get() == 0);
+
+  CHECK(chunk_threads == std::vector(2, std::this_thread::get_id()));
+  CHECK(unrelated_future.get() != std::this_thread::get_id());
 }
 
 TEST_CASE("task_manager stress test")
@@ -162,4 +263,88 @@ TEST_CASE("task_manager stress test")
   CHECK(results == results);
 }
 
+TEST_CASE("task_manager (Benchmark)", "[.][benchmark]")
+{
+  auto tm = task_manager{};
+
+  const auto task_count = 500'000;
+  const auto tasks =
+    std::views::iota(0, task_count)
+    | std::views::transform([](int i) { return std::function{[i] { return i; }}; })
+    | kdl::ranges::to<std::vector>();
+
+  BENCHMARK("run_tasks")
+  {
+    auto futures = tm.run_tasks(tasks);
+    return futures | std::views::transform([](auto& future) { return future.get(); })
+           | kdl::ranges::to<std::vector>();
+  };
+
+  BENCHMARK("run_tasks_and_wait")
+  {
+    return tm.run_tasks_and_wait(tasks);
+  };
+
+  BENCHMARK("run_range")
+  {
+    auto results = std::vector<int>(task_count);
+    tm.run_range(0, results.size(), 1024, [&](const std::size_t i) {
+      results[i] = int(i);
+    });
+    return results;
+  };
+
+  const auto submitter_count = std::size_t(8);
+  const auto submitted_task_count = 50'000;
+
+  BENCHMARK("concurrent run_tasks_and_wait")
+  {
+    auto sum = std::atomic<int>{0};
+    auto submitters = std::vector<std::thread>{};
+    for (std::size_t i = 0; i < submitter_count; ++i)
+    {
+      submitters.emplace_back([&] {
+        const auto tasks = std::vector<std::function<int()>>(
+          std::size_t(submitted_task_count), [] { return 1; });
+        for (const auto result : tm.run_tasks_and_wait(tasks))
+        {
+          sum += result;
+        }
+      });
+    }
+
+    for (auto& submitter : submitters)
+    {
+      submitter.join();
+    }
+    return sum.load();
+  };
+
+  BENCHMARK("concurrent run_task")
+  {
+    auto sum = std::atomic<int>{0};
+    auto submitters = std::vector<std::thread>{};
+    for (std::size_t i = 0; i < submitter_count; ++i)
+    {
+      submitters.emplace_back([&] {
+        auto futures = std::vector<std::future<int>>{};
+        for (int j = 0; j < submitted_task_count; ++j)
+        {
+          futures.push_back(tm.run_task(std::function{[] { return 1; }}));
+        }
+        for (auto& future : futures)
+        {
+          sum += future.get();
+        }
+      });
+    }
+
+    for (auto& submitter : submitters)
+    {
+      submitter.join();
+    }
+    return sum.load();
+  };
+}
+
 } // namespace kdl
@@ -0,0 +1,271 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/compact_trie.h"
+#include "kd/trigram_index.h"
+#include "kd/vector_utils.h"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace kdl
+{
+using namespace Catch::Matchers;
+
+namespace
+{
+using test_index = trigram_index<std::string>;
+
+std::vector<std::string> findMatches(const test_index& index, const std::string& pattern)
+{
+  auto matches = std::vector<std::string>{};
+  index.find_matches(pattern, std::back_inserter(matches));
+  return matches;
+}
+
+std::vector<std::string> findMatches(
+  const compact_trie<std::string>& trie, const std::string& pattern)
+{
+  auto matches = std::vector<std::string>{};
+  trie.find_matches(pattern, std::back_inserter(matches));
+  return matches;
+}
+
+/**
+ * Returns every key of at most the given length over a small alphabet.
+ */
+std::vector<std::string> makeKeys(const std::size_t maxLength)
+{
+  static const auto chars = std::string{"ab12_ "};
+
+  auto keys = std::vector<std::string>{""};
+  for (std::size_t length = 0, begin = 0; length < maxLength; ++length)
+  {
+    const auto end = keys.size();
+    for (auto i = begin; i < end; ++i)
+    {
+      for (const auto c : chars)
+      {
+        keys.push_back(keys[i] + c);
+      }
+    }
+    begin = end;
+  }
+  return keys;
+}
+
+} // namespace
+
+TEST_CASE("trigram_index")
+{
+  auto index = test_index{};
+  index.insert("key", "value");
+  index.insert("key2", "value");
+  index.insert("key22", "value2");
+  index.insert("k1", "value3");
+  index.insert("test", "value4");
+  index.insert("some_test_key", "value5");
+  index.insert("a*b", "value6");
+
+  SECTION("has_trigrams")
+  {
+    CHECK(test_index::has_trigrams("key"));
+    CHECK(test_index::has_trigrams("*key*"));
+    CHECK(test_index::has_trigrams("a\\*b"));
+    CHECK_FALSE(test_index::has_trigrams("ke"));
+    CHECK_FALSE(test_index::has_trigrams("k*ey"));
+    CHECK_FALSE(test_index::has_trigrams("k?y"));
+    CHECK_FALSE(test_index::has_trigrams("*"));
+    CHECK_FALSE(test_index::has_trigrams(""));
+    CHECK_FALSE(test_index::has_trigrams("key\\x"));
+  }
+
+  SECTION("find_matches")
+  {
+    CHECK_THAT(findMatches(index, "whoops"), UnorderedEquals(std::vector<std::string>{}));
+    CHECK_THAT(
+      findMatches(index, "key"), UnorderedEquals(std::vector<std::string>{"value"}));
+    CHECK_THAT(
+      findMatches(index, "key*"),
+      UnorderedEquals(std::vector<std::string>{"value", "value", "value2"}));
+    CHECK_THAT(
+      findMatches(index, "*key*"),
+      UnorderedEquals(std::vector<std::string>{"value", "value", "value2", "value5"}));
+    CHECK_THAT(
+      findMatches(index, "*test*"),
+      UnorderedEquals(std::vector<std::string>{"value4", "value5"}));
+    CHECK_THAT(
+      findMatches(index, "key%"), UnorderedEquals(std::vector<std::string>{"value"}));
+    CHECK_THAT(
+      findMatches(index, "key%*"),
+      UnorderedEquals(std::vector<std::string>{"value", "value", "value2"}));
+    CHECK_THAT(
+      findMatches(index, "k?y"), UnorderedEquals(std::vector<std::string>{"value"}));
+    CHECK_THAT(
+      findMatches(index, "k%"), UnorderedEquals(std::vector<std::string>{"value3"}));
+    CHECK_THAT(
+      findMatches(index, "a\\*b"), UnorderedEquals(std::vector<std::string>{"value6"}));
+    CHECK_THAT(
+      findMatches(index, "a*b"), UnorderedEquals(std::vector<std::string>{"value6"}));
+    CHECK_THAT(findMatches(index, "key\\x"), UnorderedEquals(std::vector<std::string>{}));
+  }
+
+  SECTION("values are found once for every time they were inserted")
+  {
+    index.insert("key", "value");
+
+    CHECK_THAT(
+      findMatches(index, "key"),
+      UnorderedEquals(std::vector<std::string>{"value", "value"}));
+  }
+
+  SECTION("remove")
+  {
+    CHECK_FALSE(index.remove("whoops", "value"));
+    CHECK_FALSE(index.remove("key", "value2"));
+
+    CHECK(index.remove("key2", "value"));
+    CHECK_FALSE(index.remove("key2", "value"));
+
+    CHECK_THAT(
+      findMatches(index, "*key*"),
+      UnorderedEquals(std::vector<std::string>{"value", "value2", "value5"}));
+
+    index.insert("key2", "value7");
+
+    CHECK_THAT(
+      findMatches(index, "*key*"),
+      UnorderedEquals(std::vector<std::string>{"value", "value2", "value5", "value7"}));
+  }
+
+  SECTION("clear")
+  {
+    index.clear();
+
+    CHECK_THAT(findMatches(index, "*"), UnorderedEquals(std::vector<std::string>{}));
+    CHECK_THAT(findMatches(index, "*key*"), UnorderedEquals(std::vector<std::string>{}));
+  }
+}
+
+TEST_CASE("trigram_index matches like compact_trie")
+{
+  auto index = test_index{};
+  auto trie = compact_trie<std::string>{};
+
+  // insert enough keys so that removing most of them rebuilds the index
+  const auto keys = makeKeys(5);
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    index.insert(keys[i], std::to_string(i));
+    trie.insert(keys[i], std::to_string(i));
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    if (i % 4 != 0)
+    {
+      CHECK(index.remove(keys[i], std::to_string(i)));
+      CHECK(trie.remove(keys[i], std::to_string(i)));
+    }
+  }
+
+  for (const auto& pattern : {
+         "",
+         "*",
+         "ab",
+         "ab1",
+         "ab12",
+         "*ab1*",
+         "*b_a*",
+         "* a?*",
+         "*12*%",
+         "a%*_",
+         "*1_2*b",
+         "?b12*",
+         "*ab*ab*",
+       })
+  {
+    CAPTURE(pattern);
+
+    // compact_trie can find a value more than once if its key matches the pattern in
+    // several ways
+    CHECK(
+      vec_sort(findMatches(index, pattern))
+      == vec_sort_and_remove_duplicates(findMatches(trie, pattern)));
+  }
+}
+
+TEST_CASE("trigram_index (Benchmark)", "[.][benchmark]")
+{
+  auto index = test_index{};
+  auto trie = compact_trie<std::string>{};
+
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    const auto value = std::to_string(i);
+    for (const auto& key : std::vector<std::string>{
+           "light",
+           "monster_" + std::to_string(i % 50),
+           "target_" + value,
+           std::to_string(i % 4096) + " " + std::to_string(i % 777) + " 64",
+         })
+    {
+      index.insert(key, value);
+      trie.insert(key, value);
+    }
+  }
+
+  BENCHMARK("compact_trie *get_123*")
+  {
+    return findMatches(trie, "*get_123*");
+  };
+
+  BENCHMARK("trigram_index *get_123*")
+  {
+    return findMatches(index, "*get_123*");
+  };
+
+  BENCHMARK("compact_trie *ster_4*")
+  {
+    return findMatches(trie, "*ster_4*");
+  };
+
+  BENCHMARK("trigram_index *ster_4*")
+  {
+    return findMatches(index, "*ster_4*");
+  };
+
+  BENCHMARK("compact_trie target_123*")
+  {
+    return findMatches(trie, "target_123*");
+  };
+
+  BENCHMARK("trigram_index target_123*")
+  {
+    return findMatches(index, "target_123*");
+  };
+}
+
+} // namespace kdl
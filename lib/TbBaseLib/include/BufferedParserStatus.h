@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FileLocation.h"
+#include "ParserStatus.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * Records all messages instead of logging them so that they can be forwarded to another
+ * parser status later. This allows parsing parts of a file in parallel while reporting
+ * the messages in the same order as if the file had been parsed sequentially.
+ *
+ * Progress updates are ignored.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  struct Message
+  {
+    LogLevel level;
+    std::optional<FileLocation> location;
+    std::string str;
+  };
+
+  std::vector<Message> m_messages;
+
+public:
+  BufferedParserStatus();
+
+  /**
+   * Indicates whether no messages have been recorded.
+   */
+  bool empty() const;
+
+  /**
+   * Forwards all recorded messages to the given status and clears them.
+   */
+  void forwardTo(ParserStatus& status);
+
+private:
+  void log(LogLevel level, const FileLocation& location, const std::string& str) override;
+  void log(LogLevel level, const std::string& str) override;
+
+  void doProgress(double progress) override;
+};
+
+} // namespace tb
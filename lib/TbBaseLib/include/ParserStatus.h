@@ -55,10 +55,10 @@ public:
   [[noreturn]] void errorAndThrow(const std::string& str);
 
 private:
-  void log(LogLevel level, const FileLocation& location, const std::string& str);
+  virtual void log(LogLevel level, const FileLocation& location, const std::string& str);
   std::string buildMessage(const FileLocation& location, const std::string& str) const;
 
-  void log(LogLevel level, const std::string& str);
+  virtual void log(LogLevel level, const std::string& str);
   std::string buildMessage(const std::string& str) const;
 
 private:
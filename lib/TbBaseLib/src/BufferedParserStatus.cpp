@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferedParserStatus.h"
+
+#include "Logger.h"
+#include "Macros.h"
+
+#include <string>
+
+namespace tb
+{
+namespace
+{
+
+void forwardMessage(
+  ParserStatus& status,
+  const LogLevel level,
+  const FileLocation& location,
+  const std::string& str)
+{
+  switch (level)
+  {
+  case LogLevel::Debug:
+    status.debug(location, str);
+    break;
+  case LogLevel::Info:
+    status.info(location, str);
+    break;
+  case LogLevel::Warn:
+    status.warn(location, str);
+    break;
+  case LogLevel::Error:
+    status.error(location, str);
+    break;
+    switchDefault();
+  }
+}
+
+void forwardMessage(ParserStatus& status, const LogLevel level, const std::string& str)
+{
+  switch (level)
+  {
+  case LogLevel::Debug:
+    status.debug(str);
+    break;
+  case LogLevel::Info:
+    status.info(str);
+    break;
+  case LogLevel::Warn:
+    status.warn(str);
+    break;
+  case LogLevel::Error:
+    status.error(str);
+    break;
+    switchDefault();
+  }
+}
+
+NullLogger& nullLogger()
+{
+  static auto logger = NullLogger{};
+  return logger;
+}
+
+} // namespace
+
+BufferedParserStatus::BufferedParserStatus()
+  : ParserStatus{nullLogger(), ""}
+{
+}
+
+bool BufferedParserStatus::empty() const
+{
+  return m_messages.empty();
+}
+
+void BufferedParserStatus::forwardTo(ParserStatus& status)
+{
+  for (const auto& message : m_messages)
+  {
+    if (message.location)
+    {
+      forwardMessage(status, message.level, *message.location, message.str);
+    }
+    else
+    {
+      forwardMessage(status, message.level, message.str);
+    }
+  }
+  m_messages.clear();
+}
+
+void BufferedParserStatus::log(
+  const LogLevel level, const FileLocation& location, const std::string& str)
+{
+  m_messages.push_back(Message{level, location, str});
+}
+
+void BufferedParserStatus::log(const LogLevel level, const std::string& str)
+{
+  m_messages.push_back(Message{level, std::nullopt, str});
+}
+
+void BufferedParserStatus::doProgress(const double /* progress */) {}
+
+} // namespace tb
@@ -45,7 +45,15 @@ const std::vector<std::string>& TestParserStatus::messages(const LogLevel level)
   return it != m_messages.end() ? it->second : Empty;
 }
 
-void TestParserStatus::doProgress(const double) {}
+const std::vector<double>& TestParserStatus::progressValues() const
+{
+  return m_progress;
+}
+
+void TestParserStatus::doProgress(const double progress)
+{
+  m_progress.push_back(progress);
+}
 
 void TestParserStatus::doLog(const LogLevel level, const std::string& str)
 {
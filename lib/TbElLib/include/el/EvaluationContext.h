@@ -34,14 +34,27 @@
 namespace tb::el
 {
 
+/**
+ * Controls whether an evaluation context records which expression produced each value.
+ * The trace is only used to attach file locations to error messages.
+ */
+enum class EvaluationTracing
+{
+  Enabled,
+  Disabled,
+};
+
 class EvaluationContext
 {
 private:
   std::unique_ptr<VariableStore> m_variables;
   std::unordered_map<Value, ExpressionNode> m_trace;
+  EvaluationTracing m_tracing = EvaluationTracing::Enabled;
 
   EvaluationContext();
+  explicit EvaluationContext(EvaluationTracing tracing);
   explicit EvaluationContext(const VariableStore& variables);
+  EvaluationContext(const VariableStore& variables, EvaluationTracing tracing);
 
 public:
   ~EvaluationContext();
@@ -105,4 +118,23 @@ auto withEvaluationContext(const F& f, Args&&... args)
   }
 }
 
+/**
+ * Like withEvaluationContext, but evaluates without recording a trace, which is
+ * considerably faster. If the evaluation fails, it is repeated with tracing enabled so
+ * that the returned error contains the same location information that
+ * withEvaluationContext would have reported.
+ *
+ * Since f may be called twice, it must not have any side effects.
+ */
+template <typename F, typename... Args>
+auto withUntracedEvaluationContext(const F& f, const Args&... args)
+{
+  auto result = withEvaluationContext(f, args..., EvaluationTracing::Disabled);
+  if (result.is_error())
+  {
+    return withEvaluationContext(f, args...);
+  }
+  return result;
+}
+
 } // namespace tb::el
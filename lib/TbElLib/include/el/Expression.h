@@ -122,6 +122,13 @@ public:
 
   ExpressionNode optimize(EvaluationContext& context) const;
 
+  /**
+   * Returns the names of all variables referenced by this expression, sorted and without
+   * duplicates. The result of evaluating this expression can only change if the value of
+   * one of these variables changes.
+   */
+  std::vector<std::string> variableNames() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
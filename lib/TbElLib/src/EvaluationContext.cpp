@@ -32,11 +32,24 @@ EvaluationContext::EvaluationContext()
 {
 }
 
+EvaluationContext::EvaluationContext(const EvaluationTracing tracing)
+  : m_variables{std::make_unique<VariableTable>()}
+  , m_tracing{tracing}
+{
+}
+
 EvaluationContext::EvaluationContext(const VariableStore& store)
   : m_variables{store.clone()}
 {
 }
 
+EvaluationContext::EvaluationContext(
+  const VariableStore& store, const EvaluationTracing tracing)
+  : m_variables{store.clone()}
+  , m_tracing{tracing}
+{
+}
+
 EvaluationContext::~EvaluationContext() = default;
 
 Value EvaluationContext::variableValue(const std::string& name) const
@@ -61,12 +74,19 @@ std::optional<FileLocation> EvaluationContext::location(const Value& value) cons
 
 Value EvaluationContext::trace(Value value, const ExpressionNode& expression)
 {
-  m_trace.emplace(value, expression);
+  if (m_tracing == EvaluationTracing::Enabled)
+  {
+    m_trace.emplace(value, expression);
+  }
   return value;
 }
 
 Value EvaluationContext::trace(Value value, const Value& original)
 {
+  if (m_tracing == EvaluationTracing::Disabled)
+  {
+    return value;
+  }
   if (const auto expression = this->expression(original))
   {
     return this->trace(value, *expression);
@@ -1432,6 +1432,46 @@ ExpressionNode ExpressionNode::optimize(EvaluationContext& context) const
     m_location};
 }
 
+std::vector<std::string> ExpressionNode::variableNames() const
+{
+  auto result = std::vector<std::string>{};
+  accept(kdl::overload(
+    [](const auto&, const LiteralExpression&) {},
+    [&](const auto&, const VariableExpression& expression) {
+      result.push_back(expression.variableName);
+    },
+    [](const auto& visitor, const ArrayExpression& expression) {
+      for (const auto& element : expression.elements)
+      {
+        element.accept(visitor);
+      }
+    },
+    [](const auto& visitor, const MapExpression& expression) {
+      for (const auto& [key, element] : expression.elements)
+      {
+        element.accept(visitor);
+      }
+    },
+    [](const auto& visitor, const UnaryExpression& expression) {
+      expression.operand.accept(visitor);
+    },
+    [](const auto& visitor, const BinaryExpression& expression) {
+      expression.leftOperand.accept(visitor);
+      expression.rightOperand.accept(visitor);
+    },
+    [](const auto& visitor, const SubscriptExpression& expression) {
+      expression.leftOperand.accept(visitor);
+      expression.rightOperand.accept(visitor);
+    },
+    [](const auto& visitor, const SwitchExpression& expression) {
+      for (const auto& case_ : expression.cases)
+      {
+        case_.accept(visitor);
+      }
+    }));
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
 const std::optional<FileLocation>& ExpressionNode::location() const
 {
   return m_location;
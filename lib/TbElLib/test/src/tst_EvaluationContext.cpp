@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/ELParser.h"
+#include "el/EvaluationContext.h"
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include "kd/result.h"
+
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::el
+{
+namespace
+{
+
+const auto ModelExpression = R"({{
+  spawnflags == 1 -> "models/a.mdl",
+  spawnflags == 2 -> { path: "models/b.mdl", skin: skin, frame: frame },
+  { path: "models/c.mdl", skin: skin, scale: scale * 2 }
+}})";
+
+VariableTable makeVariables(const std::string& spawnflags)
+{
+  return VariableTable{{
+    {"spawnflags", Value{spawnflags}},
+    {"skin", Value{"2"}},
+    {"frame", Value{"1"}},
+    {"scale", Value{1.5}},
+  }};
+}
+
+} // namespace
+
+TEST_CASE("EvaluationContext")
+{
+  SECTION("withUntracedEvaluationContext")
+  {
+    const auto expression = ELParser::parseStrict(ModelExpression).value();
+    const auto evaluate = [&](auto& context) { return expression.evaluate(context); };
+
+    SECTION("returns the same value as withEvaluationContext")
+    {
+      const auto spawnflags = GENERATE(as<std::string>{}, "1", "2", "4");
+      CAPTURE(spawnflags);
+
+      const auto variables = makeVariables(spawnflags);
+      CHECK(
+        withUntracedEvaluationContext(evaluate, variables)
+        == withEvaluationContext(evaluate, variables));
+    }
+
+    SECTION("returns the same error as withEvaluationContext")
+    {
+      // the error location of the subscript key is only known from the trace
+      const auto failingExpression = ELParser::parseStrict("{a: 1}[[1]]").value();
+      const auto evaluateFailing = [&](auto& context) {
+        return failingExpression.evaluate(context);
+      };
+
+      const auto tracedResult = withEvaluationContext(evaluateFailing);
+      REQUIRE(tracedResult.is_error());
+      CHECK(withUntracedEvaluationContext(evaluateFailing) == tracedResult);
+    }
+  }
+}
+
+TEST_CASE("EvaluationContext (Benchmark)", "[.][benchmark]")
+{
+  const auto expression = ELParser::parseStrict(ModelExpression).value();
+  const auto evaluate = [&](auto& context) { return expression.evaluate(context); };
+  const auto variables = makeVariables("4");
+
+  BENCHMARK("Evaluate with tracing")
+  {
+    return withEvaluationContext(evaluate, variables);
+  };
+
+  BENCHMARK("Evaluate without tracing")
+  {
+    return withUntracedEvaluationContext(evaluate, variables);
+  };
+}
+
+} // namespace tb::el
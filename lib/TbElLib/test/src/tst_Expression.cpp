@@ -1207,6 +1207,31 @@ TEST_CASE("Expression")
       preorderVisit("{{ x -> 1 }}")
       == std::vector<std::string>{"{{ x -> 1 }}", "x -> 1", "x", "1"});
   }
+
+  SECTION("variableNames")
+  {
+    using namespace std::string_literals;
+
+    CHECK(ELParser::parseStrict("1").value().variableNames().empty());
+    CHECK(
+      ELParser::parseStrict("a").value().variableNames()
+      == std::vector<std::string>{"a"});
+    CHECK(
+      ELParser::parseStrict("[b, 1, a]").value().variableNames()
+      == std::vector{"a"s, "b"s});
+    CHECK(
+      ELParser::parseStrict("{x: a, y: -b}").value().variableNames()
+      == std::vector{"a"s, "b"s});
+    CHECK(
+      ELParser::parseStrict("a + b * a").value().variableNames()
+      == std::vector{"a"s, "b"s});
+    CHECK(
+      ELParser::parseStrict("x[i..j]").value().variableNames()
+      == std::vector{"i"s, "j"s, "x"s});
+    CHECK(
+      ELParser::parseStrict("{{ s == 1 -> m, n }}").value().variableNames()
+      == std::vector{"m"s, "n"s, "s"s});
+  }
 }
 
 } // namespace tb::el
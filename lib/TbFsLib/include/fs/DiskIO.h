@@ -43,6 +43,13 @@ bool isCaseSensitive();
 
 std::filesystem::path fixPath(const std::filesystem::path& path);
 
+/**
+ * Clears the directory listings that fixPath caches to find the correct case of paths on
+ * case sensitive file systems. A cached listing is also reloaded automatically when the
+ * modification time of its directory changes or when an entry is not found in it.
+ */
+void clearDirectoryCache();
+
 PathInfo pathInfo(const std::filesystem::path& path);
 
 Result<std::vector<std::filesystem::path>> find(
@@ -50,7 +57,8 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, FileMapping mapping = FileMapping::Unmapped);
 
 template <typename Stream, typename F>
 auto withStream(
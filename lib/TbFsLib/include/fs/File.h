@@ -76,9 +76,30 @@ public:
   size_t size() const override;
 };
 
+/**
+ * Determines whether the contents of a CFile are mapped into memory.
+ */
+enum class FileMapping
+{
+  Unmapped,
+  Mapped,
+};
+
 /**
  * A file that is backed by a physical file on the disk. The file is opened in the
  * constructor and closed in the destructor.
+ *
+ * If requested and possible, the contents of the file are mapped into memory. Readers of
+ * a mapped file access the mapped memory directly and share ownership of the mapping, so
+ * any number of readers can read from the file concurrently and without copying. Other
+ * files are read using positional reads which do not depend on the seek position of the
+ * underlying C file.
+ *
+ * Mapping is only meant for image archives such as pak and zip files, which are not
+ * expected to change while they are mounted. The mapping lives as long as any reader or
+ * buffer into it. During that time, truncating the file from outside crashes the
+ * application with SIGBUS on POSIX systems, and the file cannot be deleted or replaced
+ * on Windows.
  */
 class CFile : public File
 {
@@ -93,15 +114,18 @@ public:
 private:
   kdl::resource<std::FILE*> m_file;
   size_t m_size;
+  BufferType m_mapping;
   mutable std::mutex m_mutex;
 
   /**
-   * Creates a new file with the given file ptr and size in bytes.
+   * Creates a new file with the given file ptr, size in bytes and memory mapping. The
+   * mapping may be null.
    */
-  CFile(kdl::resource<std::FILE*> file, size_t size);
+  CFile(kdl::resource<std::FILE*> file, size_t size, BufferType mapping);
 
 public:
-  friend Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+  friend Result<std::shared_ptr<CFile>> createCFile(
+    const std::filesystem::path& path, FileMapping mapping);
 
   Reader reader() const override;
   size_t size() const override;
@@ -111,6 +135,12 @@ public:
    */
   std::FILE* file() const;
 
+  /**
+   * Returns the memory region that the contents of this file are mapped to, or null if
+   * this file is not mapped into memory.
+   */
+  const BufferType& mapping() const;
+
   std::unique_ptr<OwningBufferFile> buffer() const;
 
 private:
@@ -122,7 +152,8 @@ private:
   Error makeError(const std::string& msg) const;
 };
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, FileMapping mapping = FileMapping::Unmapped);
 
 /**
  * A file that is backed by a portion of a physical file.
@@ -22,8 +22,11 @@
 #include "Result.h"
 #include "fs/FileSystem.h"
 
+#include "kd/path_hash.h"
+
 #include <filesystem>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::fs
@@ -48,6 +51,7 @@ struct VirtualMountPoint
   VirtualMountPointId id;
   std::filesystem::path path;
   std::unique_ptr<FileSystem> mountedFileSystem;
+  bool indexed = false;
 };
 
 class VirtualFileSystem : public FileSystem
@@ -55,6 +59,14 @@ class VirtualFileSystem : public FileSystem
 private:
   std::vector<VirtualMountPoint> m_mountPoints;
 
+  /**
+   * Maps the lower case paths of all entries of the indexed mount points to the mounted
+   * file system that takes precedence for them. Only image file systems are indexed
+   * because their contents don't change while they are mounted. The other mounted file
+   * systems are still queried in turn.
+   */
+  std::unordered_map<std::filesystem::path, const FileSystem*, kdl::path_hash> m_index;
+
 public:
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
@@ -67,6 +79,12 @@ public:
   bool unmount(const VirtualMountPointId& id);
   void unmountAll();
 
+private:
+  const VirtualMountPoint* findMountPoint(const std::filesystem::path& path) const;
+
+  void addToIndex(VirtualMountPoint& mountPoint);
+  void removeFromIndex(const VirtualMountPoint& mountPoint);
+
 protected:
   Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
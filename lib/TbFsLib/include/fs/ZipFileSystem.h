@@ -34,6 +34,9 @@ class ZipFileSystem : public ImageFileSystem<CFile>
 {
 private:
   mz_zip_archive m_archive;
+
+  // guards the archive reader, which is only used to extract entries if the archive is
+  // not mapped into memory
   std::mutex m_mutex;
 
 public:
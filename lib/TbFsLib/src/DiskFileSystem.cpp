@@ -91,7 +91,8 @@ Result<std::vector<std::filesystem::path>> DiskFileSystem::doFind(
 Result<std::shared_ptr<File>> DiskFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  return makeAbsolute(path) | kdl::and_then(Disk::openFile)
+  return makeAbsolute(path)
+         | kdl::and_then([](const auto& absPath) { return Disk::openFile(absPath); })
          | kdl::transform(
            [](auto cFile) { return std::static_pointer_cast<File>(cFile); });
 }
@@ -25,6 +25,7 @@
 #include "fs/TraversalMode.h"
 
 #include "kd/contracts.h"
+#include "kd/path_hash.h"
 #include "kd/path_utils.h"
 #include "kd/string_format.h"
 #include "kd/string_utils.h"
@@ -32,6 +33,14 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
 namespace tb::fs::Disk
 {
 namespace
@@ -46,6 +55,134 @@ bool doCheckCaseSensitive()
          || !std::filesystem::exists(kdl::str_to_upper(cwd.string()));
 }
 
+/**
+ * Caches the entries of the directories visited by fixCase by their lower case names. A
+ * cached listing is reloaded when the modification time of its directory changes.
+ *
+ * The modification time may be too coarse to reflect changes that happen shortly after
+ * the directory was listed. Such a listing is racy, and it is reloaded when it doesn't
+ * contain an entry that is looked up. A listing that was taken long enough after the
+ * last modification of its directory answers such lookups from the cache. At most
+ * MaxListings directories are cached. The cache can be used from multiple threads.
+ */
+class DirectoryListingCache
+{
+private:
+  struct Listing
+  {
+    std::filesystem::file_time_type modificationTime;
+    bool racy;
+    std::unordered_map<std::filesystem::path, std::filesystem::path, kdl::path_hash>
+      namesByLowerCaseName;
+  };
+
+  static constexpr size_t MaxListings = 4096;
+
+  /** Larger than the modification time resolution of common file systems. */
+  static constexpr auto RacyInterval = std::chrono::seconds{2};
+
+  std::shared_mutex m_mutex;
+  std::unordered_map<
+    std::filesystem::path,
+    std::shared_ptr<const Listing>,
+    kdl::path_hash>
+    m_listings;
+
+public:
+  /**
+   * Returns the name of the entry of the given directory whose lower case name is equal
+   * to the given name, or nullopt if no such entry exists.
+   */
+  std::optional<std::filesystem::path> findEntry(
+    const std::filesystem::path& directoryPath,
+    const std::filesystem::path& lowerCaseName)
+  {
+    auto [listing, cached] = getListing(directoryPath, false);
+    if (auto name = findEntry(listing.get(), lowerCaseName);
+        name || !cached || !listing->racy)
+    {
+      return name;
+    }
+
+    listing = getListing(directoryPath, true).first;
+    return findEntry(listing.get(), lowerCaseName);
+  }
+
+  void clear()
+  {
+    auto lock = std::unique_lock{m_mutex};
+    m_listings.clear();
+  }
+
+private:
+  static std::optional<std::filesystem::path> findEntry(
+    const Listing* listing, const std::filesystem::path& lowerCaseName)
+  {
+    if (listing)
+    {
+      if (const auto it = listing->namesByLowerCaseName.find(lowerCaseName);
+          it != listing->namesByLowerCaseName.end())
+      {
+        return it->second;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * Returns the listing of the given directory and whether it was taken from the cache.
+   * If reload is true, the directory is listed again even if its listing is up to date.
+   */
+  std::pair<std::shared_ptr<const Listing>, bool> getListing(
+    const std::filesystem::path& directoryPath, const bool reload)
+  {
+    auto error = std::error_code{};
+    const auto modificationTime = std::filesystem::last_write_time(directoryPath, error);
+    if (error)
+    {
+      return {nullptr, false};
+    }
+
+    if (!reload)
+    {
+      auto lock = std::shared_lock{m_mutex};
+      if (const auto it = m_listings.find(directoryPath);
+          it != m_listings.end() && it->second->modificationTime == modificationTime)
+      {
+        return {it->second, true};
+      }
+    }
+
+    const auto racy =
+      std::filesystem::file_time_type::clock::now() - modificationTime < RacyInterval;
+    auto listing = std::make_shared<Listing>(Listing{modificationTime, racy, {}});
+    for (const auto& entry : std::filesystem::directory_iterator{directoryPath, error})
+    {
+      const auto name = entry.path().filename();
+      listing->namesByLowerCaseName.try_emplace(kdl::path_to_lower(name), name);
+    }
+
+    if (error)
+    {
+      return {nullptr, false};
+    }
+
+    auto lock = std::unique_lock{m_mutex};
+    if (m_listings.size() >= MaxListings && !m_listings.contains(directoryPath))
+    {
+      m_listings.erase(m_listings.begin());
+    }
+    m_listings[directoryPath] = listing;
+    return {listing, false};
+  }
+};
+
+DirectoryListingCache& directoryListingCache()
+{
+  static auto cache = DirectoryListingCache{};
+  return cache;
+}
+
 std::filesystem::path fixCase(const std::filesystem::path& path)
 {
   try
@@ -57,28 +194,24 @@ std::filesystem::path fixCase(const std::filesystem::path& path)
       return path;
     }
 
-    auto result = kdl::path_front(kdl::path_to_lower(path));
-    auto remainder = kdl::path_pop_front(kdl::path_to_lower(path));
+    const auto lowerCasePath = kdl::path_to_lower(path);
+
+    auto it = lowerCasePath.begin();
+    auto result = *it++;
 
-    while (!remainder.empty())
+    for (; it != lowerCasePath.end(); ++it)
     {
-      const auto nameToFind = kdl::path_front(remainder);
-      const auto entryIt = std::find_if(
-        std::filesystem::directory_iterator{result},
-        std::filesystem::directory_iterator{},
-        [&](const auto& entry) {
-          return nameToFind == kdl::path_to_lower(entry.path().filename());
-        });
-
-      if (entryIt == std::filesystem::directory_iterator{})
+      const auto name = directoryListingCache().findEntry(result, *it);
+      if (!name)
       {
         return path;
       }
 
-      result = result / entryIt->path().filename();
-      remainder = kdl::path_pop_front(remainder);
+      result = result / *name;
     }
-    return result;
+
+    // a stale listing may contain an entry that was removed
+    return std::filesystem::exists(result) ? result : path;
   }
   catch (const std::filesystem::filesystem_error&)
   {
@@ -109,6 +242,11 @@ std::filesystem::path fixPath(const std::filesystem::path& path)
   return fixCase(path.lexically_normal());
 }
 
+void clearDirectoryCache()
+{
+  directoryListingCache().clear();
+}
+
 PathInfo pathInfo(const std::filesystem::path& path)
 {
   return pathInfoForFixedPath(fixPath(path));
@@ -159,7 +297,8 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, const FileMapping mapping)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
@@ -167,7 +306,7 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
     return Error{fmt::format("Failed to open {}: path does not denote a file", path)};
   }
 
-  return createCFile(fixedPath);
+  return createCFile(fixedPath, mapping);
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
@@ -24,9 +24,18 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace tb::fs
 {
 
@@ -102,11 +111,55 @@ Result<size_t> fileSize(std::FILE* file)
 
   return static_cast<size_t>(size);
 }
+
+/**
+ * Maps the contents of the given file into memory. Returns null if the file is empty or
+ * cannot be mapped.
+ */
+CFile::BufferType mapFile(std::FILE* file, const size_t size)
+{
+  if (size == 0)
+  {
+    return nullptr;
+  }
+
+#ifdef _WIN32
+  auto* fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+  auto* mappingHandle =
+    CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mappingHandle)
+  {
+    return nullptr;
+  }
+
+  // the view keeps the mapping object alive
+  auto* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, size);
+  CloseHandle(mappingHandle);
+  if (!data)
+  {
+    return nullptr;
+  }
+
+  return CFile::BufferType{
+    static_cast<char*>(data), [](char* ptr) { UnmapViewOfFile(ptr); }};
+#else
+  auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  if (data == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  return CFile::BufferType{
+    static_cast<char*>(data), [size](char* ptr) { munmap(ptr, size); }};
+#endif
+}
+
 } // namespace
 
-CFile::CFile(kdl::resource<std::FILE*> file, const size_t size)
+CFile::CFile(kdl::resource<std::FILE*> file, const size_t size, BufferType mapping)
   : m_file{std::move(file)}
   , m_size{size}
+  , m_mapping{std::move(mapping)}
 {
 }
 
@@ -125,15 +178,15 @@ std::FILE* CFile::file() const
   return *m_file;
 }
 
-std::unique_ptr<OwningBufferFile> CFile::buffer() const
+const CFile::BufferType& CFile::mapping() const
 {
-  if (std::fseek(file(), 0, SEEK_SET))
-  {
-    return nullptr;
-  }
+  return m_mapping;
+}
 
+std::unique_ptr<OwningBufferFile> CFile::buffer() const
+{
   auto buffer = std::make_unique<char[]>(size());
-  if (std::fread(buffer.get(), 1, size(), file()) != size())
+  if (!read(buffer.get(), 0, size()))
   {
     return nullptr;
   }
@@ -143,6 +196,18 @@ std::unique_ptr<OwningBufferFile> CFile::buffer() const
 
 Result<void> CFile::read(char* val, const size_t position, const size_t size) const
 {
+  if (position + size > m_size)
+  {
+    return makeError("read past EOF");
+  }
+
+  if (m_mapping)
+  {
+    std::memcpy(val, m_mapping.get() + position, size);
+    return kdl::void_success;
+  }
+
+#ifdef _WIN32
   auto guard = std::lock_guard{m_mutex};
 
   const auto currentPosition = std::ftell(m_file.get());
@@ -157,20 +222,47 @@ Result<void> CFile::read(char* val, const size_t position, const size_t size) co
       return makeError("fseek failed");
     }
   }
-  if (position + size > m_size)
-  {
-    return makeError("read past EOF");
-  }
   if (std::fread(val, 1, size, *m_file) != size)
   {
     return makeError("fread failed");
   }
+#else
+  const auto fd = fileno(*m_file);
+  for (size_t offset = 0; offset < size;)
+  {
+    const auto count = pread(fd, val + offset, size - offset, off_t(position + offset));
+    if (count == 0)
+    {
+      return Error{"pread failed: unexpected end of file"};
+    }
+    if (count < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return makeError("pread failed");
+    }
+    offset += size_t(count);
+  }
+#endif
 
   return kdl::void_success;
 }
 
 Result<CFile::BufferType> CFile::buffer(const size_t position, const size_t size) const
 {
+  if (m_mapping)
+  {
+    if (position + size > m_size)
+    {
+      return makeError("read past EOF");
+    }
+
+    // share ownership of the mapping instead of copying
+    return BufferType{m_mapping, m_mapping.get() + position};
+  }
+
 #if defined __APPLE__
   // AppleClang doesn't support std::shared_ptr<T[]> (new as of C++17)
   auto buffer = BufferType{new char[size], std::default_delete<char[]>{}};
@@ -189,12 +281,17 @@ Error CFile::makeError(const std::string& msg) const
                             : Error{fmt::format("{}: {}", msg, std::strerror(errno))};
 }
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, const FileMapping mapping)
 {
-  return openPathAsFILE(path, "rb") | kdl::and_then([](auto file) {
+  return openPathAsFILE(path, "rb") | kdl::and_then([&](auto file) {
            return fileSize(*file) | kdl::transform([&](auto size) {
+                    auto buffer = mapping == FileMapping::Mapped
+                                    ? mapFile(*file, size)
+                                    : CFile::BufferType{};
                     // NOLINTNEXTLINE
-                    return std::shared_ptr<CFile>{new CFile{std::move(file), size}};
+                    return std::shared_ptr<CFile>{
+                      new CFile{std::move(file), size, std::move(buffer)}};
                   });
          });
 }
@@ -149,6 +149,10 @@ public:
   }
 };
 
+/**
+ * A reader source that reads from a memory region and shares ownership of the memory
+ * region with its sub sources and buffers.
+ */
 class OwningBufferReaderSource : public BufferReaderSource
 {
 private:
@@ -161,6 +165,13 @@ public:
   {
   }
 
+  std::shared_ptr<ReaderSource> subSource(
+    const size_t offset, const size_t length) const override
+  {
+    return std::make_shared<OwningBufferReaderSource>(
+      m_buffer, begin() + offset, begin() + offset + length);
+  }
+
   std::shared_ptr<BufferReaderSource> buffer() const override
   {
     return std::make_shared<OwningBufferReaderSource>(m_buffer, begin(), end());
@@ -168,9 +179,8 @@ public:
 };
 
 /**
- * A reader source that reads directly from a file. Note that the seek position of the
- * underlying C file is kept in sync with this file source's position automatically,
- * that is, two readers can read from the same underlying file without causing problems.
+ * A reader source that reads directly from a file that is not mapped into memory. Two
+ * readers can read from the same underlying file without causing problems.
  */
 class FileReaderSource : public ReaderSource
 {
@@ -235,6 +245,11 @@ Reader::~Reader() = default;
 
 Reader Reader::from(const CFile& file, const size_t size)
 {
+  if (const auto& mapping = file.mapping())
+  {
+    return Reader{std::make_shared<OwningBufferReaderSource>(
+      mapping, mapping.get(), mapping.get() + size)};
+  }
   return Reader{std::make_shared<FileReaderSource>(file, 0, size)};
 }
 
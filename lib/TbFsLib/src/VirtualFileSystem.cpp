@@ -20,6 +20,7 @@
 #include "fs/VirtualFileSystem.h"
 
 #include "fs/File.h"
+#include "fs/ImageFileSystem.h"
 #include "fs/PathInfo.h"
 #include "fs/TraversalMode.h"
 
@@ -65,6 +66,20 @@ std::filesystem::path suffix(
   return kdl::path_clip(path, kdl::path_length(mountPoint.path));
 }
 
+bool resolves(const VirtualMountPoint& mountPoint, const std::filesystem::path& path)
+{
+  return matches(mountPoint, path)
+         && mountPoint.mountedFileSystem->pathInfo(suffix(mountPoint, path))
+              != PathInfo::Unknown;
+}
+
+std::filesystem::path makeIndexKey(const std::filesystem::path& path)
+{
+  // image file systems ignore a trailing separator
+  auto key = kdl::path_to_lower(path);
+  return key.has_filename() || !key.has_relative_path() ? key : key.parent_path();
+}
+
 } // namespace
 
 VirtualMountPointId::VirtualMountPointId()
@@ -85,16 +100,22 @@ bool operator!=(const VirtualMountPointId& lhs, const VirtualMountPointId& rhs)
 Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
   const std::filesystem::path& path) const
 {
+  const auto* mountPoint = findMountPoint(path);
+  if (mountPoint)
+  {
+    if (auto absPath =
+          mountPoint->mountedFileSystem->makeAbsolute(suffix(*mountPoint, path)))
+    {
+      return absPath;
+    }
+  }
+
+  // fall through to the other mount points that resolve the path, bypassing the index
   for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
+    if (&*it != mountPoint && resolves(*it, path))
     {
-      const auto pathSuffix = suffix(mountPoint, path);
-      const auto absPath = mountPoint.mountedFileSystem->makeAbsolute(pathSuffix);
-      if (
-        absPath
-        && mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
+      if (auto absPath = it->mountedFileSystem->makeAbsolute(suffix(*it, path)))
       {
         return absPath;
       }
@@ -106,18 +127,9 @@ Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
 
 PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto* mountPoint = findMountPoint(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return pathInfo;
-      }
-    }
+    return mountPoint->mountedFileSystem->pathInfo(suffix(*mountPoint, path));
   }
 
   return std::ranges::any_of(
@@ -133,18 +145,9 @@ PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 const FileSystemMetadata* VirtualFileSystem::metadata(
   const std::filesystem::path& path, const std::string& key) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto* mountPoint = findMountPoint(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return mountPoint.mountedFileSystem->metadata(pathSuffix, key);
-      }
-    }
+    return mountPoint->mountedFileSystem->metadata(suffix(*mountPoint, path), key);
   }
 
   return nullptr;
@@ -155,6 +158,7 @@ VirtualMountPointId VirtualFileSystem::mount(
 {
   const auto id = VirtualMountPointId{};
   m_mountPoints.push_back({id, path, std::move(fs)});
+  addToIndex(m_mountPoints.back());
   return id;
 }
 
@@ -164,7 +168,9 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
         m_mountPoints, [&](const auto& mountPoint) { return mountPoint.id == id; });
       it != m_mountPoints.end())
   {
+    auto mountPoint = std::move(*it);
     m_mountPoints.erase(it);
+    removeFromIndex(mountPoint);
     return true;
   }
   return false;
@@ -173,6 +179,83 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
 void VirtualFileSystem::unmountAll()
 {
   m_mountPoints.clear();
+  m_index.clear();
+}
+
+const VirtualMountPoint* VirtualFileSystem::findMountPoint(
+  const std::filesystem::path& path) const
+{
+  const auto indexIt = m_index.find(makeIndexKey(path));
+  const auto* indexedFileSystem = indexIt != m_index.end() ? indexIt->second : nullptr;
+
+  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  {
+    const auto& mountPoint = *it;
+    if (
+      mountPoint.indexed ? mountPoint.mountedFileSystem.get() == indexedFileSystem
+                         : resolves(mountPoint, path))
+    {
+      return &mountPoint;
+    }
+  }
+
+  return nullptr;
+}
+
+void VirtualFileSystem::addToIndex(VirtualMountPoint& mountPoint)
+{
+  if (!dynamic_cast<const ImageFileSystemBase*>(mountPoint.mountedFileSystem.get()))
+  {
+    return;
+  }
+
+  // if the file system cannot be listed, it remains unindexed and is queried in turn
+  mountPoint.indexed =
+    mountPoint.mountedFileSystem->find({}, TraversalMode::Recursive)
+    | kdl::transform([&](const auto& paths) {
+        // the new mount point takes precedence over all other mount points
+        const auto* fileSystem = mountPoint.mountedFileSystem.get();
+        m_index[makeIndexKey(mountPoint.path)] = fileSystem;
+        for (const auto& p : paths)
+        {
+          m_index[makeIndexKey(mountPoint.path / p)] = fileSystem;
+        }
+      })
+    | kdl::is_success();
+}
+
+void VirtualFileSystem::removeFromIndex(const VirtualMountPoint& mountPoint)
+{
+  if (!mountPoint.indexed)
+  {
+    return;
+  }
+
+  const auto* fileSystem = mountPoint.mountedFileSystem.get();
+  for (auto it = m_index.begin(); it != m_index.end();)
+  {
+    if (it->second != fileSystem)
+    {
+      ++it;
+      continue;
+    }
+
+    // find the remaining indexed mount point that now takes precedence
+    const auto next = std::ranges::find_if(
+      m_mountPoints | std::views::reverse, [&](const auto& other) {
+        return other.indexed && resolves(other, it->first);
+      });
+
+    if (next != std::ranges::end(m_mountPoints | std::views::reverse))
+    {
+      it->second = next->mountedFileSystem.get();
+      ++it;
+    }
+    else
+    {
+      it = m_index.erase(it);
+    }
+  }
 }
 
 namespace
@@ -302,17 +385,9 @@ Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
 Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto* mountPoint = findMountPoint(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
-      {
-        return mountPoint.mountedFileSystem->openFile(pathSuffix);
-      }
-    }
+    return mountPoint->mountedFileSystem->openFile(suffix(*mountPoint, path));
   }
 
   return Error{fmt::format("{} not found", path)};
@@ -26,7 +26,9 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace tb::fs
@@ -56,6 +58,129 @@ std::string filename(mz_zip_archive& archive, const mz_uint fileIndex)
 
   return result;
 }
+
+/**
+ * The location and size of a file in a zip archive that can be extracted without using
+ * the archive reader.
+ */
+struct EntryLocation
+{
+  mz_uint64 localHeaderOffset;
+  mz_uint64 compressedSize;
+  mz_uint64 uncompressedSize;
+  mz_uint32 crc32;
+  mz_uint16 method;
+};
+
+std::optional<EntryLocation> getEntryLocation(
+  mz_zip_archive& archive, const mz_uint fileIndex)
+{
+  auto stat = mz_zip_archive_file_stat{};
+  if (
+    !mz_zip_reader_file_stat(&archive, fileIndex, &stat) || !stat.m_is_supported
+    || stat.m_is_encrypted || (stat.m_method != 0 && stat.m_method != MZ_DEFLATED))
+  {
+    return std::nullopt;
+  }
+
+  return EntryLocation{
+    stat.m_local_header_ofs,
+    stat.m_comp_size,
+    stat.m_uncomp_size,
+    stat.m_crc32,
+    stat.m_method,
+  };
+}
+
+size_t readUInt16(const char* data)
+{
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  return size_t(bytes[0]) | size_t(bytes[1]) << 8;
+}
+
+/**
+ * Returns the offset of the given entry's data in the archive. The data follows the
+ * entry's local header, whose variable size is not stored in the central directory.
+ */
+std::optional<size_t> findEntryData(
+  const char* archive, const size_t archiveSize, const EntryLocation& location)
+{
+  static constexpr auto LocalHeaderSignature = "PK\3\4";
+  static constexpr auto LocalHeaderSize = size_t(30);
+  static constexpr auto FilenameLengthOffset = size_t(26);
+  static constexpr auto ExtraFieldLengthOffset = size_t(28);
+
+  const auto headerOffset = size_t(location.localHeaderOffset);
+  if (
+    headerOffset > archiveSize || archiveSize - headerOffset < LocalHeaderSize
+    || std::memcmp(archive + headerOffset, LocalHeaderSignature, 4) != 0)
+  {
+    return std::nullopt;
+  }
+
+  const auto* header = archive + headerOffset;
+  const auto dataOffset = headerOffset + LocalHeaderSize
+                          + readUInt16(header + FilenameLengthOffset)
+                          + readUInt16(header + ExtraFieldLengthOffset);
+  if (dataOffset > archiveSize || archiveSize - dataOffset < location.compressedSize)
+  {
+    return std::nullopt;
+  }
+
+  return dataOffset;
+}
+
+/**
+ * Extracts the given entry from an archive that is mapped into memory. This does not
+ * modify any shared state, so entries can be extracted concurrently.
+ */
+Result<std::shared_ptr<File>> extractEntry(
+  const char* archive,
+  const size_t archiveSize,
+  const EntryLocation& location,
+  const std::filesystem::path& path)
+{
+  const auto dataOffset = findEntryData(archive, archiveSize, location);
+  if (!dataOffset)
+  {
+    return Error{fmt::format("Invalid local file header for {}", path)};
+  }
+
+  const auto* compressedData = archive + *dataOffset;
+  const auto compressedSize = static_cast<size_t>(location.compressedSize);
+  const auto uncompressedSize = static_cast<size_t>(location.uncompressedSize);
+  auto data = std::make_unique<char[]>(uncompressedSize);
+
+  if (location.method == MZ_DEFLATED)
+  {
+    if (
+      tinfl_decompress_mem_to_mem(
+        data.get(), uncompressedSize, compressedData, compressedSize, 0)
+      != uncompressedSize)
+    {
+      return Error{fmt::format("tinfl_decompress_mem_to_mem failed for {}", path)};
+    }
+  }
+  else
+  {
+    if (compressedSize != uncompressedSize)
+    {
+      return Error{fmt::format("Invalid size of stored file {}", path)};
+    }
+    std::memcpy(data.get(), compressedData, uncompressedSize);
+  }
+
+  const auto crc32 = mz_crc32(
+    MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(data.get()), uncompressedSize);
+  if (crc32 != location.crc32)
+  {
+    return Error{fmt::format("CRC check failed for {}", path)};
+  }
+
+  return std::static_pointer_cast<File>(
+    std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+}
+
 } // namespace
 
 ZipFileSystem::~ZipFileSystem()
@@ -78,27 +203,41 @@ Result<void> ZipFileSystem::doReadDirectory()
     if (!mz_zip_reader_is_file_a_directory(&m_archive, i))
     {
       const auto path = std::filesystem::path{filename(m_archive, i)};
-      addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
-        auto loadFileGoard = std::lock_guard{m_mutex};
-
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
-      });
+
+      // Entries of a mapped archive are extracted without using the archive reader,
+      // which cannot be used concurrently.
+      if (const auto location =
+            m_file->mapping() ? getEntryLocation(m_archive, i) : std::nullopt)
+      {
+        addFile(path, [&, location = *location, path]() {
+          return extractEntry(m_file->mapping().get(), m_file->size(), location, path);
+        });
+      }
+      else
+      {
+        addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
+          auto loadFileGoard = std::lock_guard{m_mutex};
+
+          auto stat = mz_zip_archive_file_stat{};
+          if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
+          {
+            return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
+          }
+
+          const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+          auto data = std::make_unique<char[]>(uncompressedSize);
+          auto* begin = data.get();
+
+          if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
+          {
+            return Error{
+              fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
+          }
+
+          return std::static_pointer_cast<File>(
+            std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+        });
+      }
     }
   }
 
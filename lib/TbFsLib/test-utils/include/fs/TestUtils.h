@@ -31,7 +31,7 @@ namespace tb::fs
 template <typename FS>
 auto openFS(const std::filesystem::path& path)
 {
-  return Disk::openFile(path) | kdl::and_then([](auto file) {
+  return Disk::openFile(path, FileMapping::Mapped) | kdl::and_then([](auto file) {
            return createImageFileSystem<FS>(std::move(file));
          })
          | kdl::transform([&](auto fs) {
@@ -23,12 +23,19 @@
 #include "fs/TestEnvironment.h"
 #include "fs/TraversalMode.h"
 
+#include "kd/result.h"
+
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <cctype>
 #include <filesystem>
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
@@ -94,7 +101,7 @@ const auto readAll = [](auto& stream) {
 
 TEST_CASE("DiskIO")
 {
-  const auto env = makeTestEnvironment();
+  auto env = makeTestEnvironment();
 
   SECTION("fixPath")
   {
@@ -107,6 +114,52 @@ TEST_CASE("DiskIO")
       CHECK(
         fs::Disk::fixPath(env.dir() / "anotHERDIR/./SUBdirTEST/../SubdirTesT/TesT2.MAP")
         == env.dir() / "anotherDir/subDirTest/test2.map");
+
+      SECTION("Cached directories are reloaded when they change")
+      {
+        REQUIRE(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "ANOTHERDIR/NEWFILE.TXT");
+
+        env.createFile("anotherDir/newFile.txt", "some content");
+        CHECK(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "anotherDir/newFile.txt");
+
+        std::filesystem::remove(env.dir() / "anotherDir/newFile.txt");
+        CHECK(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "ANOTHERDIR/NEWFILE.TXT");
+      }
+
+      SECTION("Cached directories are reloaded if an entry is not found")
+      {
+        // simulate a file system whose modification times are too coarse to change
+        const auto directoryPath = env.dir() / "anotherDir";
+        const auto modificationTime = std::filesystem::last_write_time(directoryPath);
+
+        REQUIRE(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "ANOTHERDIR/NEWFILE.TXT");
+
+        env.createFile("anotherDir/newFile.txt", "some content");
+        std::filesystem::last_write_time(directoryPath, modificationTime);
+        CHECK(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "anotherDir/newFile.txt");
+
+        std::filesystem::remove(env.dir() / "anotherDir/newFile.txt");
+        std::filesystem::last_write_time(directoryPath, modificationTime);
+        CHECK(
+          fs::Disk::fixPath(env.dir() / "ANOTHERDIR/NEWFILE.TXT")
+          == env.dir() / "ANOTHERDIR/NEWFILE.TXT");
+      }
+
+      SECTION("Clearing the cache")
+      {
+        fs::Disk::clearDirectoryCache();
+        CHECK(fs::Disk::fixPath(env.dir() / "TEST.txt") == env.dir() / "test.txt");
+      }
     }
   }
 
@@ -226,6 +279,17 @@ TEST_CASE("DiskIO")
     CHECK(fs::Disk::openFile(env.dir() / "anotherDir/subDirTest/test2.map"));
     CHECK(fs::Disk::openFile(env.dir() / "linkedDir/test2.map"));
     CHECK(fs::Disk::openFile(env.dir() / "linkedTest2.map"));
+
+    SECTION("Files are only mapped into memory on request")
+    {
+      const auto file = fs::Disk::openFile(env.dir() / "test.txt") | kdl::value();
+      CHECK(file->mapping() == nullptr);
+
+      const auto mappedFile =
+        fs::Disk::openFile(env.dir() / "test.txt", FileMapping::Mapped) | kdl::value();
+      CHECK(mappedFile->mapping() != nullptr);
+      CHECK(mappedFile->reader().readString(mappedFile->size()) == "some content");
+    }
   }
 
   SECTION("withStream")
@@ -690,4 +754,74 @@ TEST_CASE("DiskIO")
   }
 }
 
+TEST_CASE("DiskIO (Benchmark)", "[.][benchmark]")
+{
+  auto env = TestEnvironment{[](TestEnvironment& e) {
+    for (size_t i = 0; i < 10; ++i)
+    {
+      for (size_t j = 0; j < 10; ++j)
+      {
+        const auto dir = fmt::format("Textures{}/Set{}", i, j);
+        e.createDirectory(dir);
+        for (size_t k = 0; k < 50; ++k)
+        {
+          e.createFile(fmt::format("{}/Material{}.png", dir, k), "");
+        }
+      }
+    }
+  }};
+
+  auto rng = std::mt19937{42};
+  auto index = std::uniform_int_distribution<size_t>{0, 49};
+  auto flip = std::bernoulli_distribution{0.5};
+
+  auto paths = std::vector<std::filesystem::path>{};
+  paths.reserve(100000);
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    auto path = fmt::format(
+      "textures{}/set{}/material{}.png", index(rng) % 10, index(rng) % 10, index(rng));
+    for (auto& c : path)
+    {
+      if (flip(rng))
+      {
+        c = char(std::toupper(static_cast<unsigned char>(c)));
+      }
+    }
+    paths.push_back(env.dir() / path);
+  }
+
+  // most lookups of a search path miss, either in an existing or in a missing directory
+  auto missingPaths = std::vector<std::filesystem::path>{};
+  missingPaths.reserve(100000);
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    const auto format =
+      flip(rng) ? "textures{}/set{}/missing{}.png" : "textures{}/missing{}/material{}.png";
+    missingPaths.push_back(
+      env.dir()
+      / fmt::format(fmt::runtime(format), index(rng) % 10, index(rng) % 10, index(rng)));
+  }
+
+  BENCHMARK("Resolve 100k mixed case paths")
+  {
+    auto count = size_t(0);
+    for (const auto& path : paths)
+    {
+      count += fs::Disk::fixPath(path) != path ? 1 : 0;
+    }
+    return count;
+  };
+
+  BENCHMARK("Resolve 100k missing paths")
+  {
+    auto count = size_t(0);
+    for (const auto& path : missingPaths)
+    {
+      count += fs::Disk::fixPath(path) != path ? 1 : 0;
+    }
+    return count;
+  };
+}
+
 } // namespace tb::fs
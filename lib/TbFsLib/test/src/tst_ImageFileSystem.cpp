@@ -20,15 +20,31 @@
 #include "Matchers.h"
 #include "fs/DiskIO.h"
 #include "fs/DkPakFileSystem.h"
+#include "fs/File.h"
 #include "fs/IdPakFileSystem.h"
 #include "fs/PathInfo.h"
+#include "fs/Reader.h"
+#include "fs/TestEnvironment.h"
 #include "fs/TestUtils.h"
 #include "fs/TraversalMode.h"
 #include "fs/WadFileSystem.h"
 #include "fs/ZipFileSystem.h"
 
+#include "kd/task_manager.h"
+
+#include <fmt/format.h>
+#include <miniz/miniz.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
@@ -817,6 +833,103 @@ const auto cr8_czg_03_contents = std::vector<unsigned char>{
   0x10, 0x11, 0x8D, 0x8D, 0x12, 0x8D, 0x11, 0x10, 0x10, 0x11, 0xAE, 0xAE, 0x13, 0x8D,
   0x11, 0x10, 0x10, 0x11, 0x8D, 0x13, 0x8D, 0x13, 0x11, 0x10, 0x8E, 0x11, 0x8D, 0xAD};
 
+namespace
+{
+
+std::vector<char> readContents(const File& file)
+{
+  auto reader = file.reader();
+  auto contents = std::vector<char>(reader.size());
+  reader.read(contents.data(), contents.size());
+  return contents;
+}
+
+std::vector<std::filesystem::path> findFiles(const FileSystem& fs)
+{
+  auto result = std::vector<std::filesystem::path>{};
+  for (const auto& path : fs.find("", TraversalMode::Recursive) | kdl::value())
+  {
+    if (fs.pathInfo(path) == PathInfo::File)
+    {
+      result.push_back(path);
+    }
+  }
+  return result;
+}
+
+void writeInt32(std::ofstream& stream, const size_t value)
+{
+  const auto i = int32_t(value);
+  stream.write(reinterpret_cast<const char*>(&i), sizeof(i));
+}
+
+/**
+ * Writes an id pak file with the given number of entries of the given size. This assumes
+ * a little endian platform.
+ */
+void writeIdPakFile(
+  const std::filesystem::path& path, const size_t entryCount, const size_t entrySize)
+{
+  const auto headerSize = size_t(12);
+  const auto directoryEntrySize = size_t(64);
+  const auto entryNameSize = size_t(56);
+
+  auto stream = std::ofstream{path, std::ios::out | std::ios::binary};
+  stream.write("PACK", 4);
+  writeInt32(stream, headerSize + entryCount * entrySize);
+  writeInt32(stream, entryCount * directoryEntrySize);
+
+  for (size_t i = 0; i < entryCount; ++i)
+  {
+    stream << std::string(entrySize, char('a' + i % 26));
+  }
+
+  for (size_t i = 0; i < entryCount; ++i)
+  {
+    auto name = fmt::format("textures/tex{}.wal", i);
+    name.resize(entryNameSize, '\0');
+    stream << name;
+    writeInt32(stream, headerSize + i * entrySize);
+    writeInt32(stream, entrySize);
+  }
+}
+
+/**
+ * Writes a zip file with the given number of compressed entries of the given size.
+ */
+void writeZipFile(
+  const std::filesystem::path& path, const size_t entryCount, const size_t entrySize)
+{
+  auto rng = std::mt19937{42};
+  auto dist = std::uniform_int_distribution<int>{'a', 'p'};
+
+  auto archive = mz_zip_archive{};
+  mz_zip_zero_struct(&archive);
+  REQUIRE(mz_zip_writer_init_heap(&archive, 0, 0));
+
+  for (size_t i = 0; i < entryCount; ++i)
+  {
+    auto contents = std::string(entrySize, '\0');
+    std::ranges::generate(contents, [&]() { return char(dist(rng)); });
+
+    const auto name = fmt::format("textures/tex{}.tga", i);
+    REQUIRE(mz_zip_writer_add_mem(
+      &archive, name.c_str(), contents.data(), contents.size(), MZ_DEFAULT_COMPRESSION));
+  }
+
+  void* buffer = nullptr;
+  auto size = size_t(0);
+  REQUIRE(mz_zip_writer_finalize_heap_archive(&archive, &buffer, &size));
+
+  auto stream = std::ofstream{path, std::ios::out | std::ios::binary};
+  stream.write(static_cast<const char*>(buffer), std::streamsize(size));
+
+  mz_free(buffer);
+  mz_zip_writer_end(&archive);
+}
+
+} // namespace
+
 TEST_CASE("Hierarchical ImageFileSystems")
 {
   const auto fsTestPath = std::filesystem::current_path() / "fixture/test/fs/";
@@ -936,6 +1049,30 @@ alias v30 "fov 30; sensitivity 7; bind mouse1 v90"
 alias v90 "fov 90; sensitivity 13; bind mouse1 v30"
 )");
   }
+
+  SECTION("Files can be read concurrently")
+  {
+    const auto paths = findFiles(*fs);
+    REQUIRE(!paths.empty());
+
+    auto expectedContents = std::vector<std::vector<char>>{};
+    for (const auto& path : paths)
+    {
+      expectedContents.push_back(readContents(*(fs->openFile(path) | kdl::value())));
+    }
+
+    auto taskManager = kdl::task_manager{8};
+    auto mismatches = std::atomic<size_t>{0};
+    taskManager.run_range(0, paths.size() * 64, 1, [&](const size_t i) {
+      const auto file = fs->openFile(paths[i % paths.size()]) | kdl::value();
+      if (readContents(*file) != expectedContents[i % paths.size()])
+      {
+        ++mismatches;
+      }
+    });
+
+    CHECK(mismatches == 0);
+  }
 }
 
 TEST_CASE("Flat ImageFileSystems")
@@ -1013,4 +1150,148 @@ TEST_CASE("WadFileSystem")
   }
 }
 
+TEST_CASE("IdPakFileSystem")
+{
+  const auto pakPath = std::filesystem::current_path() / "fixture/test/fs/Pak/idpak.pak";
+
+  SECTION("Buffered readers remain valid after the file system is destroyed")
+  {
+    auto reader = [&]() {
+      const auto fs = openFS<IdPakFileSystem>(pakPath);
+      return (fs->openFile("amnet.cfg") | kdl::value())->reader().buffer();
+    }();
+
+    CHECK(reader.readString(14) == "//\n// my stuff");
+  }
+}
+
+TEST_CASE("ZipFileSystem")
+{
+  const auto toString = [](const std::vector<char>& contents) {
+    return std::string{contents.begin(), contents.end()};
+  };
+
+  SECTION("Stored and deflated entries")
+  {
+    auto env = TestEnvironment{};
+
+    const auto storedContents = std::string{"stored contents\n"};
+    auto deflatedContents = std::string{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      deflatedContents += fmt::format("deflated line {}\n", i % 7);
+    }
+
+    auto archive = mz_zip_archive{};
+    mz_zip_zero_struct(&archive);
+    REQUIRE(mz_zip_writer_init_heap(&archive, 0, 0));
+    REQUIRE(mz_zip_writer_add_mem(
+      &archive,
+      "stored.txt",
+      storedContents.data(),
+      storedContents.size(),
+      MZ_NO_COMPRESSION));
+    REQUIRE(mz_zip_writer_add_mem(
+      &archive,
+      "deflated.txt",
+      deflatedContents.data(),
+      deflatedContents.size(),
+      MZ_DEFAULT_COMPRESSION));
+
+    void* buffer = nullptr;
+    auto size = size_t(0);
+    REQUIRE(mz_zip_writer_finalize_heap_archive(&archive, &buffer, &size));
+    auto zipContents = std::string{static_cast<const char*>(buffer), size};
+    mz_free(buffer);
+    mz_zip_writer_end(&archive);
+
+    REQUIRE(zipContents.size() < storedContents.size() + deflatedContents.size());
+    env.createFile("archive.zip", zipContents);
+
+    {
+      const auto fs = openFS<ZipFileSystem>(env.dir() / "archive.zip");
+      CHECK(
+        toString(readContents(*(fs->openFile("stored.txt") | kdl::value())))
+        == storedContents);
+      CHECK(
+        toString(readContents(*(fs->openFile("deflated.txt") | kdl::value())))
+        == deflatedContents);
+    }
+
+    // corrupt the stored entry's data so that its checksum doesn't match
+    const auto storedOffset = zipContents.find(storedContents);
+    REQUIRE(storedOffset != std::string::npos);
+    zipContents[storedOffset] = 'S';
+    env.createFile("corrupted.zip", zipContents);
+
+    {
+      const auto fs = openFS<ZipFileSystem>(env.dir() / "corrupted.zip");
+      CHECK(fs->openFile("stored.txt").is_error());
+      CHECK(fs->openFile("deflated.txt").is_success());
+    }
+  }
+
+  SECTION("Entries with data descriptors")
+  {
+    const auto zipPath =
+      std::filesystem::current_path() / "fixture/test/fs/Zip/descriptor.zip";
+    const auto fs = openFS<ZipFileSystem>(zipPath);
+
+    auto deflatedContents = std::string{};
+    for (size_t i = 0; i < 16; ++i)
+    {
+      deflatedContents += "deflated with a data descriptor\n";
+    }
+
+    CHECK(
+      toString(readContents(*(fs->openFile("stored.txt") | kdl::value())))
+      == "stored with a data descriptor\n");
+    CHECK(
+      toString(readContents(*(fs->openFile("deflated.txt") | kdl::value())))
+      == deflatedContents);
+  }
+}
+
+TEST_CASE("ImageFileSystems (Benchmark)", "[.][benchmark]")
+{
+  const auto entryCount = size_t(4096);
+  const auto entrySize = size_t(16384);
+
+  auto env = TestEnvironment{};
+
+  const auto benchmarkConcurrentReads = [](const FileSystem& fs) {
+    const auto paths = findFiles(fs);
+    REQUIRE(paths.size() == entryCount);
+
+    for (const auto threadCount : {1, 2, 4, 8})
+    {
+      auto taskManager = kdl::task_manager{size_t(threadCount)};
+
+      BENCHMARK(fmt::format("{} threads", threadCount))
+      {
+        auto totalSize = std::atomic<size_t>{0};
+        taskManager.run_range(0, paths.size(), 16, [&](const size_t i) {
+          const auto file = fs.openFile(paths[i]) | kdl::value();
+          totalSize += readContents(*file).size();
+        });
+        return totalSize.load();
+      };
+    }
+  };
+
+  SECTION("IdPakFileSystem")
+  {
+    const auto pakPath = env.dir() / "large.pak";
+    writeIdPakFile(pakPath, entryCount, entrySize);
+    benchmarkConcurrentReads(*openFS<IdPakFileSystem>(pakPath));
+  }
+
+  SECTION("ZipFileSystem")
+  {
+    const auto zipPath = env.dir() / "large.pk3";
+    writeZipFile(zipPath, entryCount, entrySize);
+    benchmarkConcurrentReads(*openFS<ZipFileSystem>(zipPath));
+  }
+}
+
 } // namespace tb::fs
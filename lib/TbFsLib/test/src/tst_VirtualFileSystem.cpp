@@ -20,6 +20,7 @@
 #include "Matchers.h"
 #include "fs/File.h"
 #include "fs/FileSystemMetadata.h"
+#include "fs/ImageFileSystem.h"
 #include "fs/TestFileSystem.h"
 #include "fs/TraversalMode.h"
 #include "fs/VirtualFileSystem.h"
@@ -29,10 +30,110 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <random>
+#include <tuple>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::fs
 {
+namespace
+{
+
+using TestImageFiles =
+  std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>>;
+
+class TestImageFileSystem : public ImageFileSystemBase
+{
+private:
+  TestImageFiles m_files;
+
+public:
+  explicit TestImageFileSystem(TestImageFiles files)
+    : m_files{std::move(files)}
+  {
+  }
+
+private:
+  Result<void> doReadDirectory() override
+  {
+    for (const auto& [path, file] : m_files)
+    {
+      addFile(path, [file]() { return Result<std::shared_ptr<File>>{file}; });
+    }
+    return kdl::void_success;
+  }
+};
+
+std::unique_ptr<FileSystem> makeImageFileSystem(
+  TestImageFiles files, std::unordered_map<std::string, FileSystemMetadata> metadata)
+{
+  auto fs = createImageFileSystem<TestImageFileSystem>(std::move(files)) | kdl::value();
+  fs->setMetadata(std::move(metadata));
+  return fs;
+}
+
+/**
+ * Hides the type of the wrapped file system so that VirtualFileSystem doesn't index it.
+ */
+class UnindexedFileSystem : public FileSystem
+{
+private:
+  std::unique_ptr<FileSystem> m_fs;
+
+public:
+  explicit UnindexedFileSystem(std::unique_ptr<FileSystem> fs)
+    : m_fs{std::move(fs)}
+  {
+  }
+
+  Result<std::filesystem::path> makeAbsolute(
+    const std::filesystem::path& path) const override
+  {
+    return m_fs->makeAbsolute(path);
+  }
+
+  PathInfo pathInfo(const std::filesystem::path& path) const override
+  {
+    return m_fs->pathInfo(path);
+  }
+
+  const FileSystemMetadata* metadata(
+    const std::filesystem::path& path, const std::string& key) const override
+  {
+    return m_fs->metadata(path, key);
+  }
+
+private:
+  Result<std::vector<std::filesystem::path>> doFind(
+    const std::filesystem::path& path, const TraversalMode& traversalMode) const override
+  {
+    return m_fs->find(path, traversalMode);
+  }
+
+  Result<std::shared_ptr<File>> doOpenFile(
+    const std::filesystem::path& path) const override
+  {
+    return m_fs->openFile(path);
+  }
+};
+
+/**
+ * A file system that cannot make any path absolute.
+ */
+class NonAbsoluteFileSystem : public UnindexedFileSystem
+{
+public:
+  using UnindexedFileSystem::UnindexedFileSystem;
+
+  Result<std::filesystem::path> makeAbsolute(
+    const std::filesystem::path& path) const override
+  {
+    return Error{fmt::format("Cannot make {} absolute", path)};
+  }
+};
+
+} // namespace
 
 TEST_CASE("VirtualFileSystem")
 {
@@ -775,4 +876,199 @@ TEST_CASE("VirtualFileSystem")
   }
 }
 
+TEST_CASE("VirtualFileSystem (Image file systems)")
+{
+  auto vfs = VirtualFileSystem{};
+
+  auto disk_foo_a = makeObjectFile(1);
+  auto img1_foo_a = makeObjectFile(2);
+  auto img1_foo_b = makeObjectFile(3);
+  auto img1_bar_c = makeObjectFile(4);
+  auto img2_foo_b = makeObjectFile(5);
+  auto img2_foo_d = makeObjectFile(6);
+
+  auto md_img1 = std::unordered_map<std::string, FileSystemMetadata>{
+    {"key1", FileSystemMetadata{std::filesystem::path{"/img1"}}},
+  };
+  auto md_img2 = std::unordered_map<std::string, FileSystemMetadata>{
+    {"key1", FileSystemMetadata{std::filesystem::path{"/img2"}}},
+  };
+
+  const auto img1Id = vfs.mount(
+    "",
+    makeImageFileSystem(
+      {
+        {"foo/a", img1_foo_a},
+        {"foo/b", img1_foo_b},
+        {"bar/c", img1_bar_c},
+      },
+      md_img1));
+  vfs.mount(
+    "",
+    std::make_unique<TestFileSystem>(
+      Entry{DirectoryEntry{
+        "",
+        {
+          DirectoryEntry{
+            "foo",
+            {
+              FileEntry{"a", disk_foo_a}, // overrides img1_foo_a
+            }},
+        }}},
+      std::unordered_map<std::string, FileSystemMetadata>{},
+      "/disk"));
+  const auto img2Id = vfs.mount(
+    "FOO",
+    makeImageFileSystem(
+      {
+        {"B", img2_foo_b}, // overrides img1_foo_b
+        {"d", img2_foo_d},
+      },
+      md_img2));
+
+  SECTION("Mount points are resolved in order")
+  {
+    CHECK(vfs.pathInfo("") == PathInfo::Directory);
+    CHECK(vfs.pathInfo("foo") == PathInfo::Directory);
+    CHECK(vfs.pathInfo("bar/") == PathInfo::Directory);
+    CHECK(vfs.pathInfo("bar/c") == PathInfo::File);
+    CHECK(vfs.pathInfo("foo/e") == PathInfo::Unknown);
+
+    CHECK(vfs.openFile("foo/a") == Result<std::shared_ptr<File>>{disk_foo_a});
+    CHECK(vfs.openFile("foo/b") == Result<std::shared_ptr<File>>{img2_foo_b});
+    CHECK(vfs.openFile("FOO/b") == Result<std::shared_ptr<File>>{img2_foo_b});
+    CHECK(vfs.openFile("Bar/C") == Result<std::shared_ptr<File>>{img1_bar_c});
+    CHECK(vfs.openFile("foo/d") == Result<std::shared_ptr<File>>{img2_foo_d});
+
+    CHECK(vfs.makeAbsolute("foo/a") == "/disk/foo/a");
+    CHECK(vfs.makeAbsolute("foo/b") == "/b");
+    CHECK(vfs.makeAbsolute("bar/c") == "/bar/c");
+
+    CHECK_THAT(vfs.metadata("foo", "key1"), MatchesPointer(md_img2.at("key1")));
+    CHECK_THAT(vfs.metadata("bar/c", "key1"), MatchesPointer(md_img1.at("key1")));
+    CHECK(vfs.metadata("foo/a", "key1") == nullptr);
+  }
+
+  SECTION("makeAbsolute falls through to the next mount point")
+  {
+    vfs.mount(
+      "",
+      std::make_unique<NonAbsoluteFileSystem>(makeImageFileSystem(
+        {
+          {"foo/a", makeObjectFile(7)},
+          {"bar/c", makeObjectFile(8)},
+        },
+        {})));
+
+    CHECK(vfs.makeAbsolute("foo/a") == "/disk/foo/a");
+    CHECK(vfs.makeAbsolute("bar/c") == "/bar/c");
+    CHECK(
+      vfs.makeAbsolute("bar/e")
+      == Result<std::filesystem::path>{Error{fmt::format(
+        "Failed to make absolute path of {}", std::filesystem::path{"bar/e"})}});
+  }
+
+  SECTION("Unmounting an image file system")
+  {
+    REQUIRE(vfs.unmount(img2Id));
+
+    CHECK(vfs.openFile("foo/b") == Result<std::shared_ptr<File>>{img1_foo_b});
+    CHECK(vfs.pathInfo("foo/d") == PathInfo::Unknown);
+    CHECK(vfs.metadata("foo", "key1") == nullptr);
+    CHECK_THAT(vfs.metadata("foo/b", "key1"), MatchesPointer(md_img1.at("key1")));
+
+    REQUIRE(vfs.unmount(img1Id));
+
+    CHECK(vfs.openFile("foo/a") == Result<std::shared_ptr<File>>{disk_foo_a});
+    CHECK(vfs.pathInfo("foo/b") == PathInfo::Unknown);
+    CHECK(vfs.pathInfo("bar") == PathInfo::Unknown);
+  }
+
+  SECTION("Unmounting all file systems")
+  {
+    vfs.unmountAll();
+
+    CHECK(vfs.pathInfo("foo/b") == PathInfo::Unknown);
+    CHECK(vfs.pathInfo("bar/c") == PathInfo::Unknown);
+  }
+}
+
+TEST_CASE("VirtualFileSystem (Indexed resolution matches unindexed resolution)")
+{
+  auto rng = std::mt19937{42};
+  auto pick = [&](const size_t count) {
+    return std::uniform_int_distribution<size_t>{0, count - 1}(rng);
+  };
+
+  const auto mountPaths = std::vector<std::filesystem::path>{"", "", "textures", "Foo"};
+  const auto names = std::vector<std::string>{"a", "B", "foo", "textures", "Wad"};
+
+  const auto makePath = [&](const size_t length) {
+    auto path = std::filesystem::path{};
+    for (size_t i = 0; i < length; ++i)
+    {
+      path /= names[pick(names.size())];
+    }
+    return path;
+  };
+
+  auto indexed = VirtualFileSystem{};
+  auto unindexed = VirtualFileSystem{};
+  auto mountPointIds =
+    std::vector<std::tuple<VirtualMountPointId, VirtualMountPointId>>{};
+  auto nextFileId = 0;
+
+  for (size_t i = 0; i < 40; ++i)
+  {
+    if (!mountPointIds.empty() && pick(4) == 0)
+    {
+      const auto index = pick(mountPointIds.size());
+      const auto [indexedId, unindexedId] = mountPointIds[index];
+      REQUIRE(indexed.unmount(indexedId));
+      REQUIRE(unindexed.unmount(unindexedId));
+      mountPointIds.erase(mountPointIds.begin() + std::ptrdiff_t(index));
+    }
+    else
+    {
+      auto files = TestImageFiles{};
+      for (size_t j = 0, count = pick(8); j < count; ++j)
+      {
+        files.emplace_back(makePath(1 + pick(3)), makeObjectFile(nextFileId++));
+      }
+
+      const auto mountPath = mountPaths[pick(mountPaths.size())];
+      const auto metadata = std::unordered_map<std::string, FileSystemMetadata>{
+        {"key", FileSystemMetadata{std::filesystem::path{std::to_string(i)}}},
+      };
+      mountPointIds.emplace_back(
+        indexed.mount(mountPath, makeImageFileSystem(files, metadata)),
+        unindexed.mount(
+          mountPath,
+          std::make_unique<UnindexedFileSystem>(makeImageFileSystem(files, metadata))));
+    }
+
+    for (size_t j = 0; j < 50; ++j)
+    {
+      const auto path = makePath(pick(4));
+      CAPTURE(i, path);
+
+      CHECK(indexed.pathInfo(path) == unindexed.pathInfo(path));
+      CHECK(indexed.makeAbsolute(path) == unindexed.makeAbsolute(path));
+
+      const auto* indexedMetadata = indexed.metadata(path, "key");
+      const auto* unindexedMetadata = unindexed.metadata(path, "key");
+      CHECK((indexedMetadata != nullptr) == (unindexedMetadata != nullptr));
+      if (indexedMetadata && unindexedMetadata)
+      {
+        CHECK(*indexedMetadata == *unindexedMetadata);
+      }
+
+      if (indexed.pathInfo(path) == PathInfo::File)
+      {
+        CHECK(indexed.openFile(path) == unindexed.openFile(path));
+      }
+    }
+  }
+}
+
 } // namespace tb::fs